@@ -28,5 +28,10 @@ public class MetasoundBranches : ModuleRules
                 "SignalProcessing"
             }
         );
+
+        // Per-node timers and counters (stat MetasoundBranches, trace channel and file sink).
+        // Compiled out unless enabled here, so shipped builds pay nothing by default.
+        bool bEnableNodeProfiling = false;
+        PrivateDefinitions.Add("METASOUND_BRANCHES_PROFILING=" + (bEnableNodeProfiling ? "1" : "0"));
     }
 }
\ No newline at end of file
@@ -1,12 +1,15 @@
 // Copyright 2025 Charles Matthews. All Rights Reserved.
 
 #include "MetasoundBranches/Public/MetasoundBoolToAudioNode.h"
+#include "MetasoundBranches/Public/DSP/SlewKernel.h"
 #include "MetasoundExecutableOperator.h"
 #include "MetasoundPrimitives.h"
 #include "MetasoundNodeRegistrationMacro.h"
 #include "MetasoundStandardNodesNames.h"
 #include "MetasoundFacade.h"
 #include "MetasoundParamHelper.h"
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundBoolToAudioNode"
 
@@ -20,6 +23,8 @@ namespace Metasound
         METASOUND_PARAM(OutputSignal, "Out", "Audio signal.");
     }
 
+    METASOUND_BRANCHES_DECLARE_NODE_STATS(BoolToAudio, "Bool To Audio")
+
     class FBoolToAudioOperator : public TExecutableOperator<FBoolToAudioOperator>
     {
     public:
@@ -32,7 +37,6 @@ namespace Metasound
             , InputRiseTime(InRiseTime)
             , InputFallTime(InFallTime)
             , OutputSignal(FAudioBufferWriteRef::CreateNew(InSettings))
-            , PreviousOutputSample(0.0f)
             , SampleRate(InSettings.GetSampleRate())
         {
         }
@@ -78,26 +82,20 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace BoolToAudioNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputBool), InputBool);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputRiseTime), InputRiseTime);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputFallTime), InputFallTime);
-
-            return InputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputBool), InputBool);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRiseTime), InputRiseTime);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputFallTime), InputFallTime);
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace BoolToAudioNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal), OutputSignal);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal), OutputSignal);
         }
 
         static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutErrors)
@@ -125,8 +123,16 @@ namespace Metasound
             return MakeUnique<FBoolToAudioOperator>(InParams.OperatorSettings, InputBool, InputRiseTime, InputFallTime);
         }
 
+        virtual void Reset(const IOperator::FResetParams& InParams)
+        {
+            OutputSignal->Zero();
+            Slew.Reset();
+        }
+
         virtual void Execute()
         {
+            METASOUND_BRANCHES_SCOPE_EXECUTE(BoolToAudio, OutputSignal->Num());
+
             int32 NumFrames = OutputSignal->Num();
             float* OutputDataPtr = OutputSignal->GetData();
 
@@ -135,29 +141,10 @@ namespace Metasound
             float RiseTimeSeconds = InputRiseTime->GetSeconds();
             float FallTimeSeconds = InputFallTime->GetSeconds();
 
-            float RiseAlpha = (RiseTimeSeconds > 0.0f) ? FMath::Exp(-1.0f / (RiseTimeSeconds * SampleRate)) : 0.0f;
-            float FallAlpha = (FallTimeSeconds > 0.0f) ? FMath::Exp(-1.0f / (FallTimeSeconds * SampleRate)) : 0.0f;
+            float RiseAlpha = MetasoundBranches::FSlewKernel::GetAlpha(RiseTimeSeconds, SampleRate);
+            float FallAlpha = MetasoundBranches::FSlewKernel::GetAlpha(FallTimeSeconds, SampleRate);
 
-            for (int32 i = 0; i < NumFrames; ++i)
-            {
-                float OutputSample = PreviousOutputSample;
-
-                if (TargetValue > PreviousOutputSample)
-                {
-                    OutputSample = RiseAlpha * PreviousOutputSample + (1.0f - RiseAlpha) * TargetValue;
-                }
-                else if (TargetValue < PreviousOutputSample)
-                {
-                    OutputSample = FallAlpha * PreviousOutputSample + (1.0f - FallAlpha) * TargetValue;
-                }
-                else
-                {
-                    OutputSample = TargetValue;
-                }
-
-                OutputDataPtr[i] = OutputSample;
-                PreviousOutputSample = OutputSample;
-            }
+            Slew.ProcessConstant(TargetValue, OutputDataPtr, NumFrames, RiseAlpha, FallAlpha);
         }
 
     private:
@@ -165,7 +152,7 @@ namespace Metasound
         FTimeReadRef InputRiseTime;
         FTimeReadRef InputFallTime;
         FAudioBufferWriteRef OutputSignal;
-        float PreviousOutputSample;
+        MetasoundBranches::FSlewKernel Slew;
         float SampleRate;
     };
 
@@ -179,6 +166,7 @@ namespace Metasound
     };
 
     METASOUND_REGISTER_NODE(FBoolToAudioNode);
+    METASOUND_BRANCHES_LIST_NODE(FBoolToAudioNode);
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
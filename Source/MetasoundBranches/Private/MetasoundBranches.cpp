@@ -1,12 +1,17 @@
 // Copyright 2025 Charles Matthews. All Rights Reserved.
 
 #include "MetasoundBranches/Public/MetasoundBranches.h"
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
 #include "MetasoundFrontendRegistries.h"
 #include "Modules/ModuleManager.h"
 #include "MetasoundDataTypeRegistrationMacro.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
 
 #define LOCTEXT_NAMESPACE "FMetasoundBranchesModule"
 
+DEFINE_LOG_CATEGORY(LogMetasoundBranches);
+
 void FMetasoundBranchesModule::StartupModule()
 {
     using namespace Metasound;
@@ -15,6 +20,14 @@ void FMetasoundBranchesModule::StartupModule()
 
 void FMetasoundBranchesModule::ShutdownModule()
 {
+#if METASOUND_BRANCHES_PROFILING
+    // -BranchesNodeStats=<file> writes the per-node totals on exit, for headless runs without a console
+    FString StatsFilename;
+    if (FParse::Value(FCommandLine::Get(), TEXT("BranchesNodeStats="), StatsFilename))
+    {
+        MetasoundBranches::FNodeStats::WriteReport(StatsFilename);
+    }
+#endif
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,65 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MetasoundDataReference.h"
+#include "MetasoundVertexData.h"
+
+// Helpers for operators that look at how their inputs are bound, to skip work that a constant input makes redundant.
+//
+// At construction nothing of the operator's own has been bound yet, so the vertex data shows exactly what the graph
+// connected. On a rebind the vertex may still hold the reference the operator bound last time, in which case nothing
+// changed for that input and the operator's previous answer stands.
+namespace MetasoundBranches
+{
+    // True if something is connected to the input, for use at construction
+    inline bool IsConnectedInput(const Metasound::FInputVertexInterfaceData& InVertexData, const Metasound::FVertexName& InVertexName)
+    {
+        return InVertexData.IsVertexBound(InVertexName);
+    }
+
+    // True if something is connected to the input, for use in BindInputs before the operator rebinds it
+    template <typename DataType>
+    bool IsConnectedInput(const Metasound::FInputVertexInterfaceData& InVertexData, const Metasound::FVertexName& InVertexName, const Metasound::TDataReadReference<DataType>& InCurrent, bool bInWasConnected)
+    {
+        const Metasound::FAnyDataReference* Reference = InVertexData.FindDataReference(InVertexName);
+        if (Reference == nullptr)
+        {
+            return false;
+        }
+
+        if (&*Reference->GetDataReadReference<DataType>() == &*InCurrent)
+        {
+            return bInWasConnected;
+        }
+
+        return true;
+    }
+
+    // True if the input can't change while the operator runs: it is unconnected or bound to a constant value.
+    // For use at construction.
+    inline bool IsConstantInput(const Metasound::FInputVertexInterfaceData& InVertexData, const Metasound::FVertexName& InVertexName)
+    {
+        const Metasound::FAnyDataReference* Reference = InVertexData.FindDataReference(InVertexName);
+        return Reference == nullptr || Reference->GetAccessType() == Metasound::EDataReferenceAccessType::Value;
+    }
+
+    // As above, for use in BindInputs before the operator rebinds the input
+    template <typename DataType>
+    bool IsConstantInput(const Metasound::FInputVertexInterfaceData& InVertexData, const Metasound::FVertexName& InVertexName, const Metasound::TDataReadReference<DataType>& InCurrent, bool bInWasConstant)
+    {
+        const Metasound::FAnyDataReference* Reference = InVertexData.FindDataReference(InVertexName);
+        if (Reference == nullptr || Reference->GetAccessType() == Metasound::EDataReferenceAccessType::Value)
+        {
+            return true;
+        }
+
+        if (&*Reference->GetDataReadReference<DataType>() == &*InCurrent)
+        {
+            return bInWasConstant;
+        }
+
+        return false;
+    }
+}
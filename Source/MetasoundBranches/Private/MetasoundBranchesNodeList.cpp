@@ -0,0 +1,16 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+
+namespace MetasoundBranches
+{
+    const FNodeListEntry* FNodeListEntry::Head = nullptr;
+
+    FNodeListEntry::FNodeListEntry(const TCHAR* InClassName, FCreateNode InCreateNode)
+        : ClassName(InClassName)
+        , CreateNodeFunction(InCreateNode)
+    {
+        Next = Head;
+        Head = this;
+    }
+}
@@ -0,0 +1,99 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
+
+#if METASOUND_BRANCHES_PROFILING
+
+#include "MetasoundBranches/Public/MetasoundBranches.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+UE_TRACE_CHANNEL_DEFINE(MetasoundBranchesChannel);
+
+namespace MetasoundBranches
+{
+    FNodeStats* FNodeStats::Head = nullptr;
+
+    FNodeStats::FNodeStats(const TCHAR* InNodeName)
+        : NodeName(InNodeName)
+    {
+        // Node stats are static objects, constructed once per node class during module load
+        Next = Head;
+        Head = this;
+    }
+
+    void FNodeStats::ResetCounters()
+    {
+        Executions.store(0, std::memory_order_relaxed);
+        Cycles.store(0, std::memory_order_relaxed);
+        SamplesProcessed.store(0, std::memory_order_relaxed);
+        TriggersEmitted.store(0, std::memory_order_relaxed);
+        BlocksShortCircuited.store(0, std::memory_order_relaxed);
+    }
+
+    void FNodeStats::ResetAll()
+    {
+        for (FNodeStats* Stats = Head; Stats != nullptr; Stats = Stats->Next)
+        {
+            Stats->ResetCounters();
+        }
+    }
+
+    bool FNodeStats::WriteReport(const FString& InFilename)
+    {
+        FString Report = TEXT("Node,Executions,TotalMs,AverageUs,Samples,NsPerSample,Triggers,ShortCircuitedBlocks,InstanceBytes\n");
+
+        for (const FNodeStats* Stats = Head; Stats != nullptr; Stats = Stats->Next)
+        {
+            const uint64 NumExecutions = Stats->Executions.load(std::memory_order_relaxed);
+            const uint64 NumSamples = Stats->SamplesProcessed.load(std::memory_order_relaxed);
+            const double TotalMs = FPlatformTime::ToMilliseconds64(Stats->Cycles.load(std::memory_order_relaxed));
+
+            const double AverageUs = NumExecutions > 0 ? (TotalMs * 1000.0) / NumExecutions : 0.0;
+            const double NsPerSample = NumSamples > 0 ? (TotalMs * 1000000.0) / NumSamples : 0.0;
+
+            Report += FString::Printf(TEXT("%s,%llu,%.3f,%.3f,%llu,%.3f,%llu,%llu,%lld\n"),
+                Stats->NodeName,
+                NumExecutions,
+                TotalMs,
+                AverageUs,
+                NumSamples,
+                NsPerSample,
+                Stats->TriggersEmitted.load(std::memory_order_relaxed),
+                Stats->BlocksShortCircuited.load(std::memory_order_relaxed),
+                Stats->InstanceBytes.load(std::memory_order_relaxed));
+        }
+
+        return FFileHelper::SaveStringToFile(Report, *InFilename);
+    }
+
+    static FAutoConsoleCommand DumpNodeStatsCommand(
+        TEXT("au.MetaSound.Branches.DumpNodeStats"),
+        TEXT("Writes per-node timings and counters for MetaSound Branches to a CSV file.\n")
+        TEXT("Usage: au.MetaSound.Branches.DumpNodeStats [Filename] (defaults to Saved/Profiling/BranchesNodeStats.csv)"),
+        FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+        {
+            const FString Filename = Args.Num() > 0
+                ? Args[0]
+                : FPaths::Combine(FPaths::ProfilingDir(), TEXT("BranchesNodeStats.csv"));
+
+            if (FNodeStats::WriteReport(Filename))
+            {
+                UE_LOG(LogMetasoundBranches, Display, TEXT("MetaSound Branches node stats written to %s"), *Filename);
+            }
+            else
+            {
+                UE_LOG(LogMetasoundBranches, Warning, TEXT("Failed to write MetaSound Branches node stats to %s"), *Filename);
+            }
+        })
+    );
+
+    static FAutoConsoleCommand ResetNodeStatsCommand(
+        TEXT("au.MetaSound.Branches.ResetNodeStats"),
+        TEXT("Clears the per-node timings and counters for MetaSound Branches."),
+        FConsoleCommandDelegate::CreateStatic(&FNodeStats::ResetAll)
+    );
+}
+
+#endif // METASOUND_BRANCHES_PROFILING
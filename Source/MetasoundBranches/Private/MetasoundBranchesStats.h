@@ -0,0 +1,158 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include <atomic>
+
+// Per-node timers and counters. Off by default; enable with bEnableNodeProfiling in MetasoundBranches.Build.cs.
+// When disabled every METASOUND_BRANCHES_* macro below expands to nothing.
+#ifndef METASOUND_BRANCHES_PROFILING
+#define METASOUND_BRANCHES_PROFILING 0
+#endif
+
+#if METASOUND_BRANCHES_PROFILING
+
+DECLARE_STATS_GROUP(TEXT("MetaSound Branches"), STATGROUP_MetasoundBranches, STATCAT_Advanced);
+
+UE_TRACE_CHANNEL_EXTERN(MetasoundBranchesChannel);
+
+namespace MetasoundBranches
+{
+    // Totals for one node class, shared by every instance of that class.
+    // Instances register themselves in a static list so the file sink can walk them without the stats system.
+    class FNodeStats
+    {
+    public:
+        explicit FNodeStats(const TCHAR* InNodeName);
+
+        const TCHAR* GetNodeName() const { return NodeName; }
+
+        void AddExecution(uint64 InCycles, int32 InNumSamples)
+        {
+            Executions.fetch_add(1, std::memory_order_relaxed);
+            Cycles.fetch_add(InCycles, std::memory_order_relaxed);
+            SamplesProcessed.fetch_add(InNumSamples, std::memory_order_relaxed);
+        }
+
+        void AddTriggers(int32 InNumTriggers)
+        {
+            TriggersEmitted.fetch_add(InNumTriggers, std::memory_order_relaxed);
+        }
+
+        void AddShortCircuit()
+        {
+            BlocksShortCircuited.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Live memory of every instance of the node class; instances add their size on creation and growth
+        // and remove it on destruction
+        void AddInstanceMemory(int64 InDeltaBytes)
+        {
+            InstanceBytes.fetch_add(InDeltaBytes, std::memory_order_relaxed);
+        }
+
+        // Clears the counters. Instance memory is live state and is left alone.
+        void ResetCounters();
+
+        // Writes one line per node class to a plain text file. Returns false if the file could not be written.
+        static bool WriteReport(const FString& InFilename);
+
+        // Clears the totals of every registered node class.
+        static void ResetAll();
+
+    private:
+        const TCHAR* NodeName;
+
+        std::atomic<uint64> Executions{ 0 };
+        std::atomic<uint64> Cycles{ 0 };
+        std::atomic<uint64> SamplesProcessed{ 0 };
+        std::atomic<uint64> TriggersEmitted{ 0 };
+        std::atomic<uint64> BlocksShortCircuited{ 0 };
+        std::atomic<int64> InstanceBytes{ 0 };
+
+        FNodeStats* Next = nullptr;
+        static FNodeStats* Head;
+    };
+
+    // Times one Execute call and adds it to the node class totals on destruction.
+    class FScopedNodeExecute
+    {
+    public:
+        FScopedNodeExecute(FNodeStats& InStats, int32 InNumSamples)
+            : Stats(InStats)
+            , NumSamples(InNumSamples)
+            , StartCycles(FPlatformTime::Cycles64())
+        {
+        }
+
+        ~FScopedNodeExecute()
+        {
+            Stats.AddExecution(FPlatformTime::Cycles64() - StartCycles, NumSamples);
+        }
+
+    private:
+        FNodeStats& Stats;
+        int32 NumSamples;
+        uint64 StartCycles;
+    };
+}
+
+// Declares the stats for a node class. Use once at namespace scope in the node's .cpp file.
+#define METASOUND_BRANCHES_DECLARE_NODE_STATS(Id, DisplayName) \
+    DECLARE_CYCLE_STAT(TEXT(DisplayName " Execute"), STAT_Branches_##Id##_Execute, STATGROUP_MetasoundBranches); \
+    DECLARE_DWORD_ACCUMULATOR_STAT(TEXT(DisplayName " Samples"), STAT_Branches_##Id##_Samples, STATGROUP_MetasoundBranches); \
+    DECLARE_DWORD_ACCUMULATOR_STAT(TEXT(DisplayName " Triggers"), STAT_Branches_##Id##_Triggers, STATGROUP_MetasoundBranches); \
+    DECLARE_DWORD_ACCUMULATOR_STAT(TEXT(DisplayName " Short-Circuited Blocks"), STAT_Branches_##Id##_ShortCircuit, STATGROUP_MetasoundBranches); \
+    DECLARE_MEMORY_STAT(TEXT(DisplayName " Instance Memory"), STAT_Branches_##Id##_Memory, STATGROUP_MetasoundBranches); \
+    static ::MetasoundBranches::FNodeStats GBranchesNodeStats_##Id(TEXT(DisplayName));
+
+// Times the enclosing Execute scope on the stats system, the MetasoundBranches trace channel and the file sink.
+#define METASOUND_BRANCHES_SCOPE_EXECUTE(Id, NumSamples) \
+    SCOPE_CYCLE_COUNTER(STAT_Branches_##Id##_Execute); \
+    TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(TEXT("Branches::" #Id), MetasoundBranchesChannel); \
+    INC_DWORD_STAT_BY(STAT_Branches_##Id##_Samples, NumSamples); \
+    ::MetasoundBranches::FScopedNodeExecute BranchesExecuteScope_##Id(GBranchesNodeStats_##Id, NumSamples)
+
+#define METASOUND_BRANCHES_COUNT_TRIGGERS(Id, NumTriggers) \
+    do \
+    { \
+        const int32 BranchesNumTriggers = (NumTriggers); \
+        INC_DWORD_STAT_BY(STAT_Branches_##Id##_Triggers, BranchesNumTriggers); \
+        GBranchesNodeStats_##Id.AddTriggers(BranchesNumTriggers); \
+    } while (0)
+
+#define METASOUND_BRANCHES_COUNT_SHORT_CIRCUIT(Id) \
+    do \
+    { \
+        INC_DWORD_STAT(STAT_Branches_##Id##_ShortCircuit); \
+        GBranchesNodeStats_##Id.AddShortCircuit(); \
+    } while (0)
+
+// Adds (or with a negative value, removes) bytes from the node class's live instance memory
+#define METASOUND_BRANCHES_TRACK_MEMORY(Id, DeltaBytes) \
+    do \
+    { \
+        const int64 BranchesDeltaBytes = (DeltaBytes); \
+        if (BranchesDeltaBytes >= 0) \
+        { \
+            INC_MEMORY_STAT_BY(STAT_Branches_##Id##_Memory, BranchesDeltaBytes); \
+        } \
+        else \
+        { \
+            DEC_MEMORY_STAT_BY(STAT_Branches_##Id##_Memory, -BranchesDeltaBytes); \
+        } \
+        GBranchesNodeStats_##Id.AddInstanceMemory(BranchesDeltaBytes); \
+    } while (0)
+
+#else
+
+#define METASOUND_BRANCHES_DECLARE_NODE_STATS(Id, DisplayName)
+#define METASOUND_BRANCHES_SCOPE_EXECUTE(Id, NumSamples)
+#define METASOUND_BRANCHES_COUNT_TRIGGERS(Id, NumTriggers)
+#define METASOUND_BRANCHES_COUNT_SHORT_CIRCUIT(Id)
+#define METASOUND_BRANCHES_TRACK_MEMORY(Id, DeltaBytes)
+
+#endif // METASOUND_BRANCHES_PROFILING
@@ -1,11 +1,14 @@
 // Copyright 2025 Charles Matthews. All Rights Reserved.
 
 #include "MetasoundBranches/Public/MetasoundClockDividerNode.h"
+#include "MetasoundBranches/Public/DSP/ClockDividerKernel.h"
 #include "MetasoundExecutableOperator.h"     // TExecutableOperator class
 #include "MetasoundPrimitives.h"             // ReadRef and WriteRef descriptions for bool, int32, float, and string
 #include "MetasoundNodeRegistrationMacro.h"  // METASOUND_LOCTEXT and METASOUND_REGISTER_NODE macros
 #include "MetasoundFacade.h"                 // FNodeFacade class, eliminates the need for a fair amount of boilerplate code
 #include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_ClockDividerNode"
 
@@ -26,6 +29,8 @@ namespace Metasound
         METASOUND_PARAM(OutputTrigger8, "8", "Output trigger for division 8.");
     }
 
+    METASOUND_BRANCHES_DECLARE_NODE_STATS(ClockDivider, "Clock Divider")
+
     class FClockDividerOperator : public TExecutableOperator<FClockDividerOperator>
     {
     public:
@@ -43,7 +48,7 @@ namespace Metasound
             , OutputTrigger6(FTriggerWriteRef::CreateNew(InSettings))
             , OutputTrigger7(FTriggerWriteRef::CreateNew(InSettings))
             , OutputTrigger8(FTriggerWriteRef::CreateNew(InSettings))
-            , Counter(0)
+            , NumFramesPerBlock(InSettings.GetNumFramesPerBlock())
         {
         }
 
@@ -97,34 +102,26 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace ClockDividerNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
-
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTrigger), InputTrigger);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputReset), InputReset);
-
-            return InputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTrigger), InputTrigger);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputReset), InputReset);
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace ClockDividerNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTrigger1), OutputTrigger1);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTrigger2), OutputTrigger2);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTrigger3), OutputTrigger3);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTrigger4), OutputTrigger4);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTrigger5), OutputTrigger5);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTrigger6), OutputTrigger6);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTrigger7), OutputTrigger7);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTrigger8), OutputTrigger8);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTrigger1), OutputTrigger1);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTrigger2), OutputTrigger2);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTrigger3), OutputTrigger3);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTrigger4), OutputTrigger4);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTrigger5), OutputTrigger5);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTrigger6), OutputTrigger6);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTrigger7), OutputTrigger7);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTrigger8), OutputTrigger8);
         }
 
         static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutErrors)
@@ -144,22 +141,24 @@ namespace Metasound
             );
         }
 
-        void Execute()
+        virtual void Reset(const IOperator::FResetParams& InParams)
         {
-            // Handle reset
-            InputReset->ExecuteBlock(
-                // Pre-trigger lambda
-                [](int32 StartFrame, int32 EndFrame)
-                {
-                    // No action needed before triggers
-                },
+            // Reset triggers
+            OutputTrigger1->Reset();
+            OutputTrigger2->Reset();
+            OutputTrigger3->Reset();
+            OutputTrigger4->Reset();
+            OutputTrigger5->Reset();
+            OutputTrigger6->Reset();
+            OutputTrigger7->Reset();
+            OutputTrigger8->Reset();
+
+            Divider.Reset();
+        }
 
-                // On-trigger lambda
-                [&](int32 StartFrame, int32 EndFrame)
-                {
-                    Counter = 0;
-                }
-            );
+        void Execute()
+        {
+            METASOUND_BRANCHES_SCOPE_EXECUTE(ClockDivider, NumFramesPerBlock);
 
             // Initialize output triggers
             OutputTrigger1->AdvanceBlock();
@@ -171,70 +170,29 @@ namespace Metasound
             OutputTrigger7->AdvanceBlock();
             OutputTrigger8->AdvanceBlock();
 
-            // Handle input trigger
-            InputTrigger->ExecuteBlock(
-                // Pre-trigger lambda
-                [](int32 StartFrame, int32 EndFrame)
+            // Resets are applied in frame order with the input triggers, so the counter doesn't depend on
+            // where block boundaries fall
+            Divider.ProcessTriggers(
+                InputTrigger->NumTriggeredInBlock(), [this](int32 Index) { return (*InputTrigger)[Index]; },
+                InputReset->NumTriggeredInBlock(), [this](int32 Index) { return (*InputReset)[Index]; },
+                [this](int32 Frame, uint32 Mask)
                 {
-                    // No action needed before triggers
-                },
-
-                // On-trigger lambda
-                [&](int32 StartFrame, int32 EndFrame)
-                {
-                    Counter = (Counter + 1) % 8;
-
-                    switch (Counter)
-                    {
-                        case 0:
-                            OutputTrigger1->TriggerFrame(StartFrame);  
-                            break;
-
-                        case 1:
-                            OutputTrigger1->TriggerFrame(StartFrame);  
-                            OutputTrigger2->TriggerFrame(StartFrame);
-                            break;
-
-                        case 2:
-                            OutputTrigger1->TriggerFrame(StartFrame); 
-                            OutputTrigger3->TriggerFrame(StartFrame);
-                            break;
-
-                        case 3:
-                            OutputTrigger1->TriggerFrame(StartFrame);  
-                            OutputTrigger2->TriggerFrame(StartFrame);
-                            OutputTrigger4->TriggerFrame(StartFrame);
-                            break;
-
-                        case 4:
-                            OutputTrigger1->TriggerFrame(StartFrame);  
-                            OutputTrigger5->TriggerFrame(StartFrame);
-                            break;
-
-                        case 5:
-                            OutputTrigger1->TriggerFrame(StartFrame);  
-                            OutputTrigger2->TriggerFrame(StartFrame);
-                            OutputTrigger3->TriggerFrame(StartFrame);
-                            OutputTrigger6->TriggerFrame(StartFrame);
-                            break;
-
-                        case 6:
-                            OutputTrigger1->TriggerFrame(StartFrame);
-                            OutputTrigger7->TriggerFrame(StartFrame);
-                            break;
-
-                        case 7:
-                            OutputTrigger1->TriggerFrame(StartFrame);
-                            OutputTrigger2->TriggerFrame(StartFrame);
-                            OutputTrigger4->TriggerFrame(StartFrame);
-                            OutputTrigger8->TriggerFrame(StartFrame);
-                            break;
-
-                        default:
-                            break;
-                    }
+                    if (Mask & (1 << 0)) { OutputTrigger1->TriggerFrame(Frame); }
+                    if (Mask & (1 << 1)) { OutputTrigger2->TriggerFrame(Frame); }
+                    if (Mask & (1 << 2)) { OutputTrigger3->TriggerFrame(Frame); }
+                    if (Mask & (1 << 3)) { OutputTrigger4->TriggerFrame(Frame); }
+                    if (Mask & (1 << 4)) { OutputTrigger5->TriggerFrame(Frame); }
+                    if (Mask & (1 << 5)) { OutputTrigger6->TriggerFrame(Frame); }
+                    if (Mask & (1 << 6)) { OutputTrigger7->TriggerFrame(Frame); }
+                    if (Mask & (1 << 7)) { OutputTrigger8->TriggerFrame(Frame); }
                 }
             );
+
+            METASOUND_BRANCHES_COUNT_TRIGGERS(ClockDivider,
+                OutputTrigger1->NumTriggeredInBlock() + OutputTrigger2->NumTriggeredInBlock() +
+                OutputTrigger3->NumTriggeredInBlock() + OutputTrigger4->NumTriggeredInBlock() +
+                OutputTrigger5->NumTriggeredInBlock() + OutputTrigger6->NumTriggeredInBlock() +
+                OutputTrigger7->NumTriggeredInBlock() + OutputTrigger8->NumTriggeredInBlock());
         }
 
     private:
@@ -250,7 +208,10 @@ namespace Metasound
         FTriggerWriteRef OutputTrigger7;
         FTriggerWriteRef OutputTrigger8;
 
-        int32 Counter;
+        MetasoundBranches::FClockDividerKernel Divider;
+
+        // Frames in each block, for the node stats
+        int32 NumFramesPerBlock;
     };
 
     class FClockDividerNode : public FNodeFacade
@@ -263,6 +224,7 @@ namespace Metasound
     };
 
     METASOUND_REGISTER_NODE(FClockDividerNode);
+    METASOUND_BRANCHES_LIST_NODE(FClockDividerNode);
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
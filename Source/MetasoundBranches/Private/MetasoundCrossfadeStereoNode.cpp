@@ -1,11 +1,15 @@
 // Copyright 2025 Charles Matthews. All Rights Reserved.
 
 #include "MetasoundBranches/Public/MetasoundCrossfadeStereoNode.h"
+#include "MetasoundBranches/Public/DSP/StereoKernels.h"
 #include "MetasoundExecutableOperator.h"     // TExecutableOperator class
 #include "MetasoundPrimitives.h"             // ReadRef and WriteRef descriptions for bool, int32, float, and string
 #include "MetasoundNodeRegistrationMacro.h"  // METASOUND_LOCTEXT and METASOUND_REGISTER_NODE macros
 #include "MetasoundFacade.h"                 // FNodeFacade class, eliminates the need for a fair amount of boilerplate code
 #include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "MetasoundBranches/Private/MetasoundBranchesBinding.h"
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_CrossfadeStereoNode"
 
@@ -18,29 +22,63 @@ namespace Metasound
         METASOUND_PARAM(InputLeftSignal2, "In2 L", "Left channel of second input.");
         METASOUND_PARAM(InputRightSignal2, "In2 R", "Right channel of second input.");
         METASOUND_PARAM(InputCrossfade, "Crossfade", "Crossfade between the two inputs (0.0 to 1.0).");
+        METASOUND_PARAM(InputCrossfadeModulation, "Crossfade Mod", "Audio-rate modulation added to Crossfade.");
 
         METASOUND_PARAM(OutputLeftSignal, "Out L", "Left channel of the output signal.");
         METASOUND_PARAM(OutputRightSignal, "Out R", "Right channel of the output signal.");
     }
 
+    METASOUND_BRANCHES_DECLARE_NODE_STATS(StereoCrossfade, "Stereo Crossfade")
+
     class FCrossfadeStereoOperator : public TExecutableOperator<FCrossfadeStereoOperator>
     {
     public:
+        // With a constant crossfade at either end and no modulation, the outputs can be bound straight to one input pair
+        enum class ERouting : uint8
+        {
+            Process,
+            First,
+            Second
+        };
+
+        static ERouting GetRouting(bool bInCrossfadeIsConstant, bool bInIsModulated, float InCrossfade)
+        {
+            if (!bInCrossfadeIsConstant || bInIsModulated)
+            {
+                return ERouting::Process;
+            }
+
+            if (InCrossfade <= 0.0f)
+            {
+                return ERouting::First;
+            }
+
+            return (InCrossfade >= 1.0f) ? ERouting::Second : ERouting::Process;
+        }
+
         FCrossfadeStereoOperator(
             const FOperatorSettings& InSettings,
             const FAudioBufferReadRef& InLeftSignal1,
             const FAudioBufferReadRef& InRightSignal1,
             const FAudioBufferReadRef& InLeftSignal2,
             const FAudioBufferReadRef& InRightSignal2,
-            const FFloatReadRef& InCrossfade)
+            const FFloatReadRef& InCrossfade,
+            const FAudioBufferReadRef& InCrossfadeModulation,
+            bool bInIsModulated,
+            bool bInCrossfadeIsConstant)
             : InputLeftSignal1(InLeftSignal1)
             , InputRightSignal1(InRightSignal1)
             , InputLeftSignal2(InLeftSignal2)
             , InputRightSignal2(InRightSignal2)
             , InputCrossfade(InCrossfade)
+            , InputCrossfadeModulation(InCrossfadeModulation)
+            , bIsModulated(bInIsModulated)
             , OutputLeftSignal(FAudioBufferWriteRef::CreateNew(InSettings))
             , OutputRightSignal(FAudioBufferWriteRef::CreateNew(InSettings))
+            , bCrossfadeIsConstant(bInCrossfadeIsConstant)
+            , Routing(GetRouting(bInCrossfadeIsConstant, bInIsModulated, *InCrossfade))
         {
+            UpdateGains();
         }
 
         static const FVertexInterface& DeclareVertexInterface()
@@ -53,7 +91,8 @@ namespace Metasound
                     TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal1)),
                     TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal2)),
                     TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal2)),
-                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputCrossfade), 0.5f)
+                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputCrossfade), 0.5f),
+                    TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputCrossfadeModulation))
                 ),
                 FOutputVertexInterface(
                     TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputLeftSignal)),
@@ -74,7 +113,7 @@ namespace Metasound
 
                     Metadata.ClassName = { TEXT("UE"), TEXT("Stereo Crossfade"), TEXT("Audio") };
                     Metadata.MajorVersion = 1;
-                    Metadata.MinorVersion = 0;
+                    Metadata.MinorVersion = 1;
                     Metadata.DisplayName = METASOUND_LOCTEXT("CrossfadeStereoNodeDisplayName", "Stereo Crossfade");
                     Metadata.Description = METASOUND_LOCTEXT("CrossfadeStereoNodeDesc", "Crossfades between two stereo signals.");
                     Metadata.Author = "Charles Matthews";
@@ -90,31 +129,46 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace CrossfadeStereoNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
+            // Check before binding, while the vertex data still shows what the graph connected
+            bCrossfadeIsConstant = MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputCrossfade), InputCrossfade, bCrossfadeIsConstant);
+            bIsModulated = MetasoundBranches::IsConnectedInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputCrossfadeModulation), InputCrossfadeModulation, bIsModulated);
 
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputLeftSignal1), InputLeftSignal1);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputRightSignal1), InputRightSignal1);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputLeftSignal2), InputLeftSignal2);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputRightSignal2), InputRightSignal2);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputCrossfade), InputCrossfade);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputLeftSignal1), InputLeftSignal1);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRightSignal1), InputRightSignal1);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputLeftSignal2), InputLeftSignal2);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRightSignal2), InputRightSignal2);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputCrossfade), InputCrossfade);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputCrossfadeModulation), InputCrossfadeModulation);
 
-            return InputDataReferences;
+            Routing = GetRouting(bCrossfadeIsConstant, bIsModulated, *InputCrossfade);
+            UpdateGains();
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace CrossfadeStereoNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputLeftSignal), OutputLeftSignal);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputRightSignal), OutputRightSignal);
-
-            return OutputDataReferences;
+            switch (Routing)
+            {
+            case ERouting::First:
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), InputLeftSignal1);
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), InputRightSignal1);
+                break;
+
+            case ERouting::Second:
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), InputLeftSignal2);
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), InputRightSignal2);
+                break;
+
+            default:
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), OutputLeftSignal);
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), OutputRightSignal);
+                break;
+            }
         }
 
         static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutErrors)
@@ -129,12 +183,31 @@ namespace Metasound
             TDataReadReference<FAudioBuffer> InputLeftSignal2 = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputLeftSignal2), InParams.OperatorSettings);
             TDataReadReference<FAudioBuffer> InputRightSignal2 = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputRightSignal2), InParams.OperatorSettings);
             TDataReadReference<float> InputCrossfade = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputCrossfade), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputCrossfadeModulation = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputCrossfadeModulation), InParams.OperatorSettings);
+
+            const bool bIsModulated = MetasoundBranches::IsConnectedInput(InputData, METASOUND_GET_PARAM_NAME(InputCrossfadeModulation));
+
+            const bool bCrossfadeIsConstant = MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputCrossfade));
+
+            return MakeUnique<FCrossfadeStereoOperator>(InParams.OperatorSettings, InputLeftSignal1, InputRightSignal1, InputLeftSignal2, InputRightSignal2, InputCrossfade, InputCrossfadeModulation, bIsModulated, bCrossfadeIsConstant);
+        }
 
-            return MakeUnique<FCrossfadeStereoOperator>(InParams.OperatorSettings, InputLeftSignal1, InputRightSignal1, InputLeftSignal2, InputRightSignal2, InputCrossfade);
+        virtual void Reset(const IOperator::FResetParams& InParams)
+        {
+            OutputLeftSignal->Zero();
+            OutputRightSignal->Zero();
         }
 
         void Execute()
         {
+            METASOUND_BRANCHES_SCOPE_EXECUTE(StereoCrossfade, InputLeftSignal1->Num());
+
+            if (Routing != ERouting::Process)
+            {
+                METASOUND_BRANCHES_COUNT_SHORT_CIRCUIT(StereoCrossfade);
+                return;
+            }
+
             int32 NumFrames = InputLeftSignal1->Num();
 
             const float* LeftData1 = InputLeftSignal1->GetData();
@@ -145,19 +218,28 @@ namespace Metasound
             float* OutputLeftData = OutputLeftSignal->GetData();
             float* OutputRightData = OutputRightSignal->GetData();
 
-            float CrossfadeFactor = FMath::Clamp(*InputCrossfade, 0.0f, 1.0f);
-
-            float Gain1 = FMath::Cos(CrossfadeFactor * HALF_PI); // HALF_PI = PI / 2
-            float Gain2 = FMath::Sin(CrossfadeFactor * HALF_PI);
-
-            for (int32 i = 0; i < NumFrames; ++i)
+            if (bIsModulated)
+            {
+                MetasoundBranches::ProcessStereoCrossfadeModulated(LeftData1, RightData1, LeftData2, RightData2, InputCrossfadeModulation->GetData(), OutputLeftData, OutputRightData, NumFrames, *InputCrossfade);
+            }
+            else if (bCrossfadeIsConstant)
             {
-                OutputLeftData[i] = Gain1 * LeftData1[i] + Gain2 * LeftData2[i];
-                OutputRightData[i] = Gain1 * RightData1[i] + Gain2 * RightData2[i];
+                MetasoundBranches::ProcessStereoCrossfadeGains(LeftData1, RightData1, LeftData2, RightData2, OutputLeftData, OutputRightData, NumFrames, Gain1, Gain2);
+            }
+            else
+            {
+                MetasoundBranches::ProcessStereoCrossfade(LeftData1, RightData1, LeftData2, RightData2, OutputLeftData, OutputRightData, NumFrames, *InputCrossfade);
             }
         }
 
     private:
+        void UpdateGains()
+        {
+            if (bCrossfadeIsConstant)
+            {
+                MetasoundBranches::GetCrossfadeGains(*InputCrossfade, Gain1, Gain2);
+            }
+        }
 
         // Inputs
         FAudioBufferReadRef InputLeftSignal1;
@@ -165,10 +247,20 @@ namespace Metasound
         FAudioBufferReadRef InputLeftSignal2;
         FAudioBufferReadRef InputRightSignal2;
         FFloatReadRef InputCrossfade;
+        FAudioBufferReadRef InputCrossfadeModulation;
 
         // Outputs
         FAudioBufferWriteRef OutputLeftSignal;
         FAudioBufferWriteRef OutputRightSignal;
+
+        bool bIsModulated = false;
+        bool bCrossfadeIsConstant = false;
+
+        // Gains for a constant crossfade, worked out once in UpdateGains
+        float Gain1 = 1.0f;
+        float Gain2 = 0.0f;
+
+        ERouting Routing = ERouting::Process;
     };
 
     class FCrossfadeStereoNode : public FNodeFacade
@@ -181,6 +273,7 @@ namespace Metasound
     };
 
     METASOUND_REGISTER_NODE(FCrossfadeStereoNode);
+    METASOUND_BRANCHES_LIST_NODE(FCrossfadeStereoNode);
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
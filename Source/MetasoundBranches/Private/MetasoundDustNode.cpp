@@ -8,6 +8,9 @@
 #include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
 #include "Math/UnrealMathUtility.h"          // For FMath functions
 #include "Misc/DateTime.h"                   // For FDateTime::UtcNow()
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
+#include "MetasoundBranches/Public/DSP/DustKernel.h"
 
 // Required for ensuring the node is supported by all languages in engine. Must be unique per MetaSound.
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_DustNode"
@@ -24,6 +27,8 @@ namespace Metasound
         METASOUND_PARAM(OutputImpulse, "Impulse Out", "Generated impulse output.");
     }
 
+    METASOUND_BRANCHES_DECLARE_NODE_STATS(DustAudio, "Dust (Audio)")
+
     // Operator Class - defines the way the node is described, created and executed
     class FDustOperator : public TExecutableOperator<FDustOperator>
     {
@@ -40,8 +45,7 @@ namespace Metasound
             , InputEnabled(InEnabled)
             , InputBiPolar(InBiPolar)
             , OutputImpulse(FAudioBufferWriteRef::CreateNew(InSettings))
-            , RNGStream(InitialSeed())
-            , SignalIsPositive(true)
+            , Dust(InitialSeed())
         {
         }
 
@@ -93,27 +97,22 @@ namespace Metasound
         }
 
         // Allows MetaSound graph to interact with the node's inputs
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace DustNodeNames;
-            FDataReferenceCollection Inputs;
-            Inputs.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputDensity), InputDensity);
-            Inputs.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputDensityOffset), InputDensityOffset);
-            Inputs.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputEnabled), InputEnabled);
-            Inputs.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputBiPolar), InputBiPolar);
-            return Inputs;
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputDensity), InputDensity);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputDensityOffset), InputDensityOffset);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputEnabled), InputEnabled);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputBiPolar), InputBiPolar);
         }
 
         // Allows MetaSound graph to interact with the node's outputs
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace DustNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputImpulse), OutputImpulse);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputImpulse), OutputImpulse);
         }
 
         // Used to instantiate a new runtime instance of the node
@@ -132,49 +131,32 @@ namespace Metasound
             return MakeUnique<FDustOperator>(InParams.OperatorSettings, InputDensity, InputDensityOffset, InputEnabled, InputBiPolar);
         }
 
+        // Return to the freshly constructed state, reusing existing buffers
+        virtual void Reset(const IOperator::FResetParams& InParams)
+        {
+            OutputImpulse->Zero();
+            ImpulseWriter.MarkZeroed();
+
+            // Rewind to the seed chosen at construction
+            Dust.Reset();
+        }
+
         // Primary node functionality
         void Execute()
         {
-        const float* DensityData = InputDensity->GetData();
-        float* OutputDataPtr = OutputImpulse->GetData();
-        int32 NumFrames = InputDensity->Num();
-        float InputDensityOffsetValue = *InputDensityOffset;
-        bool bEnabled = *InputEnabled;
-        bool bBiPolar = *InputBiPolar;
-
-        for (int32 i = 0; i < NumFrames; ++i)
-        {
-            if (bEnabled)
-            {
-                float Density = DensityData[i];
-                float AbsDensity = FMath::Abs(Density) + InputDensityOffsetValue;
-                float Threshold = 1.0f - AbsDensity * 0.0009f;
-
-                float RandomValue = RNGStream.GetFraction();
+            METASOUND_BRANCHES_SCOPE_EXECUTE(DustAudio, InputDensity->Num());
 
-                if (RandomValue > Threshold)
-                {
-                    if (bBiPolar)
-                    {
-                        OutputDataPtr[i] = SignalIsPositive ? 1.0f : -1.0f;
-                        SignalIsPositive = !SignalIsPositive; 
-                    }
-                    else
-                    {
-                        OutputDataPtr[i] = 1.0f;
-                    }
-                }
-                else
-                {
-                    OutputDataPtr[i] = 0.0f;
-                }
-            }
-            else
+            if (!*InputEnabled)
             {
-                OutputDataPtr[i] = 0.0f; // Output zero when disabled
+                // Output zero when disabled; once last block's impulses are cleared there is nothing to do
+                ImpulseWriter.Clear(OutputImpulse->GetData(), OutputImpulse->Num());
+                METASOUND_BRANCHES_COUNT_SHORT_CIRCUIT(DustAudio);
+                return;
             }
+
+            const int32 NumImpulses = Dust.ProcessSparse(InputDensity->GetData(), *InputDensityOffset, *InputBiPolar, OutputImpulse->GetData(), InputDensity->Num(), ImpulseWriter);
+            METASOUND_BRANCHES_COUNT_TRIGGERS(DustAudio, NumImpulses);
         }
-    }
 
     private:
 
@@ -187,16 +169,16 @@ namespace Metasound
         // Outputs
         FAudioBufferWriteRef OutputImpulse;
 
-        // Random number generator
-        FRandomStream RNGStream;
-        
-        // Toggle flag for polarity
-        bool SignalIsPositive;
+        // Random impulse generator and polarity state
+        MetasoundBranches::FDustKernel Dust;
+
+        // Frames holding last block's impulses
+        MetasoundBranches::FSparseBufferWriter ImpulseWriter;
 
-        // Generate an initial seed for FRandomStream
-        static int32 InitialSeed()
+        // Generate an initial seed from the clock
+        static uint32 InitialSeed()
         {
-            return FDateTime::UtcNow().GetTicks();
+            return static_cast<uint32>(FDateTime::UtcNow().GetTicks());
         }
     };
 
@@ -212,6 +194,7 @@ namespace Metasound
 
     // Register node
     METASOUND_REGISTER_NODE(FDustNode);
+    METASOUND_BRANCHES_LIST_NODE(FDustNode);
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
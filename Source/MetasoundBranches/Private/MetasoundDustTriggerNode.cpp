@@ -9,6 +9,8 @@
 #include "Math/UnrealMathUtility.h"          // For FMath functions
 #include "Misc/DateTime.h"                   // For FDateTime::UtcNow()
 #include "MetasoundTrigger.h"                // For FTrigger classes
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
 
 // Required for ensuring the node is supported by all languages in engine. Must be unique per MetaSound.
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_DustTriggerNode"
@@ -24,6 +26,8 @@ namespace Metasound
         METASOUND_PARAM(OutputTrigger, "Trigger Out", "Generated trigger output.");
     }
 
+    METASOUND_BRANCHES_DECLARE_NODE_STATS(DustTrigger, "Dust (Trigger)")
+
     // Operator Class - defines the way the node is described, created and executed
     class FDustTriggerOperator : public TExecutableOperator<FDustTriggerOperator>
     {
@@ -89,26 +93,21 @@ namespace Metasound
         }
 
         // Allows MetaSound graph to interact with the node's inputs
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace DustTriggerNodeNames;
-            FDataReferenceCollection Inputs;
-            Inputs.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputDensity), InputDensity);
-            Inputs.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputDensityOffset), InputDensityOffset);
-            Inputs.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputEnabled), InputEnabled);
-            return Inputs;
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputDensity), InputDensity);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputDensityOffset), InputDensityOffset);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputEnabled), InputEnabled);
         }
 
         // Allows MetaSound graph to interact with the node's outputs
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace DustTriggerNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTrigger), OutputTrigger);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTrigger), OutputTrigger);
         }
 
         // Used to instantiate a new runtime instance of the node
@@ -126,15 +125,31 @@ namespace Metasound
             return MakeUnique<FDustTriggerOperator>(InParams.OperatorSettings, InputDensity, InputDensityOffset, InputEnabled);
         }
 
+        virtual void Reset(const IOperator::FResetParams& InParams)
+        {
+            OutputTrigger->Reset();
+
+            // Rewind to the seed chosen at construction
+            RNGStream.Reset();
+        }
+
         // Primary node functionality
         void Execute()
         {
+            METASOUND_BRANCHES_SCOPE_EXECUTE(DustTrigger, InputDensity->Num());
+
             OutputTrigger->AdvanceBlock();
             const float* DensityData = InputDensity->GetData();
             int32 NumFrames = InputDensity->Num();
             float InputDensityOffsetValue = *InputDensityOffset;
             bool bEnabled = *InputEnabled;
 
+            if (!bEnabled)
+            {
+                METASOUND_BRANCHES_COUNT_SHORT_CIRCUIT(DustTrigger);
+                return;
+            }
+
             for (int32 i = 0; i < NumFrames; ++i)
             {
                 if (bEnabled)
@@ -151,6 +166,8 @@ namespace Metasound
                     }
                 }
             }
+
+            METASOUND_BRANCHES_COUNT_TRIGGERS(DustTrigger, OutputTrigger->NumTriggeredInBlock());
         }
 
     private:
@@ -185,6 +202,7 @@ namespace Metasound
 
     // Register node
     METASOUND_REGISTER_NODE(FDustTriggerNode);
+    METASOUND_BRANCHES_LIST_NODE(FDustTriggerNode);
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
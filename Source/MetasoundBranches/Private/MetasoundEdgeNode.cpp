@@ -1,12 +1,15 @@
 // Copyright 2025 Charles Matthews. All Rights Reserved.
 
 #include "MetasoundBranches/Public/MetasoundEdgeNode.h"
+#include "MetasoundBranches/Public/DSP/EdgeKernel.h"
 #include "MetasoundExecutableOperator.h"     // TExecutableOperator class
 #include "MetasoundPrimitives.h"             // ReadRef and WriteRef descriptions for bool, int32, float, and string
 #include "MetasoundNodeRegistrationMacro.h"  // METASOUND_LOCTEXT and METASOUND_REGISTER_NODE macros
 #include "MetasoundFacade.h"                 // FNodeFacade class, eliminates the need for a fair amount of boilerplate code
 #include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
 #include "MetasoundTrigger.h"                // For FTriggerWriteRef and FTrigger
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_Edge"
 
@@ -21,6 +24,8 @@ namespace Metasound
         METASOUND_PARAM(OutputTriggerFall, "Fall", "Trigger on fall.");
     }
 
+    METASOUND_BRANCHES_DECLARE_NODE_STATS(Edge, "Edge")
+
     class FEdgeOperator : public TExecutableOperator<FEdgeOperator>
     {
     public:
@@ -34,9 +39,7 @@ namespace Metasound
             , InputDebounce(InDebounce)
             , OutputTriggerRise(FTriggerWriteRef::CreateNew(InSettings))
             , OutputTriggerFall(FTriggerWriteRef::CreateNew(InSettings))
-            , PreviousSignalValue(0.0f)
             , DebounceSamples(0)
-            , DebounceCounter(0)
             , SampleRate(InSampleRate)
         {
         }
@@ -85,28 +88,20 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace EdgeNames;
 
-            FDataReferenceCollection InputDataReferences;
-
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputDebounce), InputDebounce);
-
-            return InputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputDebounce), InputDebounce);
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace EdgeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTriggerRise), OutputTriggerRise);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTriggerFall), OutputTriggerFall);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTriggerRise), OutputTriggerRise);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTriggerFall), OutputTriggerFall);
         }
 
         static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutErrors)
@@ -133,22 +128,15 @@ namespace Metasound
             OutputTriggerRise->Reset();
             OutputTriggerFall->Reset();
 
-            // Initialize PreviousSignalValue to the first sample of the incoming signal to prevent false triggers
-            if (InputSignal->Num() > 0)
-            {
-                PreviousSignalValue = InputSignal->GetData()[0];
-            }
-            else
-            {
-                PreviousSignalValue = 0.0f;
-            }
-
-            // Reset debounce counter
-            DebounceCounter = 0;
+            // Start from the first sample of the incoming signal to prevent false triggers,
+            // and reset edge direction and debounce counter
+            Edge.Reset(InputSignal->Num() > 0 ? InputSignal->GetData()[0] : 0.0f);
         }
 
         void Execute()
         {
+            METASOUND_BRANCHES_SCOPE_EXECUTE(Edge, InputSignal->Num());
+
             OutputTriggerRise->AdvanceBlock();
             OutputTriggerFall->AdvanceBlock();
 
@@ -159,41 +147,16 @@ namespace Metasound
             // Recalculate debounce samples if debounce time or sample rate has changed
             if (LastDebounceTime != DebounceTime || LastSampleRate != SampleRate)
             {
-                DebounceSamples = FMath::RoundToInt(FMath::Clamp(DebounceTime, 0.001f, 5.0f) * SampleRate);
+                DebounceSamples = MetasoundBranches::FEdgeKernel::GetDebounceSamples(DebounceTime, SampleRate);
                 LastDebounceTime = DebounceTime;
                 LastSampleRate = SampleRate;
             }
 
-            for (int32 i = 0; i < NumFrames; ++i)
-            {
-                float CurrentSignal = SignalData[i];
-
-                // Decrement debounce counter
-                if (DebounceCounter > 0)
-                {
-                    DebounceCounter--;
-                }
-
-                // Detect rising edge
-                if (CurrentSignal > PreviousSignalValue && !PreviousIsRising && DebounceCounter <= 0)
-                {
-                    // Rising edge detected
-                    OutputTriggerRise->TriggerFrame(i);
-                    DebounceCounter = DebounceSamples;
-                    PreviousIsRising = true;
-                }
-                // Detect falling edge
-                else if (CurrentSignal < PreviousSignalValue && PreviousIsRising && DebounceCounter <= 0)
-                {
-                    // Falling edge detected
-                    OutputTriggerFall->TriggerFrame(i);
-                    DebounceCounter = DebounceSamples;
-                    PreviousIsRising = false;
-                }
-
-                // Update previous signal value
-                PreviousSignalValue = CurrentSignal;
-            }
+            Edge.ProcessBuffer(SignalData, NumFrames, DebounceSamples,
+                [this](int32 Frame) { OutputTriggerRise->TriggerFrame(Frame); },
+                [this](int32 Frame) { OutputTriggerFall->TriggerFrame(Frame); });
+
+            METASOUND_BRANCHES_COUNT_TRIGGERS(Edge, OutputTriggerRise->NumTriggeredInBlock() + OutputTriggerFall->NumTriggeredInBlock());
         }
 
     private:
@@ -206,10 +169,8 @@ namespace Metasound
         FTriggerWriteRef OutputTriggerFall;
 
         // Internal variables
-        float PreviousSignalValue;
-        bool PreviousIsRising = false;
+        MetasoundBranches::FEdgeKernel Edge;
         int32 DebounceSamples;
-        int32 DebounceCounter;
         float SampleRate;
         
         // Variables to track changes in debounce time and sample rate
@@ -227,6 +188,7 @@ namespace Metasound
     };
 
     METASOUND_REGISTER_NODE(FEdgeNode);
+    METASOUND_BRANCHES_LIST_NODE(FEdgeNode);
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
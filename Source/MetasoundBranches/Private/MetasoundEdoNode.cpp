@@ -1,11 +1,15 @@
 // Copyright 2025 Charles Matthews. All Rights Reserved.
 
 #include "MetasoundBranches/Public/MetasoundEdoNode.h"
+#include "MetasoundBranches/Public/DSP/TuningKernel.h"
 #include "MetasoundExecutableOperator.h"
 #include "MetasoundPrimitives.h"
 #include "MetasoundNodeRegistrationMacro.h"
 #include "MetasoundFacade.h"
 #include "MetasoundParamHelper.h"
+#include "MetasoundBranches/Private/MetasoundBranchesBinding.h"
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_EdoNode"
 
@@ -20,6 +24,8 @@ namespace Metasound
         METASOUND_PARAM(OutputFrequency, "Frequency", "Output frequency.");
     }
 
+    METASOUND_BRANCHES_DECLARE_NODE_STATS(Edo, "EDO")
+
     class FEdoNodeOperator : public TExecutableOperator<FEdoNodeOperator>
     {
     public:
@@ -28,13 +34,20 @@ namespace Metasound
             const FInt32ReadRef& InNoteNumber,
             const FFloatReadRef& InReferenceFrequency,
             const FInt32ReadRef& InReferenceMIDINote,
-            const FInt32ReadRef& InDivisions)
+            const FInt32ReadRef& InDivisions,
+            bool bInInputsAreConstant)
             : NoteNumber(InNoteNumber)
             , ReferenceFrequency(InReferenceFrequency)
             , ReferenceMIDINote(InReferenceMIDINote)
             , Divisions(InDivisions)
             , OutputFrequency(FFloatWriteRef::CreateNew(0.0f))
+            , bInputsAreConstant(bInInputsAreConstant)
+            , NumFramesPerBlock(InSettings.GetNumFramesPerBlock())
         {
+            if (bInputsAreConstant)
+            {
+                UpdateFrequency();
+            }
         }
 
         static const FVertexInterface& DeclareVertexInterface()
@@ -82,29 +95,33 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace EdoNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
+            // An input that keeps its reference falls back on the combined answer from last time, which can only be pessimistic
+            bInputsAreConstant =
+                MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputNoteNumber), NoteNumber, bInputsAreConstant) &&
+                MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputReferenceFrequency), ReferenceFrequency, bInputsAreConstant) &&
+                MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputReferenceMIDINote), ReferenceMIDINote, bInputsAreConstant) &&
+                MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputDivisions), Divisions, bInputsAreConstant);
 
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputNoteNumber), NoteNumber);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputReferenceFrequency), ReferenceFrequency);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputReferenceMIDINote), ReferenceMIDINote);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputDivisions), Divisions);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputNoteNumber), NoteNumber);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputReferenceFrequency), ReferenceFrequency);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputReferenceMIDINote), ReferenceMIDINote);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputDivisions), Divisions);
 
-            return InputDataReferences;
+            if (bInputsAreConstant)
+            {
+                UpdateFrequency();
+            }
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace EdoNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputFrequency), OutputFrequency);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputFrequency), OutputFrequency);
         }
 
         static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutErrors)
@@ -119,40 +136,66 @@ namespace Metasound
             TDataReadReference<int32> ReferenceMIDINote = InputData.GetOrCreateDefaultDataReadReference<int32>(METASOUND_GET_PARAM_NAME(InputReferenceMIDINote), InParams.OperatorSettings);
             TDataReadReference<int32> Divisions = InputData.GetOrCreateDefaultDataReadReference<int32>(METASOUND_GET_PARAM_NAME(InputDivisions), InParams.OperatorSettings);
 
+            // With every input set in the graph the frequency never changes, so it is worked out once here
+            const bool bInputsAreConstant =
+                MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputNoteNumber)) &&
+                MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputReferenceFrequency)) &&
+                MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputReferenceMIDINote)) &&
+                MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputDivisions));
+
             return MakeUnique<FEdoNodeOperator>(
                 InParams.OperatorSettings,
                 NoteNumber,
                 ReferenceFrequency,
                 ReferenceMIDINote,
-                Divisions
+                Divisions,
+                bInputsAreConstant
             );
         }
 
+        virtual void Reset(const IOperator::FResetParams& InParams)
+        {
+            if (bInputsAreConstant)
+            {
+                UpdateFrequency();
+            }
+            else
+            {
+                *OutputFrequency = 0.0f;
+            }
+        }
+
         void Execute()
         {
-            int32 noteNumber = *NoteNumber;
-            float refFreq = *ReferenceFrequency;
-            int32 refMIDINote = *ReferenceMIDINote;
-            int32 divisions = *Divisions;
+            METASOUND_BRANCHES_SCOPE_EXECUTE(Edo, NumFramesPerBlock);
 
-            if (divisions == 0)
+            if (bInputsAreConstant)
             {
-                divisions = 1;
+                METASOUND_BRANCHES_COUNT_SHORT_CIRCUIT(Edo);
+                return;
             }
 
-            float exponent = static_cast<float>(noteNumber - refMIDINote) / static_cast<float>(divisions);
-            float frequency = refFreq * powf(2.0f, exponent);
-
-            *OutputFrequency = frequency;
+            UpdateFrequency();
         }
 
     private:
+        void UpdateFrequency()
+        {
+            *OutputFrequency = MetasoundBranches::FEqualDivisionTuning::GetFrequency(*NoteNumber, *ReferenceFrequency, *ReferenceMIDINote, *Divisions);
+        }
+
         FInt32ReadRef NoteNumber;
         FFloatReadRef ReferenceFrequency;
         FInt32ReadRef ReferenceMIDINote;
         FInt32ReadRef Divisions;
 
         FFloatWriteRef OutputFrequency;
+
+        // Every input is set in the graph, so OutputFrequency was written once and Execute has nothing to do
+        bool bInputsAreConstant = false;
+
+        // Frames in each block, for the node stats
+        int32 NumFramesPerBlock = 0;
     };
 
     class FEdoNode : public FNodeFacade
@@ -165,6 +208,7 @@ namespace Metasound
     };
 
     METASOUND_REGISTER_NODE(FEdoNode);
+    METASOUND_BRANCHES_LIST_NODE(FEdoNode);
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
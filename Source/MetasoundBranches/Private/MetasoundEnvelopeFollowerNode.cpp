@@ -0,0 +1,218 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranches/Public/MetasoundEnvelopeFollowerNode.h"
+#include "MetasoundBranches/Public/DSP/EnvelopeFollowerKernel.h"
+#include "MetasoundExecutableOperator.h"
+#include "MetasoundPrimitives.h"
+#include "MetasoundNodeRegistrationMacro.h"
+#include "MetasoundFacade.h"
+#include "MetasoundParamHelper.h"
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
+
+#define LOCTEXT_NAMESPACE "MetasoundEnvelopeFollowerNode"
+
+namespace Metasound
+{
+    namespace EnvelopeFollowerNodeNames
+    {
+        METASOUND_PARAM(InputSignal, "In", "Audio signal to follow.");
+        METASOUND_PARAM(InputAttackTime, "Attack Time", "Attack time in seconds.");
+        METASOUND_PARAM(InputReleaseTime, "Release Time", "Release time in seconds.");
+        METASOUND_PARAM(InputMode, "Mode", "Detector: 0 = peak, 1 = RMS, 2 = windowed RMS.");
+        METASOUND_PARAM(InputWindow, "Window", "Length of the windowed RMS window in seconds (maximum 1).");
+        METASOUND_PARAM(InputDecimation, "Decimation", "Update the envelope once every this many samples, holding it in between. 1 updates on every sample.");
+
+        METASOUND_PARAM(OutputEnvelope, "Envelope", "Envelope of the input signal.");
+        METASOUND_PARAM(OutputValue, "Value", "Envelope at the end of each block, as a float.");
+    }
+
+    METASOUND_BRANCHES_DECLARE_NODE_STATS(EnvelopeFollower, "Envelope Follower")
+
+    class FEnvelopeFollowerOperator : public TExecutableOperator<FEnvelopeFollowerOperator>
+    {
+    public:
+        FEnvelopeFollowerOperator(
+            const FOperatorSettings& InSettings,
+            const FAudioBufferReadRef& InSignal,
+            const FTimeReadRef& InAttackTime,
+            const FTimeReadRef& InReleaseTime,
+            const FInt32ReadRef& InMode,
+            const FTimeReadRef& InWindow,
+            const FInt32ReadRef& InDecimation)
+            : InputSignal(InSignal)
+            , InputAttackTime(InAttackTime)
+            , InputReleaseTime(InReleaseTime)
+            , InputMode(InMode)
+            , InputWindow(InWindow)
+            , InputDecimation(InDecimation)
+            , OutputEnvelope(FAudioBufferWriteRef::CreateNew(InSettings))
+            , OutputValue(FFloatWriteRef::CreateNew(0.0f))
+            , SampleRate(InSettings.GetSampleRate())
+        {
+            // The window history is sized for the longest window here, so Window can change freely at runtime
+            Follower.InitWindow(MetasoundBranches::FEnvelopeFollowerKernel::GetMaxWindowSamples(SampleRate));
+            UpdateTrackedMemory();
+        }
+
+        virtual ~FEnvelopeFollowerOperator()
+        {
+            METASOUND_BRANCHES_TRACK_MEMORY(EnvelopeFollower, -TrackedBytes);
+        }
+
+        static const FVertexInterface& DeclareVertexInterface()
+        {
+            using namespace EnvelopeFollowerNodeNames;
+
+            static const FVertexInterface Interface(
+                FInputVertexInterface(
+                    TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSignal)),
+                    TInputDataVertex<FTime>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputAttackTime), 0.01f),
+                    TInputDataVertex<FTime>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputReleaseTime), 0.1f),
+                    TInputDataVertex<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputMode), 0),
+                    TInputDataVertex<FTime>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputWindow), 0.05f),
+                    TInputDataVertex<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputDecimation), 1)
+                ),
+                FOutputVertexInterface(
+                    TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputEnvelope)),
+                    TOutputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputValue))
+                )
+            );
+
+            return Interface;
+        }
+
+        static const FNodeClassMetadata& GetNodeInfo()
+        {
+            auto CreateNodeClassMetadata = []() -> FNodeClassMetadata
+            {
+                FVertexInterface NodeInterface = DeclareVertexInterface();
+
+                FNodeClassMetadata Metadata;
+                Metadata.ClassName = { TEXT("UE"), TEXT("EnvelopeFollower"), TEXT("Audio") };
+                Metadata.MajorVersion = 1;
+                Metadata.MinorVersion = 0;
+                Metadata.DisplayName = METASOUND_LOCTEXT("EnvelopeFollowerNodeDisplayName", "Envelope Follower");
+                Metadata.Description = METASOUND_LOCTEXT("EnvelopeFollowerNodeDesc", "Follow the peak or RMS level of an audio signal, with attack and release times.");
+                Metadata.Author = "Charles Matthews";
+                Metadata.PromptIfMissing = PluginNodeMissingPrompt;
+                Metadata.DefaultInterface = DeclareVertexInterface();
+                Metadata.CategoryHierarchy = { METASOUND_LOCTEXT("Custom", "Branches") };
+                Metadata.Keywords = TArray<FText>(); // Keywords for searching
+
+                return Metadata;
+            };
+
+            static const FNodeClassMetadata Metadata = CreateNodeClassMetadata();
+            return Metadata;
+        }
+
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace EnvelopeFollowerNodeNames;
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputAttackTime), InputAttackTime);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputReleaseTime), InputReleaseTime);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputMode), InputMode);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputWindow), InputWindow);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputDecimation), InputDecimation);
+        }
+
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace EnvelopeFollowerNodeNames;
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputEnvelope), OutputEnvelope);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputValue), OutputValue);
+        }
+
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutErrors)
+        {
+            using namespace EnvelopeFollowerNodeNames;
+
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
+
+            TDataReadReference<FAudioBuffer> InputSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputSignal), InParams.OperatorSettings);
+            TDataReadReference<FTime> InputAttackTime = InputData.GetOrCreateDefaultDataReadReference<FTime>(METASOUND_GET_PARAM_NAME(InputAttackTime), InParams.OperatorSettings);
+            TDataReadReference<FTime> InputReleaseTime = InputData.GetOrCreateDefaultDataReadReference<FTime>(METASOUND_GET_PARAM_NAME(InputReleaseTime), InParams.OperatorSettings);
+            TDataReadReference<int32> InputMode = InputData.GetOrCreateDefaultDataReadReference<int32>(METASOUND_GET_PARAM_NAME(InputMode), InParams.OperatorSettings);
+            TDataReadReference<FTime> InputWindow = InputData.GetOrCreateDefaultDataReadReference<FTime>(METASOUND_GET_PARAM_NAME(InputWindow), InParams.OperatorSettings);
+            TDataReadReference<int32> InputDecimation = InputData.GetOrCreateDefaultDataReadReference<int32>(METASOUND_GET_PARAM_NAME(InputDecimation), InParams.OperatorSettings);
+
+            return MakeUnique<FEnvelopeFollowerOperator>(InParams.OperatorSettings, InputSignal, InputAttackTime, InputReleaseTime, InputMode, InputWindow, InputDecimation);
+        }
+
+        virtual void Reset(const IOperator::FResetParams& InParams)
+        {
+            OutputEnvelope->Zero();
+            *OutputValue = 0.0f;
+
+            // Clear the envelope and window, keeping the window storage
+            Follower.Reset();
+        }
+
+        void Execute()
+        {
+            METASOUND_BRANCHES_SCOPE_EXECUTE(EnvelopeFollower, InputSignal->Num());
+
+            const MetasoundBranches::EEnvelopeFollowerMode Mode = MetasoundBranches::FEnvelopeFollowerKernel::GetMode(*InputMode);
+            Follower.SetMode(Mode);
+
+            if (Mode == MetasoundBranches::EEnvelopeFollowerMode::WindowedRMS)
+            {
+                const float WindowSeconds = FMath::Clamp(InputWindow->GetSeconds(), 0.0f, MetasoundBranches::FEnvelopeFollowerKernel::MaxWindowSeconds);
+                Follower.SetWindowLength(FMath::RoundToInt(WindowSeconds * SampleRate));
+            }
+
+            const int32 NumFrames = InputSignal->Num();
+            const int32 Decimation = FMath::Max(*InputDecimation, 1);
+
+            const float AttackAlpha = MetasoundBranches::FSlewKernel::GetAlpha(InputAttackTime->GetSeconds(), SampleRate);
+            const float ReleaseAlpha = MetasoundBranches::FSlewKernel::GetAlpha(InputReleaseTime->GetSeconds(), SampleRate);
+
+            *OutputValue = Follower.ProcessBuffer(InputSignal->GetData(), OutputEnvelope->GetData(), NumFrames, AttackAlpha, ReleaseAlpha, Decimation);
+        }
+
+    private:
+        void UpdateTrackedMemory()
+        {
+            const int64 Bytes = static_cast<int64>(sizeof(*this) + Follower.GetAllocatedSize());
+            METASOUND_BRANCHES_TRACK_MEMORY(EnvelopeFollower, Bytes - TrackedBytes);
+            TrackedBytes = Bytes;
+        }
+
+        // Inputs
+        FAudioBufferReadRef InputSignal;
+        FTimeReadRef InputAttackTime;
+        FTimeReadRef InputReleaseTime;
+        FInt32ReadRef InputMode;
+        FTimeReadRef InputWindow;
+        FInt32ReadRef InputDecimation;
+
+        // Outputs
+        FAudioBufferWriteRef OutputEnvelope;
+        FFloatWriteRef OutputValue;
+
+        MetasoundBranches::FEnvelopeFollowerKernel Follower;
+
+        float SampleRate;
+
+        // Instance size last reported to the node stats
+        int64 TrackedBytes = 0;
+    };
+
+    class FEnvelopeFollowerNode : public FNodeFacade
+    {
+    public:
+        FEnvelopeFollowerNode(const FNodeInitData& InitData)
+            : FNodeFacade(InitData.InstanceName, InitData.InstanceID, TFacadeOperatorClass<FEnvelopeFollowerOperator>())
+        {
+        }
+    };
+
+    METASOUND_REGISTER_NODE(FEnvelopeFollowerNode);
+    METASOUND_BRANCHES_LIST_NODE(FEnvelopeFollowerNode);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -6,6 +6,9 @@
 #include "MetasoundNodeRegistrationMacro.h"  // METASOUND_LOCTEXT and METASOUND_REGISTER_NODE macros
 #include "MetasoundFacade.h"                 // FNodeFacade class, eliminates the need for a fair amount of boilerplate code
 #include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
+#include "MetasoundBranches/Public/DSP/SparseBuffer.h"
 
 // Required for ensuring the node is supported by all languages in engine. Must be unique per MetaSound.
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_ImpulseNode"
@@ -21,6 +24,8 @@ namespace Metasound
         METASOUND_PARAM(OutputImpulse, "Impulse Out", "Generated impulse output.");
     }
 
+    METASOUND_BRANCHES_DECLARE_NODE_STATS(Impulse, "Impulse")
+
     // Operator Class - defines the way the node is described, created and executed
     class FImpulseOperator : public TExecutableOperator<FImpulseOperator>
     {
@@ -85,26 +90,21 @@ namespace Metasound
         }
 
         // Allows MetaSound graph to interact with the node's inputs
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace ImpulseNodeNames;
-            FDataReferenceCollection Inputs;
-            Inputs.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTrigger), InputTrigger);
-            Inputs.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputBiPolar), InputBiPolar);
-            return Inputs;
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTrigger), InputTrigger);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputBiPolar), InputBiPolar);
         }
 
         // Allows MetaSound graph to interact with the node's outputs
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace ImpulseNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-            
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputOnTrigger), OnTrigger);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputImpulse), OutputImpulse);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputOnTrigger), OnTrigger);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputImpulse), OutputImpulse);
         }
 
           static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutErrors)
@@ -124,18 +124,45 @@ namespace Metasound
             );
         }
 
+        virtual void Reset(const IOperator::FResetParams& InParams)
+        {
+            OnTrigger->Reset();
+            OutputImpulse->Zero();
+            ImpulseWriter.MarkZeroed();
+
+            // Start the next bipolar sequence on a positive impulse
+            SignalIsPositive = true;
+        }
+
         // Primary node functionality
         void Execute()
         {
+            METASOUND_BRANCHES_SCOPE_EXECUTE(Impulse, OutputImpulse->Num());
+
             OnTrigger->AdvanceBlock();
-            OutputImpulse->Zero(); // Ensure the output buffer is cleared
-            
-            // Initialize the output buffer to zero
+
+            // Clear only the frames last block's impulses were written to
             int32 NumFrames = OutputImpulse->Num();
             float* OutputDataPtr = OutputImpulse->GetData();
-            FMemory::Memzero(OutputDataPtr, sizeof(float) * NumFrames);
+            ImpulseWriter.Clear(OutputDataPtr, NumFrames);
+
+            // Read the polarity once and pick the loop for it
+            if (*InputBiPolar)
+            {
+                WriteImpulses<true>(OutputDataPtr, NumFrames);
+            }
+            else
+            {
+                WriteImpulses<false>(OutputDataPtr, NumFrames);
+            }
+
+            METASOUND_BRANCHES_COUNT_TRIGGERS(Impulse, OnTrigger->NumTriggeredInBlock());
+        }
 
-            // Process trigger events
+    private:
+        template <bool bBiPolar>
+        void WriteImpulses(float* OutputDataPtr, int32 NumFrames)
+        {
             InputTrigger->ExecuteBlock(
                 // Pre-trigger lambda (called before any triggers in the block)
                 [](int32 StartFrame, int32 EndFrame)
@@ -149,22 +176,20 @@ namespace Metasound
                     if (TriggerFrame < NumFrames)
                     {
                         OnTrigger->TriggerFrame(TriggerFrame);
-                        if (*InputBiPolar)
+                        if constexpr (bBiPolar)
                         {
-                            OutputDataPtr[TriggerFrame] = SignalIsPositive ? 1.0f : -1.0f;
+                            ImpulseWriter.Write(OutputDataPtr, TriggerFrame, SignalIsPositive ? 1.0f : -1.0f);
                             SignalIsPositive = !SignalIsPositive;
                         }
                         else
                         {
-                            OutputDataPtr[TriggerFrame] = 1.0f;
+                            ImpulseWriter.Write(OutputDataPtr, TriggerFrame, 1.0f);
                         }
                     }
                 }
             );
         }
 
-    private:
-
         // Inputs
         FTriggerReadRef InputTrigger;
         FBoolReadRef InputBiPolar;
@@ -175,6 +200,9 @@ namespace Metasound
 
         bool SignalIsPositive;
 
+        // Frames holding last block's impulses
+        MetasoundBranches::FSparseBufferWriter ImpulseWriter;
+
     };
 
     // Node Class - Inheriting from FNodeFacade is recommended for nodes that have a static FVertexInterface
@@ -189,6 +217,7 @@ namespace Metasound
 
     // Register node
     METASOUND_REGISTER_NODE(FImpulseNode);
+    METASOUND_BRANCHES_LIST_NODE(FImpulseNode);
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -1,12 +1,17 @@
 // Copyright 2025 Charles Matthews. All Rights Reserved.
 
 #include "MetasoundBranches/Public/MetasoundPhaseDisperserNode.h"
+#include "MetasoundBranches/Public/DSP/AllPassConvolutionKernel.h"
+#include "MetasoundBranches/Public/DSP/AllPassKernel.h"
 #include "MetasoundExecutableOperator.h"
 #include "MetasoundPrimitives.h"
 #include "MetasoundNodeRegistrationMacro.h"
 #include "MetasoundFacade.h"
 #include "MetasoundParamHelper.h"
 #include "Math/UnrealMathUtility.h"
+#include "MetasoundBranches/Private/MetasoundBranchesBinding.h"
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_PhaseDisperserNode"
 
@@ -20,22 +25,34 @@ namespace Metasound
         METASOUND_PARAM(NumFilters, "Stages", "Number of allpass filter stages to apply (maximum 128).");
     }
 
+    METASOUND_BRANCHES_DECLARE_NODE_STATS(PhaseDisperser, "Phase Disperser")
+
     class FPhaseDisperserOperator : public TExecutableOperator<FPhaseDisperserOperator>
     {
     public:
         // Maximum number of allowed allpass filters
-        static constexpr int32 MaxAllowedFilters = 128;
+        static constexpr int32 MaxAllowedFilters = MetasoundBranches::FPhaseDisperserKernel::MaxAllowedFilters;
+
+        // From this many stages, a stage count that can't change is run as a convolution; below it the cascade is cheaper
+        static constexpr int32 MinConvolutionFilters = 48;
 
-        FPhaseDisperserOperator(const FAudioBufferReadRef& InSignal, const TDataReadReference<int32>& InNumFilters)
+        FPhaseDisperserOperator(const FAudioBufferReadRef& InSignal, const TDataReadReference<int32>& InNumFilters, int32 InInitialNumFilters, bool bInNumFiltersIsConstant)
             : InputSignal(InSignal)
             , NumFilters(InNumFilters)
             , OutputSignal(FAudioBufferWriteRef::CreateNew(InSignal->Num()))
+            , bNumFiltersIsConstant(bInNumFiltersIsConstant)
         {
-            AllPassFilters.SetNum(MaxAllowedFilters);
-            for (int32 i = 0; i < MaxAllowedFilters; ++i)
-            {
-                AllPassFilters[i].Init();
-            }
+            // The convolution is only ever built here, at build time. While it runs the cascade keeps a single stage,
+            // and grows to the full count if a rebind falls back to it.
+            bUseConvolution = bNumFiltersIsConstant && InInitialNumFilters >= MinConvolutionFilters && Convolution.Init(InInitialNumFilters);
+            Disperser.Reserve(bUseConvolution ? 1 : InInitialNumFilters);
+
+            UpdateTrackedMemory();
+        }
+
+        virtual ~FPhaseDisperserOperator()
+        {
+            METASOUND_BRANCHES_TRACK_MEMORY(PhaseDisperser, -TrackedBytes);
         }
 
         static const FVertexInterface& DeclareVertexInterface()
@@ -80,25 +97,24 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace PhaseDisperserNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(NumFilters), NumFilters);
+            bNumFiltersIsConstant = MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(NumFilters), NumFilters, bNumFiltersIsConstant);
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(NumFilters), NumFilters);
 
-            return InputDataReferences;
+            UpdateConvolution();
+            UpdateTrackedMemory();
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace PhaseDisperserNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal), OutputSignal);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal), OutputSignal);
         }
 
         static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutErrors)
@@ -114,69 +130,49 @@ namespace Metasound
             TDataReadReference<int32> NumFiltersRef = InputData.GetOrCreateDefaultDataReadReference<int32>(
                 METASOUND_GET_PARAM_NAME(NumFilters), InParams.OperatorSettings);
 
+            // Size the stages for the value at build time; the kernel grows if the input later rises
             int32 ClampedNumFilters = FMath::Clamp(*NumFiltersRef, 1, MaxAllowedFilters);
-          
-            return MakeUnique<FPhaseDisperserOperator>(InputSignal, NumFiltersRef);
+
+            const bool bNumFiltersIsConstant = MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(NumFilters));
+
+            return MakeUnique<FPhaseDisperserOperator>(InputSignal, NumFiltersRef, ClampedNumFilters, bNumFiltersIsConstant);
+        }
+
+        virtual void Reset(const IOperator::FResetParams& InParams)
+        {
+            OutputSignal->Zero();
+
+            // Clear filter memories, keeping the existing delay buffers
+            Disperser.Reset();
+            Convolution.Reset();
         }
 
         void Execute()
         {
+            METASOUND_BRANCHES_SCOPE_EXECUTE(PhaseDisperser, InputSignal->Num());
+
             int32 NumFrames = InputSignal->Num();
             const float* InputData = InputSignal->GetData();
             float* OutputData = OutputSignal->GetData();
 
-            // Temporary buffer to hold intermediate results
-            TArray<float> TempBuffer;
-            TempBuffer.SetNumZeroed(NumFrames);
-
-            // Initial copy of input to temp buffer
-            FMemory::Memcpy(TempBuffer.GetData(), InputData, NumFrames * sizeof(float));
-
-            int32 CurrentNumFilters = FMath::Clamp(*NumFilters, 1, MaxAllowedFilters);
-
-            for (int32 i = 0; i < CurrentNumFilters; ++i)
+            if (bUseConvolution)
             {
-                AllPassFilters[i].ProcessBuffer(TempBuffer.GetData(), NumFrames);
+                Convolution.Process(InputData, OutputData, NumFrames);
+                return;
             }
 
-            FMemory::Memcpy(OutputData, TempBuffer.GetData(), NumFrames * sizeof(float));
-        }
+            // Filter the output buffer in place
+            FMemory::Memcpy(OutputData, InputData, NumFrames * sizeof(float));
+            const int32 NumAllocatedFilters = Disperser.GetNumAllocatedFilters();
+            Disperser.ProcessInPlace(OutputData, NumFrames, *NumFilters);
 
-    private:
-        class FAllPassFilter
-        {
-        public:
-            void Init(float InFeedback = 0.5f)
+            if (Disperser.GetNumAllocatedFilters() != NumAllocatedFilters)
             {
-                DelayBuffer.SetNumZeroed(2); // For D = 1
-                WriteIndex = 0;
-                Feedback = InFeedback;
+                UpdateTrackedMemory();
             }
+        }
 
-            void ProcessBuffer(float* InOutBuffer, int32 NumSamples)
-            {
-                for (int32 i = 0; i < NumSamples; ++i)
-                {
-                    float InSample = InOutBuffer[i];
-                    float DelayedSample = DelayBuffer[WriteIndex];
-
-                    // Allpass difference equation: y[n] = -a * x[n] + x[n-D] + a * y[n-D]
-                    float OutSample = -Feedback * InSample + DelayedSample;
-                    DelayBuffer[WriteIndex] = InSample + Feedback * OutSample;
-
-                    InOutBuffer[i] = OutSample;
-
-                    // Update write index for D = 1
-                    WriteIndex = (WriteIndex + 1) % 2;
-                }
-            }
-
-        private:
-            TArray<float> DelayBuffer;
-            int32 WriteIndex;
-            float Feedback;
-        };
-
+    private:
         // Inputs
         FAudioBufferReadRef InputSignal;
         FInt32ReadRef NumFilters;
@@ -185,7 +181,44 @@ namespace Metasound
         FAudioBufferWriteRef OutputSignal;
 
         // Allpass filters
-        TArray<FAllPassFilter> AllPassFilters;
+        MetasoundBranches::FPhaseDisperserKernel Disperser;
+
+        // The same cascade as a fixed filter, built only when the stage count is constant and high
+        MetasoundBranches::FPhaseDisperserConvolutionKernel Convolution;
+
+        bool bNumFiltersIsConstant = false;
+        bool bUseConvolution = false;
+
+        // Instance size last reported to the node stats
+        int64 TrackedBytes = 0;
+
+        // Called on a rebind. Building the filter allocates FFT buffers and computes the impulse response, so it is not
+        // done here: the convolution keeps running only while the input is still the constant it was built for, and
+        // anything else falls back to the cascade, grown to the new stage count.
+        void UpdateConvolution()
+        {
+            const int32 ClampedNumFilters = FMath::Clamp(*NumFilters, 1, MaxAllowedFilters);
+            const bool bWasUsingConvolution = bUseConvolution;
+
+            bUseConvolution = bNumFiltersIsConstant && Convolution.GetNumFilters() == ClampedNumFilters;
+
+            if (bUseConvolution && !bWasUsingConvolution)
+            {
+                // Switching back to the convolution starts it from silence rather than stale history
+                Convolution.Reset();
+            }
+            else if (!bUseConvolution)
+            {
+                Disperser.Reserve(ClampedNumFilters);
+            }
+        }
+
+        void UpdateTrackedMemory()
+        {
+            const int64 Bytes = static_cast<int64>(sizeof(*this) + Disperser.GetAllocatedSize() + Convolution.GetAllocatedSize());
+            METASOUND_BRANCHES_TRACK_MEMORY(PhaseDisperser, Bytes - TrackedBytes);
+            TrackedBytes = Bytes;
+        }
     };
 
     class FPhaseDisperserNode : public FNodeFacade
@@ -198,6 +231,7 @@ namespace Metasound
     };
 
     METASOUND_REGISTER_NODE(FPhaseDisperserNode);
+    METASOUND_BRANCHES_LIST_NODE(FPhaseDisperserNode);
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,232 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranches/Public/MetasoundPhaseDisperserStereoNode.h"
+#include "MetasoundBranches/Public/DSP/AllPassKernel.h"
+#include "MetasoundExecutableOperator.h"
+#include "MetasoundPrimitives.h"
+#include "MetasoundNodeRegistrationMacro.h"
+#include "MetasoundFacade.h"
+#include "MetasoundParamHelper.h"
+#include "Math/UnrealMathUtility.h"
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
+
+#define LOCTEXT_NAMESPACE "MetasoundStandardNodes_PhaseDisperserStereoNode"
+
+namespace Metasound
+{
+    namespace PhaseDisperserStereoNodeNames
+    {
+        METASOUND_PARAM(InputLeftSignal, "In L", "Left channel.");
+        METASOUND_PARAM(InputRightSignal, "In R", "Right channel.");
+        METASOUND_PARAM(NumFilters, "Stages", "Number of allpass filter stages to apply (maximum 128).");
+        METASOUND_PARAM(InputSpread, "Spread", "Offsets the filter coefficients of the two channels in opposite directions to decorrelate them (0 - 1).");
+
+        METASOUND_PARAM(OutputLeftSignal, "Out L", "Phase-dispersed left channel.");
+        METASOUND_PARAM(OutputRightSignal, "Out R", "Phase-dispersed right channel.");
+    }
+
+    METASOUND_BRANCHES_DECLARE_NODE_STATS(PhaseDisperserStereo, "Phase Disperser (Stereo)")
+
+    // Both channels share one stage cascade, processed side by side in a vector register
+    class FPhaseDisperserStereoOperator : public TExecutableOperator<FPhaseDisperserStereoOperator>
+    {
+    public:
+        static constexpr int32 MaxAllowedFilters = MetasoundBranches::FMultichannelPhaseDisperserKernel::MaxAllowedFilters;
+
+        // Coefficient offset applied to each channel at full spread
+        static constexpr float MaxFeedbackOffset = 0.1f;
+
+        FPhaseDisperserStereoOperator(
+            const FOperatorSettings& InSettings,
+            const FAudioBufferReadRef& InLeftSignal,
+            const FAudioBufferReadRef& InRightSignal,
+            const FInt32ReadRef& InNumFilters,
+            const FFloatReadRef& InSpread,
+            int32 InInitialNumFilters)
+            : InputLeftSignal(InLeftSignal)
+            , InputRightSignal(InRightSignal)
+            , NumFilters(InNumFilters)
+            , InputSpread(InSpread)
+            , OutputLeftSignal(FAudioBufferWriteRef::CreateNew(InSettings))
+            , OutputRightSignal(FAudioBufferWriteRef::CreateNew(InSettings))
+            , Disperser(2, InInitialNumFilters)
+        {
+            UpdateSpread();
+            UpdateTrackedMemory();
+        }
+
+        virtual ~FPhaseDisperserStereoOperator()
+        {
+            METASOUND_BRANCHES_TRACK_MEMORY(PhaseDisperserStereo, -TrackedBytes);
+        }
+
+        static const FVertexInterface& DeclareVertexInterface()
+        {
+            using namespace PhaseDisperserStereoNodeNames;
+
+            static const FVertexInterface Interface(
+                FInputVertexInterface(
+                    TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal)),
+                    TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal)),
+                    TInputDataVertex<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(NumFilters), 8),
+                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSpread), 0.0f)
+                ),
+                FOutputVertexInterface(
+                    TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputLeftSignal)),
+                    TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputRightSignal))
+                )
+            );
+
+            return Interface;
+        }
+
+        static const FNodeClassMetadata& GetNodeInfo()
+        {
+            auto CreateNodeClassMetadata = []() -> FNodeClassMetadata
+            {
+                FVertexInterface NodeInterface = DeclareVertexInterface();
+
+                FNodeClassMetadata Metadata;
+                Metadata.ClassName = { TEXT("UE"), TEXT("PhaseDisperserStereo"), TEXT("Audio") };
+                Metadata.MajorVersion = 1;
+                Metadata.MinorVersion = 0;
+                Metadata.DisplayName = METASOUND_LOCTEXT("PhaseDisperserStereoNodeDisplayName", "Phase Disperser (Stereo)");
+                Metadata.Description = METASOUND_LOCTEXT("PhaseDisperserStereoNodeDesc", "A stereo chain of allpass filters acting as a phase disperser, with optional decorrelation between channels.");
+                Metadata.Author = "Charles Matthews";
+                Metadata.PromptIfMissing = PluginNodeMissingPrompt;
+                Metadata.DefaultInterface = DeclareVertexInterface();
+                Metadata.CategoryHierarchy = { METASOUND_LOCTEXT("Custom", "Branches") };
+                Metadata.Keywords = TArray<FText>(); // Keywords for searching
+
+                return Metadata;
+            };
+
+            static const FNodeClassMetadata Metadata = CreateNodeClassMetadata();
+            return Metadata;
+        }
+
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace PhaseDisperserStereoNodeNames;
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputLeftSignal), InputLeftSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRightSignal), InputRightSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(NumFilters), NumFilters);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputSpread), InputSpread);
+        }
+
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace PhaseDisperserStereoNodeNames;
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), OutputLeftSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), OutputRightSignal);
+        }
+
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutErrors)
+        {
+            using namespace PhaseDisperserStereoNodeNames;
+
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
+
+            TDataReadReference<FAudioBuffer> InputLeftSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputLeftSignal), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputRightSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputRightSignal), InParams.OperatorSettings);
+            TDataReadReference<int32> NumFiltersRef = InputData.GetOrCreateDefaultDataReadReference<int32>(METASOUND_GET_PARAM_NAME(NumFilters), InParams.OperatorSettings);
+            TDataReadReference<float> InputSpread = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputSpread), InParams.OperatorSettings);
+
+            // Size the stages for the value at build time; the kernel grows if the input later rises
+            int32 ClampedNumFilters = FMath::Clamp(*NumFiltersRef, 1, MaxAllowedFilters);
+
+            return MakeUnique<FPhaseDisperserStereoOperator>(InParams.OperatorSettings, InputLeftSignal, InputRightSignal, NumFiltersRef, InputSpread, ClampedNumFilters);
+        }
+
+        virtual void Reset(const IOperator::FResetParams& InParams)
+        {
+            OutputLeftSignal->Zero();
+            OutputRightSignal->Zero();
+
+            // Clear filter memories, keeping the existing stage storage
+            Disperser.Reset();
+            UpdateSpread();
+        }
+
+        void Execute()
+        {
+            METASOUND_BRANCHES_SCOPE_EXECUTE(PhaseDisperserStereo, InputLeftSignal->Num());
+
+            if (*InputSpread != Spread)
+            {
+                UpdateSpread();
+            }
+
+            int32 NumFrames = InputLeftSignal->Num();
+            float* OutputLeftData = OutputLeftSignal->GetData();
+            float* OutputRightData = OutputRightSignal->GetData();
+
+            // Filter the output buffers in place
+            FMemory::Memcpy(OutputLeftData, InputLeftSignal->GetData(), NumFrames * sizeof(float));
+            FMemory::Memcpy(OutputRightData, InputRightSignal->GetData(), NumFrames * sizeof(float));
+
+            float* const Channels[] = { OutputLeftData, OutputRightData };
+
+            const int32 NumAllocatedFilters = Disperser.GetNumAllocatedFilters();
+            Disperser.ProcessInPlace(Channels, NumFrames, *NumFilters);
+
+            if (Disperser.GetNumAllocatedFilters() != NumAllocatedFilters)
+            {
+                UpdateTrackedMemory();
+            }
+        }
+
+    private:
+        void UpdateSpread()
+        {
+            Spread = *InputSpread;
+
+            const float Offset = FMath::Clamp(Spread, 0.0f, 1.0f) * MaxFeedbackOffset;
+            Disperser.SetChannelFeedback(0, MetasoundBranches::FPhaseDisperserKernel::Feedback - Offset);
+            Disperser.SetChannelFeedback(1, MetasoundBranches::FPhaseDisperserKernel::Feedback + Offset);
+        }
+
+        void UpdateTrackedMemory()
+        {
+            const int64 Bytes = static_cast<int64>(sizeof(*this) + Disperser.GetAllocatedSize());
+            METASOUND_BRANCHES_TRACK_MEMORY(PhaseDisperserStereo, Bytes - TrackedBytes);
+            TrackedBytes = Bytes;
+        }
+
+        // Inputs
+        FAudioBufferReadRef InputLeftSignal;
+        FAudioBufferReadRef InputRightSignal;
+        FInt32ReadRef NumFilters;
+        FFloatReadRef InputSpread;
+
+        // Outputs
+        FAudioBufferWriteRef OutputLeftSignal;
+        FAudioBufferWriteRef OutputRightSignal;
+
+        // Allpass filters for both channels
+        MetasoundBranches::FMultichannelPhaseDisperserKernel Disperser;
+
+        // Spread the channel coefficients were set from
+        float Spread = 0.0f;
+
+        // Instance size last reported to the node stats
+        int64 TrackedBytes = 0;
+    };
+
+    class FPhaseDisperserStereoNode : public FNodeFacade
+    {
+    public:
+        FPhaseDisperserStereoNode(const FNodeInitData& InitData)
+            : FNodeFacade(InitData.InstanceName, InitData.InstanceID, TFacadeOperatorClass<FPhaseDisperserStereoOperator>())
+        {
+        }
+    };
+
+    METASOUND_REGISTER_NODE(FPhaseDisperserStereoNode);
+    METASOUND_BRANCHES_LIST_NODE(FPhaseDisperserStereoNode);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -1,11 +1,14 @@
 // Copyright 2025 Charles Matthews. All Rights Reserved.
 
 #include "MetasoundBranches/Public/MetasoundShiftRegisterNode.h"
+#include "MetasoundBranches/Public/DSP/ShiftRegisterKernel.h"
 #include "MetasoundExecutableOperator.h"     // TExecutableOperator class
 #include "MetasoundPrimitives.h"             // ReadRef and WriteRef descriptions for bool, int32, float, and string
 #include "MetasoundNodeRegistrationMacro.h"  // METASOUND_LOCTEXT and METASOUND_REGISTER_NODE macros
 #include "MetasoundFacade.h"                 // FNodeFacade class, eliminates the need for a fair amount of boilerplate code
 #include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_ShiftRegisterNode"
 
@@ -26,6 +29,8 @@ namespace Metasound
         METASOUND_PARAM(OutputSignal8, "Stage 8", "Shifted output at stage 8.");
     }
 
+    METASOUND_BRANCHES_DECLARE_NODE_STATS(ShiftRegister, "Shift Register")
+
     class FShiftRegisterOperator : public TExecutableOperator<FShiftRegisterOperator>
     {
     public:
@@ -44,14 +49,7 @@ namespace Metasound
             , OutputSignal6(FFloatWriteRef::CreateNew(0.0f))
             , OutputSignal7(FFloatWriteRef::CreateNew(0.0f))
             , OutputSignal8(FFloatWriteRef::CreateNew(0.0f))
-            , ShiftedValue1(0.0f)
-            , ShiftedValue2(0.0f)
-            , ShiftedValue3(0.0f)
-            , ShiftedValue4(0.0f)
-            , ShiftedValue5(0.0f)
-            , ShiftedValue6(0.0f)
-            , ShiftedValue7(0.0f)
-            , ShiftedValue8(0.0f)
+            , NumFramesPerBlock(InSettings.GetNumFramesPerBlock())
         {
         }
 
@@ -106,35 +104,27 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace ShiftRegisterNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
-
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTrigger), InputTrigger);
-
-            return InputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTrigger), InputTrigger);
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace ShiftRegisterNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-            
-            OutputDataReferences.AddDataWriteReference(METASOUND_GET_PARAM_NAME(OutputTrigger), OutputTrigger);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal1), OutputSignal1);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal2), OutputSignal2);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal3), OutputSignal3);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal4), OutputSignal4);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal5), OutputSignal5);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal6), OutputSignal6);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal7), OutputSignal7);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal8), OutputSignal8);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTrigger), OutputTrigger);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal1), OutputSignal1);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal2), OutputSignal2);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal3), OutputSignal3);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal4), OutputSignal4);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal5), OutputSignal5);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal6), OutputSignal6);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal7), OutputSignal7);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal8), OutputSignal8);
         }
 
         static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutErrors)
@@ -154,8 +144,26 @@ namespace Metasound
             );
         }
 
+        virtual void Reset(const IOperator::FResetParams& InParams)
+        {
+            OutputTrigger->Reset();
+
+            Register.Reset();
+
+            *OutputSignal1 = 0.0f;
+            *OutputSignal2 = 0.0f;
+            *OutputSignal3 = 0.0f;
+            *OutputSignal4 = 0.0f;
+            *OutputSignal5 = 0.0f;
+            *OutputSignal6 = 0.0f;
+            *OutputSignal7 = 0.0f;
+            *OutputSignal8 = 0.0f;
+        }
+
         void Execute()
         {
+            METASOUND_BRANCHES_SCOPE_EXECUTE(ShiftRegister, NumFramesPerBlock);
+
             OutputTrigger->AdvanceBlock();
             
             InputTrigger->ExecuteBlock(
@@ -168,14 +176,9 @@ namespace Metasound
                 // On-trigger lambda (called for each trigger event)
                 [&](int32 StartFrame, int32 EndFrame)
                 {
-                    ShiftedValue8 = ShiftedValue7;
-                    ShiftedValue7 = ShiftedValue6;
-                    ShiftedValue6 = ShiftedValue5;
-                    ShiftedValue5 = ShiftedValue4;
-                    ShiftedValue4 = ShiftedValue3;
-                    ShiftedValue3 = ShiftedValue2;
-                    ShiftedValue2 = ShiftedValue1;
-                    ShiftedValue1 = *InputSignal;
+                    // The input is a block-rate float, so every trigger within one block samples the same value.
+                    // Patches that clock faster than the block rate will see repeated stages.
+                    Register.Shift(*InputSignal);
                     
                     // Trigger after the shift
                     OutputTrigger->TriggerFrame(StartFrame); 
@@ -183,14 +186,16 @@ namespace Metasound
             );
 
             // Update outputs
-            *OutputSignal1 = ShiftedValue1;
-            *OutputSignal2 = ShiftedValue2;
-            *OutputSignal3 = ShiftedValue3;
-            *OutputSignal4 = ShiftedValue4;
-            *OutputSignal5 = ShiftedValue5;
-            *OutputSignal6 = ShiftedValue6;
-            *OutputSignal7 = ShiftedValue7;
-            *OutputSignal8 = ShiftedValue8;
+            *OutputSignal1 = Register.GetStage(0);
+            *OutputSignal2 = Register.GetStage(1);
+            *OutputSignal3 = Register.GetStage(2);
+            *OutputSignal4 = Register.GetStage(3);
+            *OutputSignal5 = Register.GetStage(4);
+            *OutputSignal6 = Register.GetStage(5);
+            *OutputSignal7 = Register.GetStage(6);
+            *OutputSignal8 = Register.GetStage(7);
+
+            METASOUND_BRANCHES_COUNT_TRIGGERS(ShiftRegister, OutputTrigger->NumTriggeredInBlock());
         }
 
     private:
@@ -207,14 +212,10 @@ namespace Metasound
         FFloatWriteRef OutputSignal7;
         FFloatWriteRef OutputSignal8;
 
-        float ShiftedValue1;
-        float ShiftedValue2;
-        float ShiftedValue3;
-        float ShiftedValue4;
-        float ShiftedValue5;
-        float ShiftedValue6;
-        float ShiftedValue7;
-        float ShiftedValue8;
+        MetasoundBranches::FShiftRegisterKernel Register;
+
+        // Frames in each block, for the node stats
+        int32 NumFramesPerBlock;
     };
 
     class FShiftRegisterNode : public FNodeFacade
@@ -227,6 +228,7 @@ namespace Metasound
     };
 
     METASOUND_REGISTER_NODE(FShiftRegisterNode);
+    METASOUND_BRANCHES_LIST_NODE(FShiftRegisterNode);
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -1,11 +1,16 @@
 // Copyright 2025 Charles Matthews. All Rights Reserved.
 
 #include "MetasoundBranches/Public/MetasoundSlewFloatNode.h"
+#include "MetasoundBranches/Public/DSP/SlewKernel.h"
 #include "MetasoundExecutableOperator.h"
 #include "MetasoundPrimitives.h"
+#include "MetasoundAudioBuffer.h"
 #include "MetasoundNodeRegistrationMacro.h"
 #include "MetasoundFacade.h"
 #include "MetasoundParamHelper.h"
+#include "MetasoundTrigger.h"
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundSlewNode"
 
@@ -17,10 +22,16 @@ namespace Metasound
         METASOUND_PARAM(InputSignal, "In", "Value to smooth.");
         METASOUND_PARAM(InputRiseTime, "Rise Time", "Rise time in seconds.");
         METASOUND_PARAM(InputFallTime, "Fall Time", "Fall time in seconds.");
+        METASOUND_PARAM(InputLinear, "Linear", "Move at a constant rate, taking the rise or fall time to change by 1.0, instead of smoothing exponentially.");
+        METASOUND_PARAM(InputAudioRate, "Audio Rate", "Render the slew sample by sample to Out Audio. When off, Out Audio is silent and the node does no per-sample work.");
 
         METASOUND_PARAM(OutputSignal, "Out", "Slew rate limited float.");
+        METASOUND_PARAM(OutputAudio, "Out Audio", "The same slew at audio rate, following the curve sample by sample through each block. Needs Audio Rate.");
+        METASOUND_PARAM(OutputReached, "Reached", "Triggers on the sample a linear slew arrives at its target.");
     }
 
+    METASOUND_BRANCHES_DECLARE_NODE_STATS(SlewFloat, "Slew (Float)")
+
     // Operator Class - defines the way the node is described, created, and executed
     class FSlewFloatOperator : public TExecutableOperator<FSlewFloatOperator>
     {
@@ -31,13 +42,19 @@ namespace Metasound
             const FFloatReadRef& InSignal,
             const FTimeReadRef& InRiseTime,
             const FTimeReadRef& InFallTime,
-            int32 InSampleRate)
+            const FBoolReadRef& InLinear,
+            const FBoolReadRef& InAudioRate,
+            float InSampleRate)
             : InputSignal(InSignal)
             , InputRiseTime(InRiseTime)
             , InputFallTime(InFallTime)
+            , InputLinear(InLinear)
+            , InputAudioRate(InAudioRate)
             , OutputSignal(FFloatWriteRef::CreateNew(0.0f))
-            , PreviousOutputSample(0.0f)
+            , OutputAudio(FAudioBufferWriteRef::CreateNew(InSettings))
+            , OutputReached(FTriggerWriteRef::CreateNew(InSettings))
             , SampleRate(InSampleRate)
+            , BlockSeconds(InSettings.GetNumFramesPerBlock() / InSampleRate)
         {
         }
 
@@ -50,10 +67,14 @@ namespace Metasound
                 FInputVertexInterface(
                     TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSignal)),
                     TInputDataVertex<FTime>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRiseTime)),
-                    TInputDataVertex<FTime>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputFallTime))
+                    TInputDataVertex<FTime>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputFallTime)),
+                    TInputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLinear), false),
+                    TInputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputAudioRate), false)
                 ),
                 FOutputVertexInterface(
-                    TOutputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputSignal))
+                    TOutputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputSignal)),
+                    TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputAudio)),
+                    TOutputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputReached))
                 )
             );
 
@@ -68,7 +89,7 @@ namespace Metasound
                 FNodeClassMetadata Metadata;
                 Metadata.ClassName = { TEXT("UE"), TEXT("Slew (Float)"), TEXT("Float") };
                 Metadata.MajorVersion = 1;
-                Metadata.MinorVersion = 0;
+                Metadata.MinorVersion = 2;
                 Metadata.DisplayName = METASOUND_LOCTEXT("SlewFloatDisplayName", "Slew (Float)");
                 Metadata.Description = METASOUND_LOCTEXT("SlewFloatDesc", "Smooth the rise and fall times of an incoming float value.");
                 Metadata.Author = "Charles Matthews";
@@ -85,27 +106,25 @@ namespace Metasound
         }
 
         // Input Data References
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace SlewFloatNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputRiseTime), InputRiseTime);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputFallTime), InputFallTime);
-
-            return InputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRiseTime), InputRiseTime);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputFallTime), InputFallTime);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputLinear), InputLinear);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputAudioRate), InputAudioRate);
         }
 
         // Output Data References
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace SlewFloatNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal), OutputSignal);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal), OutputSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputAudio), OutputAudio);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputReached), OutputReached);
         }
 
         // Operator Factory Method
@@ -132,41 +151,109 @@ namespace Metasound
                 InParams.OperatorSettings
             );
 
-            int32 SampleRate = InParams.OperatorSettings.GetActualBlockRate(); // For float processing, use block rate
+            TDataReadReference<bool> InputLinear = InputData.GetOrCreateDefaultDataReadReference<bool>(
+                METASOUND_GET_PARAM_NAME(InputLinear),
+                InParams.OperatorSettings
+            );
 
-            return MakeUnique<FSlewFloatOperator>(InParams.OperatorSettings, InputSignal, InputRiseTime, InputFallTime, SampleRate);
+            TDataReadReference<bool> InputAudioRate = InputData.GetOrCreateDefaultDataReadReference<bool>(
+                METASOUND_GET_PARAM_NAME(InputAudioRate),
+                InParams.OperatorSettings
+            );
+
+            float SampleRate = InParams.OperatorSettings.GetSampleRate();
+
+            return MakeUnique<FSlewFloatOperator>(InParams.OperatorSettings, InputSignal, InputRiseTime, InputFallTime, InputLinear, InputAudioRate, SampleRate);
+        }
+
+        // Reset filter state
+        virtual void Reset(const IOperator::FResetParams& InParams)
+        {
+            *OutputSignal = 0.0f;
+            OutputAudio->Zero();
+            OutputReached->Reset();
+            Slew.Reset();
+            LinearSlew.Reset();
+            bWasLinear = false;
+            bAudioWritten = false;
         }
 
         // Primary node functionality
         virtual void Execute()
         {
+            METASOUND_BRANCHES_SCOPE_EXECUTE(SlewFloat, OutputAudio->Num());
+
+            OutputReached->AdvanceBlock();
+
             float SignalSample = *InputSignal;
 
             float RiseTimeSeconds = InputRiseTime->GetSeconds();
             float FallTimeSeconds = InputFallTime->GetSeconds();
 
-            // Calculate alpha values based on rise and fall times
-            // Alpha = exp(-1 / (time * sample rate))
-            float RiseAlpha = (RiseTimeSeconds > 0.0f) ? FMath::Exp(-1.0f / (RiseTimeSeconds * SampleRate)) : 0.0f;
-            float FallAlpha = (FallTimeSeconds > 0.0f) ? FMath::Exp(-1.0f / (FallTimeSeconds * SampleRate)) : 0.0f;
+            const bool bLinear = *InputLinear;
+
+            // Carry the output across a change of mode so it doesn't jump
+            if (bLinear != bWasLinear)
+            {
+                if (bLinear)
+                {
+                    LinearSlew.Reset(Slew.GetValue());
+                }
+                else
+                {
+                    Slew.Reset(LinearSlew.GetValue());
+                }
+                bWasLinear = bLinear;
+            }
 
-            float OutputSample = PreviousOutputSample;
+            // Both outputs move the slew on by the length of the block at the audio sample rate, so the float
+            // output lands on the last sample of the audio output and doesn't depend on the block size.
+            // Without Audio Rate the block is never rendered: the float output is worked out for the end of it.
+            float* AudioData = OutputAudio->GetData();
+            const int32 NumFrames = OutputAudio->Num();
+            const bool bAudioRate = *InputAudioRate;
 
-            if (SignalSample > PreviousOutputSample)
+            if (!bAudioRate && bAudioWritten)
             {
-                OutputSample = RiseAlpha * PreviousOutputSample + (1.0f - RiseAlpha) * SignalSample;
+                OutputAudio->Zero();
+                bAudioWritten = false;
             }
-            else if (SignalSample < PreviousOutputSample)
+
+            if (bLinear)
             {
-                OutputSample = FallAlpha * PreviousOutputSample + (1.0f - FallAlpha) * SignalSample;
+                const float RiseStep = MetasoundBranches::FLinearSlewKernel::GetStep(RiseTimeSeconds, SampleRate);
+                const float FallStep = MetasoundBranches::FLinearSlewKernel::GetStep(FallTimeSeconds, SampleRate);
+
+                // The linear curve is already closed form, so its last sample is the analytic value
+                const int32 ReachedFrame = bAudioRate
+                    ? LinearSlew.ProcessConstant(SignalSample, AudioData, NumFrames, RiseStep, FallStep)
+                    : LinearSlew.AdvanceConstant(SignalSample, NumFrames, RiseStep, FallStep);
+                bAudioWritten = bAudioRate;
+
+                if (ReachedFrame != INDEX_NONE)
+                {
+                    OutputReached->TriggerFrame(ReachedFrame);
+                }
+
+                *OutputSignal = LinearSlew.GetValue();
+
+                METASOUND_BRANCHES_COUNT_TRIGGERS(SlewFloat, OutputReached->NumTriggeredInBlock());
+                return;
             }
-            else
+
+            // The exponential curve is rendered from a copy, and the state jumps straight to the end of the block
+            if (bAudioRate)
             {
-                OutputSample = SignalSample;
+                // Calculate alpha values based on rise and fall times
+                float RiseAlpha = MetasoundBranches::FSlewKernel::GetAlpha(RiseTimeSeconds, SampleRate);
+                float FallAlpha = MetasoundBranches::FSlewKernel::GetAlpha(FallTimeSeconds, SampleRate);
+
+                MetasoundBranches::FSlewKernel Curve = Slew;
+                Curve.ProcessConstant(SignalSample, AudioData, NumFrames, RiseAlpha, FallAlpha);
+                bAudioWritten = true;
             }
 
-            *OutputSignal = OutputSample;
-            PreviousOutputSample = OutputSample;
+            *OutputSignal = Slew.ProcessElapsed(SignalSample, BlockSeconds, RiseTimeSeconds, FallTimeSeconds);
         }
 
     private:
@@ -174,15 +261,25 @@ namespace Metasound
         FFloatReadRef InputSignal;
         FTimeReadRef InputRiseTime;
         FTimeReadRef InputFallTime;
+        FBoolReadRef InputLinear;
+        FBoolReadRef InputAudioRate;
 
-        // Output Reference
+        // Output References
         FFloatWriteRef OutputSignal;
+        FAudioBufferWriteRef OutputAudio;
+        FTriggerWriteRef OutputReached;
+
+        // Filter state for each mode
+        MetasoundBranches::FSlewKernel Slew;
+        MetasoundBranches::FLinearSlewKernel LinearSlew;
+        bool bWasLinear = false;
 
-        // State Variable
-        float PreviousOutputSample;
+        // Whether Out Audio holds a rendered block that needs clearing once Audio Rate is switched off
+        bool bAudioWritten = false;
 
-        // Sample Rate
-        int32 SampleRate;
+        // Sample rate, and the time each block moves the slew on by
+        float SampleRate;
+        float BlockSeconds;
     };
 
     // Node Facade Class
@@ -197,6 +294,7 @@ namespace Metasound
 
     // Register the Node
     METASOUND_REGISTER_NODE(FSlewFloatNode);
+    METASOUND_BRANCHES_LIST_NODE(FSlewFloatNode);
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -1,11 +1,15 @@
 // Copyright 2025 Charles Matthews. All Rights Reserved.
 
 #include "MetasoundBranches/Public/MetasoundSlewNode.h"
+#include "MetasoundBranches/Public/DSP/SlewKernel.h"
 #include "MetasoundExecutableOperator.h"
 #include "MetasoundPrimitives.h"
 #include "MetasoundNodeRegistrationMacro.h"
 #include "MetasoundFacade.h"
 #include "MetasoundParamHelper.h"
+#include "MetasoundTrigger.h"
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundSlewNode"
 
@@ -17,10 +21,14 @@ namespace Metasound
         METASOUND_PARAM(InputSignal, "In", "Audio signal to smooth.");
         METASOUND_PARAM(InputRiseTime, "Rise Time", "Rise time in seconds.");
         METASOUND_PARAM(InputFallTime, "Fall Time", "Fall time in seconds.");
+        METASOUND_PARAM(InputLinear, "Linear", "Move at a constant rate, taking the rise or fall time to change by 1.0, instead of smoothing exponentially.");
 
         METASOUND_PARAM(OutputSignal, "Out", "Slew rate limited signal.");
+        METASOUND_PARAM(OutputReached, "Reached", "Triggers on the sample a linear slew arrives at its target.");
     }
 
+    METASOUND_BRANCHES_DECLARE_NODE_STATS(SlewAudio, "Slew (Audio)")
+
     // Operator Class - defines the way the node is described, created, and executed
     class FSlewOperator : public TExecutableOperator<FSlewOperator>
     {
@@ -31,12 +39,14 @@ namespace Metasound
             const FAudioBufferReadRef& InSignal,
             const FTimeReadRef& InRiseTime,
             const FTimeReadRef& InFallTime,
+            const FBoolReadRef& InLinear,
             int32 InSampleRate)
             : InputSignal(InSignal)
             , InputRiseTime(InRiseTime)
             , InputFallTime(InFallTime)
+            , InputLinear(InLinear)
             , OutputSignal(FAudioBufferWriteRef::CreateNew(InSettings))
-            , PreviousOutputSample(0.0f)
+            , OutputReached(FTriggerWriteRef::CreateNew(InSettings))
             , SampleRate(InSampleRate)
         {
         }
@@ -50,10 +60,12 @@ namespace Metasound
                 FInputVertexInterface(
                     TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSignal)),
                     TInputDataVertex<FTime>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRiseTime)),
-                    TInputDataVertex<FTime>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputFallTime))
+                    TInputDataVertex<FTime>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputFallTime)),
+                    TInputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLinear), false)
                 ),
                 FOutputVertexInterface(
-                    TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputSignal))
+                    TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputSignal)),
+                    TOutputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputReached))
                 )
             );
 
@@ -68,7 +80,7 @@ namespace Metasound
                 FNodeClassMetadata Metadata;
                 Metadata.ClassName = { TEXT("UE"), TEXT("Slew (Audio)"), TEXT("Audio") };
                 Metadata.MajorVersion = 1;
-                Metadata.MinorVersion = 0;
+                Metadata.MinorVersion = 1;
                 Metadata.DisplayName = METASOUND_LOCTEXT("SlewDisplayName", "Slew (Audio)");
                 Metadata.Description = METASOUND_LOCTEXT("SlewDesc", "Smooth the rise and fall times of an incoming signal.");
                 Metadata.Author = "Charles Matthews";
@@ -85,27 +97,23 @@ namespace Metasound
         }
 
         // Input Data References
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace SlewNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputRiseTime), InputRiseTime);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputFallTime), InputFallTime);
-
-            return InputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRiseTime), InputRiseTime);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputFallTime), InputFallTime);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputLinear), InputLinear);
         }
 
         // Output Data References
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace SlewNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal), OutputSignal);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal), OutputSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputReached), OutputReached);
         }
 
         // Operator Factory Method
@@ -132,14 +140,33 @@ namespace Metasound
                 InParams.OperatorSettings
             );
 
+            TDataReadReference<bool> InputLinear = InputData.GetOrCreateDefaultDataReadReference<bool>(
+                METASOUND_GET_PARAM_NAME(InputLinear),
+                InParams.OperatorSettings
+            );
+
             int32 SampleRate = InParams.OperatorSettings.GetSampleRate();
 
-            return MakeUnique<FSlewOperator>(InParams.OperatorSettings, InputSignal, InputRiseTime, InputFallTime, SampleRate);
+            return MakeUnique<FSlewOperator>(InParams.OperatorSettings, InputSignal, InputRiseTime, InputFallTime, InputLinear, SampleRate);
+        }
+
+        // Reset filter state
+        virtual void Reset(const IOperator::FResetParams& InParams)
+        {
+            OutputSignal->Zero();
+            OutputReached->Reset();
+            Slew.Reset();
+            LinearSlew.Reset();
+            bWasLinear = false;
         }
 
         // Primary node functionality
         virtual void Execute()
         {
+            METASOUND_BRANCHES_SCOPE_EXECUTE(SlewAudio, InputSignal->Num());
+
+            OutputReached->AdvanceBlock();
+
             int32 NumFrames = InputSignal->Num();
 
             const float* SignalData = InputSignal->GetData();
@@ -148,32 +175,39 @@ namespace Metasound
             float RiseTimeSeconds = InputRiseTime->GetSeconds();
             float FallTimeSeconds = InputFallTime->GetSeconds();
 
-            // Calculate alpha values based on rise and fall times
-            // Alpha = exp(-1 / (time * sample rate))
-            float RiseAlpha = (RiseTimeSeconds > 0.0f) ? FMath::Exp(-1.0f / (RiseTimeSeconds * SampleRate)) : 0.0f;
-            float FallAlpha = (FallTimeSeconds > 0.0f) ? FMath::Exp(-1.0f / (FallTimeSeconds * SampleRate)) : 0.0f;
+            const bool bLinear = *InputLinear;
 
-            for (int32 i = 0; i < NumFrames; ++i)
+            // Carry the output across a change of mode so it doesn't jump
+            if (bLinear != bWasLinear)
             {
-                float SignalSample = SignalData[i];
-                float OutputSample = PreviousOutputSample;
-
-                if (SignalSample > PreviousOutputSample)
-                {
-                    OutputSample = RiseAlpha * PreviousOutputSample + (1.0f - RiseAlpha) * SignalSample;
-                }
-                else if (SignalSample < PreviousOutputSample)
+                if (bLinear)
                 {
-                    OutputSample = FallAlpha * PreviousOutputSample + (1.0f - FallAlpha) * SignalSample;
+                    LinearSlew.Reset(Slew.GetValue());
                 }
                 else
                 {
-                    OutputSample = SignalSample;
+                    Slew.Reset(LinearSlew.GetValue());
                 }
+                bWasLinear = bLinear;
+            }
 
-                OutputDataPtr[i] = OutputSample;
-                PreviousOutputSample = OutputSample;
+            if (bLinear)
+            {
+                const float RiseStep = MetasoundBranches::FLinearSlewKernel::GetStep(RiseTimeSeconds, SampleRate);
+                const float FallStep = MetasoundBranches::FLinearSlewKernel::GetStep(FallTimeSeconds, SampleRate);
+
+                LinearSlew.ProcessBuffer(SignalData, OutputDataPtr, NumFrames, RiseStep, FallStep,
+                    [this](int32 Frame) { OutputReached->TriggerFrame(Frame); });
+
+                METASOUND_BRANCHES_COUNT_TRIGGERS(SlewAudio, OutputReached->NumTriggeredInBlock());
+                return;
             }
+
+            // Calculate alpha values based on rise and fall times
+            float RiseAlpha = MetasoundBranches::FSlewKernel::GetAlpha(RiseTimeSeconds, SampleRate);
+            float FallAlpha = MetasoundBranches::FSlewKernel::GetAlpha(FallTimeSeconds, SampleRate);
+
+            Slew.ProcessBuffer(SignalData, OutputDataPtr, NumFrames, RiseAlpha, FallAlpha);
         }
 
     private:
@@ -181,12 +215,16 @@ namespace Metasound
         FAudioBufferReadRef InputSignal;
         FTimeReadRef InputRiseTime;
         FTimeReadRef InputFallTime;
+        FBoolReadRef InputLinear;
 
-        // Output Reference
+        // Output References
         FAudioBufferWriteRef OutputSignal;
+        FTriggerWriteRef OutputReached;
 
-        // State Variable
-        float PreviousOutputSample;
+        // Filter state for each mode
+        MetasoundBranches::FSlewKernel Slew;
+        MetasoundBranches::FLinearSlewKernel LinearSlew;
+        bool bWasLinear = false;
 
         // Sample Rate
         int32 SampleRate;
@@ -204,6 +242,7 @@ namespace Metasound
 
     // Register the Node
     METASOUND_REGISTER_NODE(FSlewNode);
+    METASOUND_BRANCHES_LIST_NODE(FSlewNode);
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -1,12 +1,16 @@
 // Copyright 2025 Charles Matthews. All Rights Reserved.
 
 #include "MetasoundBranches/Public/MetasoundStereoBalanceNode.h"
+#include "MetasoundBranches/Public/DSP/StereoKernels.h"
 #include "MetasoundExecutableOperator.h"     // TExecutableOperator class
 #include "MetasoundPrimitives.h"             // ReadRef and WriteRef descriptions for bool, int32, float, and string
 #include "MetasoundNodeRegistrationMacro.h"  // METASOUND_LOCTEXT and METASOUND_REGISTER_NODE macros
 #include "MetasoundFacade.h"                 // FNodeFacade class, eliminates the need for a fair amount of boilerplate code
 #include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
 #include "Math/UnrealMathUtility.h"          // For FMath functions
+#include "MetasoundBranches/Private/MetasoundBranchesBinding.h"
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_BalanceNode"
 
@@ -17,11 +21,14 @@ namespace Metasound
         METASOUND_PARAM(InputLeftSignal, "In L", "Left channel audio input.");
         METASOUND_PARAM(InputRightSignal, "In R", "Right channel audio input.");
         METASOUND_PARAM(InputBalance, "Balance", "Balance control ranging from -1.0 (full left) to 1.0 (full right).");
+        METASOUND_PARAM(InputBalanceModulation, "Balance Mod", "Audio-rate modulation added to Balance.");
 
         METASOUND_PARAM(OutputLeftSignal, "Out L", "Left output channel.");
         METASOUND_PARAM(OutputRightSignal, "Out R", "Right output channel.");
     }
 
+    METASOUND_BRANCHES_DECLARE_NODE_STATS(StereoBalance, "Stereo Balance")
+
     class FBalanceOperator : public TExecutableOperator<FBalanceOperator>
     {
     public:
@@ -29,13 +36,20 @@ namespace Metasound
             const FOperatorSettings& InSettings,
             const FAudioBufferReadRef& InLeftSignal,
             const FAudioBufferReadRef& InRightSignal,
-            const FFloatReadRef& InBalance)
+            const FFloatReadRef& InBalance,
+            const FAudioBufferReadRef& InBalanceModulation,
+            bool bInIsModulated,
+            bool bInBalanceIsConstant)
             : InputLeftSignal(InLeftSignal)
             , InputRightSignal(InRightSignal)
             , InputBalance(InBalance)
+            , InputBalanceModulation(InBalanceModulation)
+            , bIsModulated(bInIsModulated)
             , OutputLeftSignal(FAudioBufferWriteRef::CreateNew(InSettings))
             , OutputRightSignal(FAudioBufferWriteRef::CreateNew(InSettings))
+            , bBalanceIsConstant(bInBalanceIsConstant)
         {
+            UpdateGains();
         }
 
         static const FVertexInterface& DeclareVertexInterface()
@@ -46,7 +60,8 @@ namespace Metasound
                 FInputVertexInterface(
                     TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal)),
                     TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal)),
-                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputBalance), 0.0f) // Default balance is centered
+                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputBalance), 0.0f), // Default balance is centered
+                    TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputBalanceModulation))
                 ),
                 FOutputVertexInterface(
                     TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputLeftSignal)),
@@ -67,7 +82,7 @@ namespace Metasound
     
                     Metadata.ClassName = { TEXT("UE"), TEXT("Stereo Balance"), TEXT("Audio") };
                     Metadata.MajorVersion = 1;
-                    Metadata.MinorVersion = 0;
+                    Metadata.MinorVersion = 1;
                     Metadata.DisplayName = METASOUND_LOCTEXT("StereoGainNodeDisplayName", "Stereo Balance");
                     Metadata.Description = METASOUND_LOCTEXT("StereoGainNodeDesc", "Adjusts the balance of a stereo signal.");
                     Metadata.Author = "Charles Matthews";
@@ -83,29 +98,28 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace BalanceNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
+            // A rebind can connect or disconnect the modulation, so check before taking the new references
+            bIsModulated = MetasoundBranches::IsConnectedInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputBalanceModulation), InputBalanceModulation, bIsModulated);
+            bBalanceIsConstant = MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputBalance), InputBalance, bBalanceIsConstant);
 
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputLeftSignal), InputLeftSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputRightSignal), InputRightSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputBalance), InputBalance);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputLeftSignal), InputLeftSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRightSignal), InputRightSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputBalance), InputBalance);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputBalanceModulation), InputBalanceModulation);
 
-            return InputDataReferences;
+            UpdateGains();
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace BalanceNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputLeftSignal), OutputLeftSignal);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputRightSignal), OutputRightSignal);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), OutputLeftSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), OutputRightSignal);
         }
 
         static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutErrors)
@@ -118,12 +132,27 @@ namespace Metasound
             TDataReadReference<FAudioBuffer> InputLeftSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputLeftSignal), InParams.OperatorSettings);
             TDataReadReference<FAudioBuffer> InputRightSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputRightSignal), InParams.OperatorSettings);
             TDataReadReference<float> InputBalance = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputBalance), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputBalanceModulation = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputBalanceModulation), InParams.OperatorSettings);
+
+            // Per-sample gains are only worth computing when something drives the modulation input
+            const bool bIsModulated = MetasoundBranches::IsConnectedInput(InputData, METASOUND_GET_PARAM_NAME(InputBalanceModulation));
+
+            // A literal balance only needs its sin/cos once
+            const bool bBalanceIsConstant = MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputBalance));
 
-            return MakeUnique<FBalanceOperator>(InParams.OperatorSettings, InputLeftSignal, InputRightSignal, InputBalance);
+            return MakeUnique<FBalanceOperator>(InParams.OperatorSettings, InputLeftSignal, InputRightSignal, InputBalance, InputBalanceModulation, bIsModulated, bBalanceIsConstant);
+        }
+
+        virtual void Reset(const IOperator::FResetParams& InParams)
+        {
+            OutputLeftSignal->Zero();
+            OutputRightSignal->Zero();
         }
 
     void Execute()
     {
+        METASOUND_BRANCHES_SCOPE_EXECUTE(StereoBalance, InputLeftSignal->Num());
+
         int32 NumFrames = InputLeftSignal->Num();
 
         const float* LeftData = InputLeftSignal->GetData();
@@ -131,30 +160,45 @@ namespace Metasound
         float* OutputLeftData = OutputLeftSignal->GetData();
         float* OutputRightData = OutputRightSignal->GetData();
 
-        float Balance = FMath::Clamp(*InputBalance, -1.0f, 1.0f);
-
-        float Angle = (Balance + 1.0f) * (PI / 4.0f);
-
-        float LeftGain = FMath::Cos(Angle);
-        float RightGain = FMath::Sin(Angle);
-
-        for (int32 i = 0; i < NumFrames; ++i)
+        if (bIsModulated)
+        {
+            MetasoundBranches::ProcessStereoBalanceModulated(LeftData, RightData, InputBalanceModulation->GetData(), OutputLeftData, OutputRightData, NumFrames, *InputBalance);
+        }
+        else if (bBalanceIsConstant)
+        {
+            MetasoundBranches::ProcessStereoBalanceGains(LeftData, RightData, OutputLeftData, OutputRightData, NumFrames, LeftGain, RightGain);
+        }
+        else
         {
-            OutputLeftData[i] = LeftData[i] * LeftGain;
-            OutputRightData[i] = RightData[i] * RightGain;
+            MetasoundBranches::ProcessStereoBalance(LeftData, RightData, OutputLeftData, OutputRightData, NumFrames, *InputBalance);
         }
     }
 
     private:
+        void UpdateGains()
+        {
+            if (bBalanceIsConstant)
+            {
+                MetasoundBranches::GetBalanceGains(*InputBalance, LeftGain, RightGain);
+            }
+        }
 
         // Inputs
         FAudioBufferReadRef InputLeftSignal;
         FAudioBufferReadRef InputRightSignal;
         FFloatReadRef InputBalance;
+        FAudioBufferReadRef InputBalanceModulation;
 
         // Outputs
         FAudioBufferWriteRef OutputLeftSignal;
         FAudioBufferWriteRef OutputRightSignal;
+
+        bool bIsModulated = false;
+
+        // Balance can't change, so its gains are worked out once in UpdateGains
+        bool bBalanceIsConstant = false;
+        float LeftGain = 1.0f;
+        float RightGain = 1.0f;
     };
 
     class FBalanceNode : public FNodeFacade
@@ -167,6 +211,7 @@ namespace Metasound
     };
 
     METASOUND_REGISTER_NODE(FBalanceNode);
+    METASOUND_BRANCHES_LIST_NODE(FBalanceNode);
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -1,11 +1,15 @@
 // Copyright 2025 Charles Matthews. All Rights Reserved.
 
 #include "MetasoundBranches/Public/MetasoundStereoGainNode.h"
+#include "MetasoundBranches/Public/DSP/StereoKernels.h"
 #include "MetasoundExecutableOperator.h"     // TExecutableOperator class
 #include "MetasoundPrimitives.h"             // ReadRef and WriteRef descriptions for bool, int32, float, and string
 #include "MetasoundNodeRegistrationMacro.h"  // METASOUND_LOCTEXT and METASOUND_REGISTER_NODE macros
 #include "MetasoundFacade.h"                 // FNodeFacade class
 #include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "MetasoundBranches/Private/MetasoundBranchesBinding.h"
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_StereoGain"
 
@@ -21,6 +25,8 @@ namespace Metasound
         METASOUND_PARAM(OutputRightSignal, "Out R", "Right output channel.");
     }
 
+    METASOUND_BRANCHES_DECLARE_NODE_STATS(StereoGain, "Stereo Gain")
+
     class FStereoGainOperator : public TExecutableOperator<FStereoGainOperator>
     {
     public:
@@ -28,13 +34,16 @@ namespace Metasound
             const FOperatorSettings& InSettings,
             const FAudioBufferReadRef& InLeftSignal,
             const FAudioBufferReadRef& InRightSignal,
-            const FFloatReadRef& InGain)
+            const FFloatReadRef& InGain,
+            bool bInGainIsConstant)
             : InputLeftSignal(InLeftSignal)
             , InputRightSignal(InRightSignal)
             , InputGain(InGain)
             , OutputLeftSignal(FAudioBufferWriteRef::CreateNew(InSettings))
             , OutputRightSignal(FAudioBufferWriteRef::CreateNew(InSettings))
+            , bGainIsConstant(bInGainIsConstant)
         {
+            UpdatePassthrough();
         }
 
         static const FVertexInterface& DeclareVertexInterface()
@@ -81,26 +90,35 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace StereoGainNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputLeftSignal), InputLeftSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputRightSignal), InputRightSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputGain), InputGain);
+            // Check before binding, while the vertex data still shows what the graph connected
+            bGainIsConstant = MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputGain), InputGain, bGainIsConstant);
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputLeftSignal), InputLeftSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRightSignal), InputRightSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputGain), InputGain);
 
-            return InputDataReferences;
+            UpdatePassthrough();
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace StereoGainNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputLeftSignal), OutputLeftSignal);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputRightSignal), OutputRightSignal);
-            return OutputDataReferences;
+            if (bPassthrough)
+            {
+                // Unity gain: the outputs are the input buffers
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), InputLeftSignal);
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), InputRightSignal);
+            }
+            else
+            {
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), OutputLeftSignal);
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), OutputRightSignal);
+            }
         }
 
         static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutErrors)
@@ -114,11 +132,27 @@ namespace Metasound
             TDataReadReference<FAudioBuffer> InputRightSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputRightSignal), InParams.OperatorSettings);
             TDataReadReference<float> Gain = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputGain), InParams.OperatorSettings);
 
-            return MakeUnique<FStereoGainOperator>(InParams.OperatorSettings, InputLeftSignal, InputRightSignal, Gain);
+            const bool bGainIsConstant = MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputGain));
+
+            return MakeUnique<FStereoGainOperator>(InParams.OperatorSettings, InputLeftSignal, InputRightSignal, Gain, bGainIsConstant);
+        }
+
+        virtual void Reset(const IOperator::FResetParams& InParams)
+        {
+            OutputLeftSignal->Zero();
+            OutputRightSignal->Zero();
         }
 
         void Execute()
         {
+            METASOUND_BRANCHES_SCOPE_EXECUTE(StereoGain, InputLeftSignal->Num());
+
+            if (bPassthrough || bSilent)
+            {
+                METASOUND_BRANCHES_COUNT_SHORT_CIRCUIT(StereoGain);
+                return;
+            }
+
             const int32 NumFrames = InputLeftSignal->Num();
 
             const float* LeftData = InputLeftSignal->GetData();
@@ -126,16 +160,25 @@ namespace Metasound
             float* OutputLeftData = OutputLeftSignal->GetData();
             float* OutputRightData = OutputRightSignal->GetData();
 
-            const float GainVal = *InputGain;
+            MetasoundBranches::ProcessStereoGain(LeftData, RightData, OutputLeftData, OutputRightData, NumFrames, *InputGain);
+        }
+
+    private:
+        void UpdatePassthrough()
+        {
+            bPassthrough = bGainIsConstant && *InputGain == 1.0f;
 
-            for (int32 i = 0; i < NumFrames; ++i)
+            // A constant zero gain leaves the outputs as they were zeroed here
+            const bool bWasSilent = bSilent;
+            bSilent = bGainIsConstant && *InputGain == 0.0f;
+
+            if (bSilent && !bWasSilent)
             {
-                OutputLeftData[i] = LeftData[i] * GainVal;
-                OutputRightData[i] = RightData[i] * GainVal;
+                OutputLeftSignal->Zero();
+                OutputRightSignal->Zero();
             }
         }
 
-    private:
         // Inputs
         FAudioBufferReadRef InputLeftSignal;
         FAudioBufferReadRef InputRightSignal;
@@ -144,6 +187,14 @@ namespace Metasound
         // Outputs
         FAudioBufferWriteRef OutputLeftSignal;
         FAudioBufferWriteRef OutputRightSignal;
+
+        bool bGainIsConstant = false;
+
+        // Gain is a constant 1.0, so the outputs are bound to the inputs and there is nothing to process
+        bool bPassthrough = false;
+
+        // Gain is a constant 0.0, so the outputs stay zeroed and there is nothing to process
+        bool bSilent = false;
     };
 
     class FStereoGainNode : public FNodeFacade
@@ -156,6 +207,7 @@ namespace Metasound
     };
 
     METASOUND_REGISTER_NODE(FStereoGainNode);
+    METASOUND_BRANCHES_LIST_NODE(FStereoGainNode);
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -1,11 +1,15 @@
 // Copyright 2025 Charles Matthews. All Rights Reserved.
 
 #include "MetasoundBranches/Public/MetasoundStereoInverterNode.h"
+#include "MetasoundBranches/Public/DSP/StereoKernels.h"
 #include "MetasoundExecutableOperator.h"     // TExecutableOperator class
 #include "MetasoundPrimitives.h"             // ReadRef and WriteRef descriptions for bool, int32, float, and string
 #include "MetasoundNodeRegistrationMacro.h"  // METASOUND_LOCTEXT and METASOUND_REGISTER_NODE macros
 #include "MetasoundFacade.h"                 // FNodeFacade class
 #include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "MetasoundBranches/Private/MetasoundBranchesBinding.h"
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_StereoInverter"
 
@@ -23,16 +27,37 @@ namespace Metasound
         METASOUND_PARAM(OutputRightSignal, "Out R", "Right output channel.");
     }
 
+    METASOUND_BRANCHES_DECLARE_NODE_STATS(StereoInverter, "Stereo Inverter")
+
     class FStereoInverterOperator : public TExecutableOperator<FStereoInverterOperator>
     {
     public:
+        // With constant flags and no inversion the outputs can be bound straight to the inputs, or crossed over
+        enum class ERouting : uint8
+        {
+            Process,
+            Straight,
+            Swapped
+        };
+
+        static ERouting GetRouting(bool bInFlagsAreConstant, bool bInInvertLeft, bool bInInvertRight, bool bInSwap)
+        {
+            if (!bInFlagsAreConstant || bInInvertLeft || bInInvertRight)
+            {
+                return ERouting::Process;
+            }
+
+            return bInSwap ? ERouting::Swapped : ERouting::Straight;
+        }
+
         FStereoInverterOperator(
             const FOperatorSettings& InSettings,
             const FAudioBufferReadRef& InLeftSignal,
             const FAudioBufferReadRef& InRightSignal,
             const FBoolReadRef& InInvertLeft,
             const FBoolReadRef& InInvertRight,
-            const FBoolReadRef& InSwapChannels)
+            const FBoolReadRef& InSwapChannels,
+            bool bInFlagsAreConstant)
             : InputLeftSignal(InLeftSignal)
             , InputRightSignal(InRightSignal)
             , InputInvertLeft(InInvertLeft)
@@ -40,6 +65,8 @@ namespace Metasound
             , InputSwapChannels(InSwapChannels)
             , OutputLeftSignal(FAudioBufferWriteRef::CreateNew(InSettings))
             , OutputRightSignal(FAudioBufferWriteRef::CreateNew(InSettings))
+            , bFlagsAreConstant(bInFlagsAreConstant)
+            , Routing(GetRouting(bInFlagsAreConstant, *InInvertLeft, *InInvertRight, *InSwapChannels))
         {
         }
 
@@ -89,28 +116,47 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace StereoInverterNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputLeftSignal), InputLeftSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputRightSignal), InputRightSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputInvertLeft), InputInvertLeft);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputInvertRight), InputInvertRight);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputSwapChannels), InputSwapChannels);
+            // Check before binding, while the vertex data still shows what the graph connected. A flag that keeps its
+            // reference falls back on the combined answer from last time, which can only be pessimistic.
+            bFlagsAreConstant =
+                MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputInvertLeft), InputInvertLeft, bFlagsAreConstant) &&
+                MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputInvertRight), InputInvertRight, bFlagsAreConstant) &&
+                MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputSwapChannels), InputSwapChannels, bFlagsAreConstant);
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputLeftSignal), InputLeftSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRightSignal), InputRightSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputInvertLeft), InputInvertLeft);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputInvertRight), InputInvertRight);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputSwapChannels), InputSwapChannels);
 
-            return InputDataReferences;
+            Routing = GetRouting(bFlagsAreConstant, *InputInvertLeft, *InputInvertRight, *InputSwapChannels);
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace StereoInverterNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputLeftSignal), OutputLeftSignal);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputRightSignal), OutputRightSignal);
-            return OutputDataReferences;
+            switch (Routing)
+            {
+            case ERouting::Straight:
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), InputLeftSignal);
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), InputRightSignal);
+                break;
+
+            case ERouting::Swapped:
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), InputRightSignal);
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), InputLeftSignal);
+                break;
+
+            default:
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), OutputLeftSignal);
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), OutputRightSignal);
+                break;
+            }
         }
 
         static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutErrors)
@@ -127,11 +173,30 @@ namespace Metasound
             TDataReadReference<bool> InvertRight = InputData.GetOrCreateDefaultDataReadReference<bool>(METASOUND_GET_PARAM_NAME(InputInvertRight), InParams.OperatorSettings);
             TDataReadReference<bool> SwapChannels = InputData.GetOrCreateDefaultDataReadReference<bool>(METASOUND_GET_PARAM_NAME(InputSwapChannels), InParams.OperatorSettings);
 
-            return MakeUnique<FStereoInverterOperator>(InParams.OperatorSettings, InputLeftSignal, InputRightSignal, InvertLeft, InvertRight, SwapChannels);
+            const bool bFlagsAreConstant =
+                MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputInvertLeft)) &&
+                MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputInvertRight)) &&
+                MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputSwapChannels));
+
+            return MakeUnique<FStereoInverterOperator>(InParams.OperatorSettings, InputLeftSignal, InputRightSignal, InvertLeft, InvertRight, SwapChannels, bFlagsAreConstant);
+        }
+
+        virtual void Reset(const IOperator::FResetParams& InParams)
+        {
+            OutputLeftSignal->Zero();
+            OutputRightSignal->Zero();
         }
 
         void Execute()
         {
+            METASOUND_BRANCHES_SCOPE_EXECUTE(StereoInverter, InputLeftSignal->Num());
+
+            if (Routing != ERouting::Process)
+            {
+                METASOUND_BRANCHES_COUNT_SHORT_CIRCUIT(StereoInverter);
+                return;
+            }
+
             const int32 NumFrames = InputLeftSignal->Num();
 
             const float* LeftData = InputLeftSignal->GetData();
@@ -139,29 +204,7 @@ namespace Metasound
             float* OutputLeftData = OutputLeftSignal->GetData();
             float* OutputRightData = OutputRightSignal->GetData();
 
-            const bool bInvertL = *InputInvertLeft;
-            const bool bInvertR = *InputInvertRight;
-            const bool bSwap = *InputSwapChannels;
-
-            const float LMult = bInvertL ? -1.0f : 1.0f;
-            const float RMult = bInvertR ? -1.0f : 1.0f;
-
-            for (int32 i = 0; i < NumFrames; ++i)
-            {
-                const float LIn = LeftData[i];
-                const float RIn = RightData[i];
-
-                if (bSwap)
-                {
-                    OutputLeftData[i] = RIn * LMult;
-                    OutputRightData[i] = LIn * RMult;
-                }
-                else
-                {
-                    OutputLeftData[i] = LIn * LMult;
-                    OutputRightData[i] = RIn * RMult;
-                }
-            }
+            MetasoundBranches::ProcessStereoInverter(LeftData, RightData, OutputLeftData, OutputRightData, NumFrames, *InputInvertLeft, *InputInvertRight, *InputSwapChannels);
         }
 
     private:
@@ -175,6 +218,9 @@ namespace Metasound
         // Outputs
         FAudioBufferWriteRef OutputLeftSignal;
         FAudioBufferWriteRef OutputRightSignal;
+
+        bool bFlagsAreConstant = false;
+        ERouting Routing = ERouting::Process;
     };
 
     class FStereoInverterNode : public FNodeFacade
@@ -187,6 +233,7 @@ namespace Metasound
     };
 
     METASOUND_REGISTER_NODE(FStereoInverterNode);
+    METASOUND_BRANCHES_LIST_NODE(FStereoInverterNode);
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
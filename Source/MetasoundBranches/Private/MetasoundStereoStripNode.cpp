@@ -0,0 +1,242 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranches/Public/MetasoundStereoStripNode.h"
+#include "MetasoundBranches/Public/DSP/StereoKernels.h"
+#include "MetasoundExecutableOperator.h"     // TExecutableOperator class
+#include "MetasoundPrimitives.h"             // ReadRef and WriteRef descriptions for bool, int32, float, and string
+#include "MetasoundNodeRegistrationMacro.h"  // METASOUND_LOCTEXT and METASOUND_REGISTER_NODE macros
+#include "MetasoundFacade.h"                 // FNodeFacade class, eliminates the need for a fair amount of boilerplate code
+#include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
+
+#define LOCTEXT_NAMESPACE "MetasoundStandardNodes_StereoStripNode"
+
+namespace Metasound
+{
+    namespace StereoStripNodeNames
+    {
+        METASOUND_PARAM(InputLeftSignal, "In L", "Left channel.");
+        METASOUND_PARAM(InputRightSignal, "In R", "Right channel.");
+        METASOUND_PARAM(InputInvertLeft, "Invert L", "Invert the polarity of the left channel.");
+        METASOUND_PARAM(InputInvertRight, "Invert R", "Invert the polarity of the right channel.");
+        METASOUND_PARAM(InputSwapChannels, "Swap L/R", "Swap the left and right channels.");
+        METASOUND_PARAM(InputWidth, "Width", "Stereo width factor ranging from 0 to 200% (0 - 2).");
+        METASOUND_PARAM(InputBalance, "Balance", "Balance between left and right channels (-1 to 1).");
+        METASOUND_PARAM(InputGain, "Gain", "Gain applied to both channels.");
+
+        METASOUND_PARAM(OutputLeftSignal, "Out L", "Left channel output.");
+        METASOUND_PARAM(OutputRightSignal, "Out R", "Right channel output.");
+    }
+
+    METASOUND_BRANCHES_DECLARE_NODE_STATS(StereoStrip, "Stereo Strip")
+
+    // Stereo Inverter, Stereo Width, Stereo Balance and Stereo Gain in that order, as a single 2x2 matrix pass
+    class FStereoStripOperator : public TExecutableOperator<FStereoStripOperator>
+    {
+    public:
+        FStereoStripOperator(
+            const FOperatorSettings& InSettings,
+            const FAudioBufferReadRef& InLeftSignal,
+            const FAudioBufferReadRef& InRightSignal,
+            const FBoolReadRef& InInvertLeft,
+            const FBoolReadRef& InInvertRight,
+            const FBoolReadRef& InSwapChannels,
+            const FFloatReadRef& InWidth,
+            const FFloatReadRef& InBalance,
+            const FFloatReadRef& InGain)
+            : InputLeftSignal(InLeftSignal)
+            , InputRightSignal(InRightSignal)
+            , InputInvertLeft(InInvertLeft)
+            , InputInvertRight(InInvertRight)
+            , InputSwapChannels(InSwapChannels)
+            , InputWidth(InWidth)
+            , InputBalance(InBalance)
+            , InputGain(InGain)
+            , OutputLeftSignal(FAudioBufferWriteRef::CreateNew(InSettings))
+            , OutputRightSignal(FAudioBufferWriteRef::CreateNew(InSettings))
+        {
+            UpdateMatrix();
+        }
+
+        static const FVertexInterface& DeclareVertexInterface()
+        {
+            using namespace StereoStripNodeNames;
+
+            static const FVertexInterface Interface(
+                FInputVertexInterface(
+                    TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal)),
+                    TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal)),
+                    TInputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputInvertLeft), false),
+                    TInputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputInvertRight), false),
+                    TInputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSwapChannels), false),
+                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputWidth), 1.0f),
+                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputBalance), 0.0f),
+                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputGain), 1.0f)
+                ),
+                FOutputVertexInterface(
+                    TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputLeftSignal)),
+                    TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputRightSignal))
+                )
+            );
+
+            return Interface;
+        }
+
+        static const FNodeClassMetadata& GetNodeInfo()
+        {
+            auto CreateNodeClassMetadata = []() -> FNodeClassMetadata
+                {
+                    FVertexInterface NodeInterface = DeclareVertexInterface();
+
+                    FNodeClassMetadata Metadata;
+
+                    Metadata.ClassName = { TEXT("UE"), TEXT("Stereo Strip"), TEXT("Audio") };
+                    Metadata.MajorVersion = 1;
+                    Metadata.MinorVersion = 0;
+                    Metadata.DisplayName = METASOUND_LOCTEXT("StereoStripNodeDisplayName", "Stereo Strip");
+                    Metadata.Description = METASOUND_LOCTEXT("StereoStripNodeDesc", "Inverts/swaps, sets the width, balances and applies gain to a stereo signal in one pass.");
+                    Metadata.Author = "Charles Matthews";
+                    Metadata.PromptIfMissing = PluginNodeMissingPrompt;
+                    Metadata.DefaultInterface = DeclareVertexInterface();
+                    Metadata.CategoryHierarchy = { METASOUND_LOCTEXT("Custom", "Branches") };
+                    Metadata.Keywords = TArray<FText>(); // Keywords for searching
+
+                    return Metadata;
+                };
+
+            static const FNodeClassMetadata Metadata = CreateNodeClassMetadata();
+            return Metadata;
+        }
+
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace StereoStripNodeNames;
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputLeftSignal), InputLeftSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRightSignal), InputRightSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputInvertLeft), InputInvertLeft);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputInvertRight), InputInvertRight);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputSwapChannels), InputSwapChannels);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputWidth), InputWidth);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputBalance), InputBalance);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputGain), InputGain);
+        }
+
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace StereoStripNodeNames;
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), OutputLeftSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), OutputRightSignal);
+        }
+
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutErrors)
+        {
+            using namespace StereoStripNodeNames;
+
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
+
+            TDataReadReference<FAudioBuffer> InputLeftSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputLeftSignal), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputRightSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputRightSignal), InParams.OperatorSettings);
+            TDataReadReference<bool> InputInvertLeft = InputData.GetOrCreateDefaultDataReadReference<bool>(METASOUND_GET_PARAM_NAME(InputInvertLeft), InParams.OperatorSettings);
+            TDataReadReference<bool> InputInvertRight = InputData.GetOrCreateDefaultDataReadReference<bool>(METASOUND_GET_PARAM_NAME(InputInvertRight), InParams.OperatorSettings);
+            TDataReadReference<bool> InputSwapChannels = InputData.GetOrCreateDefaultDataReadReference<bool>(METASOUND_GET_PARAM_NAME(InputSwapChannels), InParams.OperatorSettings);
+            TDataReadReference<float> InputWidth = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputWidth), InParams.OperatorSettings);
+            TDataReadReference<float> InputBalance = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputBalance), InParams.OperatorSettings);
+            TDataReadReference<float> InputGain = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputGain), InParams.OperatorSettings);
+
+            return MakeUnique<FStereoStripOperator>(
+                InParams.OperatorSettings,
+                InputLeftSignal,
+                InputRightSignal,
+                InputInvertLeft,
+                InputInvertRight,
+                InputSwapChannels,
+                InputWidth,
+                InputBalance,
+                InputGain
+            );
+        }
+
+        virtual void Reset(const IOperator::FResetParams& InParams)
+        {
+            OutputLeftSignal->Zero();
+            OutputRightSignal->Zero();
+
+            UpdateMatrix();
+        }
+
+        void Execute()
+        {
+            METASOUND_BRANCHES_SCOPE_EXECUTE(StereoStrip, InputLeftSignal->Num());
+
+            // The balance gains need a sin/cos, so only rebuild the matrix when a control input has moved
+            if (*InputInvertLeft != bInvertLeft || *InputInvertRight != bInvertRight || *InputSwapChannels != bSwapChannels
+                || *InputWidth != Width || *InputBalance != Balance || *InputGain != Gain)
+            {
+                UpdateMatrix();
+            }
+
+            int32 NumFrames = InputLeftSignal->Num();
+
+            const float* LeftData = InputLeftSignal->GetData();
+            const float* RightData = InputRightSignal->GetData();
+            float* OutputLeftData = OutputLeftSignal->GetData();
+            float* OutputRightData = OutputRightSignal->GetData();
+
+            MetasoundBranches::ProcessStereoMatrix(LeftData, RightData, OutputLeftData, OutputRightData, NumFrames, Matrix);
+        }
+
+    private:
+        void UpdateMatrix()
+        {
+            bInvertLeft = *InputInvertLeft;
+            bInvertRight = *InputInvertRight;
+            bSwapChannels = *InputSwapChannels;
+            Width = *InputWidth;
+            Balance = *InputBalance;
+            Gain = *InputGain;
+
+            Matrix = MetasoundBranches::GetStereoStripMatrix(bInvertLeft, bInvertRight, bSwapChannels, Width, Balance, Gain);
+        }
+
+        // Inputs
+        FAudioBufferReadRef InputLeftSignal;
+        FAudioBufferReadRef InputRightSignal;
+        FBoolReadRef InputInvertLeft;
+        FBoolReadRef InputInvertRight;
+        FBoolReadRef InputSwapChannels;
+        FFloatReadRef InputWidth;
+        FFloatReadRef InputBalance;
+        FFloatReadRef InputGain;
+
+        // Outputs
+        FAudioBufferWriteRef OutputLeftSignal;
+        FAudioBufferWriteRef OutputRightSignal;
+
+        // Control values the current matrix was built from
+        bool bInvertLeft = false;
+        bool bInvertRight = false;
+        bool bSwapChannels = false;
+        float Width = 1.0f;
+        float Balance = 0.0f;
+        float Gain = 1.0f;
+
+        MetasoundBranches::FStereoMatrix Matrix;
+    };
+
+    class FStereoStripNode : public FNodeFacade
+    {
+    public:
+        FStereoStripNode(const FNodeInitData& InitData)
+            : FNodeFacade(InitData.InstanceName, InitData.InstanceID, TFacadeOperatorClass<FStereoStripOperator>())
+        {
+        }
+    };
+
+    METASOUND_REGISTER_NODE(FStereoStripNode);
+    METASOUND_BRANCHES_LIST_NODE(FStereoStripNode);
+}
+
+#undef LOCTEXT_NAMESPACE
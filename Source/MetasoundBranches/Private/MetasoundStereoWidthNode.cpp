@@ -1,11 +1,15 @@
 // Copyright 2025 Charles Matthews. All Rights Reserved.
 
 #include "MetasoundBranches/Public/MetasoundStereoWidthNode.h"
+#include "MetasoundBranches/Public/DSP/StereoKernels.h"
 #include "MetasoundExecutableOperator.h"     // TExecutableOperator class
 #include "MetasoundPrimitives.h"             // ReadRef and WriteRef descriptions for bool, int32, float, and string
 #include "MetasoundNodeRegistrationMacro.h"  // METASOUND_LOCTEXT and METASOUND_REGISTER_NODE macros
 #include "MetasoundFacade.h"                 // FNodeFacade class, eliminates the need for a fair amount of boilerplate code
 #include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "MetasoundBranches/Private/MetasoundBranchesBinding.h"
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_StereoWidthNode"
 
@@ -16,11 +20,14 @@ namespace Metasound
         METASOUND_PARAM(InputLeftSignal, "In L", "Left channel.");
         METASOUND_PARAM(InputRightSignal, "In R", "Right channel.");
         METASOUND_PARAM(InputWidth, "Width", "Stereo width factor ranging from 0 to 200% (0 - 2).");
+        METASOUND_PARAM(InputWidthModulation, "Width Mod", "Audio-rate modulation added to Width.");
 
         METASOUND_PARAM(OutputLeftSignal, "Out L", "Left channel of the adjusted stereo output signal.");
         METASOUND_PARAM(OutputRightSignal, "Out R", "Right channel of the adjusted stereo output signal.");
     }
 
+    METASOUND_BRANCHES_DECLARE_NODE_STATS(StereoWidth, "Stereo Width")
+
     class FWidthOperator : public TExecutableOperator<FWidthOperator>
     {
     public:
@@ -28,13 +35,20 @@ namespace Metasound
             const FOperatorSettings& InSettings,
             const FAudioBufferReadRef& InLeftSignal,
             const FAudioBufferReadRef& InRightSignal,
-            const FFloatReadRef& InWidth)
+            const FFloatReadRef& InWidth,
+            const FAudioBufferReadRef& InWidthModulation,
+            bool bInIsModulated,
+            bool bInWidthIsConstant)
             : InputLeftSignal(InLeftSignal)
             , InputRightSignal(InRightSignal)
             , InputWidth(InWidth)
+            , InputWidthModulation(InWidthModulation)
+            , bIsModulated(bInIsModulated)
             , OutputLeftSignal(FAudioBufferWriteRef::CreateNew(InSettings))
             , OutputRightSignal(FAudioBufferWriteRef::CreateNew(InSettings))
+            , bWidthIsConstant(bInWidthIsConstant)
         {
+            UpdatePassthrough();
         }
 
         static const FVertexInterface& DeclareVertexInterface()
@@ -45,7 +59,8 @@ namespace Metasound
                 FInputVertexInterface(
                     TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal)),
                     TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal)),
-                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputWidth), 1.0f)
+                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputWidth), 1.0f),
+                    TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputWidthModulation))
                 ),
                 FOutputVertexInterface(
                     TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputLeftSignal)),
@@ -66,7 +81,7 @@ namespace Metasound
 
                     Metadata.ClassName = { TEXT("UE"), TEXT("Stereo Width"), TEXT("Audio") };
                     Metadata.MajorVersion = 1;
-                    Metadata.MinorVersion = 0;
+                    Metadata.MinorVersion = 1;
                     Metadata.DisplayName = METASOUND_LOCTEXT("WidthNodeDisplayName", "Stereo Width");
                     Metadata.Description = METASOUND_LOCTEXT("WidthNodeDesc", "Adjusts the stereo width of a signal.");
                     Metadata.Author = "Charles Matthews";
@@ -82,29 +97,37 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace WidthNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
+            // Check before binding, while the vertex data still shows what the graph connected
+            bWidthIsConstant = MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputWidth), InputWidth, bWidthIsConstant);
+            bIsModulated = MetasoundBranches::IsConnectedInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputWidthModulation), InputWidthModulation, bIsModulated);
 
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputLeftSignal), InputLeftSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputRightSignal), InputRightSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputWidth), InputWidth);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputLeftSignal), InputLeftSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRightSignal), InputRightSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputWidth), InputWidth);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputWidthModulation), InputWidthModulation);
 
-            return InputDataReferences;
+            UpdatePassthrough();
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace WidthNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputLeftSignal), OutputLeftSignal);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputRightSignal), OutputRightSignal);
-
-            return OutputDataReferences;
+            if (bPassthrough)
+            {
+                // Full width leaves the image unchanged: the outputs are the input buffers
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), InputLeftSignal);
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), InputRightSignal);
+            }
+            else
+            {
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), OutputLeftSignal);
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), OutputRightSignal);
+            }
         }
 
         static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutErrors)
@@ -117,12 +140,30 @@ namespace Metasound
             TDataReadReference<FAudioBuffer> InputLeftSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputLeftSignal), InParams.OperatorSettings);
             TDataReadReference<FAudioBuffer> InputRightSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputRightSignal), InParams.OperatorSettings);
             TDataReadReference<float> InputWidth = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputWidth), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputWidthModulation = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputWidthModulation), InParams.OperatorSettings);
 
-            return MakeUnique<FWidthOperator>(InParams.OperatorSettings, InputLeftSignal, InputRightSignal, InputWidth);
+            const bool bIsModulated = MetasoundBranches::IsConnectedInput(InputData, METASOUND_GET_PARAM_NAME(InputWidthModulation));
+            const bool bWidthIsConstant = MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputWidth));
+
+            return MakeUnique<FWidthOperator>(InParams.OperatorSettings, InputLeftSignal, InputRightSignal, InputWidth, InputWidthModulation, bIsModulated, bWidthIsConstant);
+        }
+
+        virtual void Reset(const IOperator::FResetParams& InParams)
+        {
+            OutputLeftSignal->Zero();
+            OutputRightSignal->Zero();
         }
 
         void Execute()
         {
+            METASOUND_BRANCHES_SCOPE_EXECUTE(StereoWidth, InputLeftSignal->Num());
+
+            if (bPassthrough)
+            {
+                METASOUND_BRANCHES_COUNT_SHORT_CIRCUIT(StereoWidth);
+                return;
+            }
+
             int32 NumFrames = InputLeftSignal->Num();
 
             const float* LeftData = InputLeftSignal->GetData();
@@ -130,33 +171,37 @@ namespace Metasound
             float* OutputLeftData = OutputLeftSignal->GetData();
             float* OutputRightData = OutputRightSignal->GetData();
 
-            float WidthFactor = FMath::Clamp(*InputWidth, 0.0f, 2.0f);
-
-            for (int32 i = 0; i < NumFrames; ++i)
+            if (bIsModulated)
             {
-                float Left = LeftData[i];
-                float Right = RightData[i];
-
-                float Mid = 0.5f * (Left + Right);
-                float Side = 0.5f * (Left - Right);
-
-                Side *= WidthFactor;
-
-                OutputLeftData[i] = Mid + Side;
-                OutputRightData[i] = Mid - Side;
+                MetasoundBranches::ProcessStereoWidthModulated(LeftData, RightData, InputWidthModulation->GetData(), OutputLeftData, OutputRightData, NumFrames, *InputWidth);
+            }
+            else
+            {
+                MetasoundBranches::ProcessStereoWidth(LeftData, RightData, OutputLeftData, OutputRightData, NumFrames, *InputWidth);
             }
         }
 
     private:
+        void UpdatePassthrough()
+        {
+            bPassthrough = !bIsModulated && bWidthIsConstant && *InputWidth == 1.0f;
+        }
 
         // Inputs
         FAudioBufferReadRef InputLeftSignal;
         FAudioBufferReadRef InputRightSignal;
         FFloatReadRef InputWidth;
+        FAudioBufferReadRef InputWidthModulation;
 
         // Outputs
         FAudioBufferWriteRef OutputLeftSignal;
         FAudioBufferWriteRef OutputRightSignal;
+
+        bool bIsModulated = false;
+        bool bWidthIsConstant = false;
+
+        // Width is a constant 1.0 with no modulation, so the outputs are bound to the inputs
+        bool bPassthrough = false;
     };
 
     class FWidthNode : public FNodeFacade
@@ -169,6 +214,7 @@ namespace Metasound
     };
 
     METASOUND_REGISTER_NODE(FWidthNode);
+    METASOUND_BRANCHES_LIST_NODE(FWidthNode);
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
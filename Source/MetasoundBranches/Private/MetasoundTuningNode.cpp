@@ -1,11 +1,15 @@
 // Copyright 2025 Charles Matthews. All Rights Reserved.
 
 #include "MetasoundBranches/Public/MetasoundTuningNode.h"
+#include "MetasoundBranches/Public/DSP/TuningKernel.h"
 #include "MetasoundExecutableOperator.h"
 #include "MetasoundPrimitives.h"
 #include "MetasoundNodeRegistrationMacro.h"
 #include "MetasoundFacade.h"
 #include "MetasoundParamHelper.h"
+#include "MetasoundBranches/Private/MetasoundBranchesBinding.h"
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_TuningNode"
 
@@ -29,6 +33,8 @@ namespace Metasound
         METASOUND_PARAM(OutputFrequency, "Frequency", "Output frequency.");
     }
 
+    METASOUND_BRANCHES_DECLARE_NODE_STATS(Tuning, "Tuning")
+
     class FTuningNodeOperator : public TExecutableOperator<FTuningNodeOperator>
     {
     public:
@@ -46,7 +52,9 @@ namespace Metasound
             const FFloatReadRef& InTuningCents8,
             const FFloatReadRef& InTuningCents9,
             const FFloatReadRef& InTuningCents10,
-            const FFloatReadRef& InTuningCents11)
+            const FFloatReadRef& InTuningCents11,
+            bool bInNoteIsConstant,
+            bool bInCentsAreConstant)
             : MIDINoteNumber(InMIDINoteNumber)
             , TuningCents0(InTuningCents0)
             , TuningCents1(InTuningCents1)
@@ -61,7 +69,11 @@ namespace Metasound
             , TuningCents10(InTuningCents10)
             , TuningCents11(InTuningCents11)
             , OutputFrequency(FFloatWriteRef::CreateNew(0.0f))
+            , bNoteIsConstant(bInNoteIsConstant)
+            , bCentsAreConstant(bInCentsAreConstant)
+            , NumFramesPerBlock(InSettings.GetNumFramesPerBlock())
         {
+            UpdateConstants();
         }
 
         static const FVertexInterface& DeclareVertexInterface()
@@ -118,38 +130,48 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace TuningNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
-
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputMIDINoteNumber), MIDINoteNumber);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents0), TuningCents0);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents1), TuningCents1);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents2), TuningCents2);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents3), TuningCents3);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents4), TuningCents4);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents5), TuningCents5);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents6), TuningCents6);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents7), TuningCents7);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents8), TuningCents8);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents9), TuningCents9);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents10), TuningCents10);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents11), TuningCents11);
-
-            return InputDataReferences;
+            // A cents input that keeps its reference falls back on the combined answer from last time, which can only be pessimistic
+            bNoteIsConstant = MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputMIDINoteNumber), MIDINoteNumber, bNoteIsConstant);
+            bCentsAreConstant =
+                MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputTuningCents0), TuningCents0, bCentsAreConstant) &&
+                MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputTuningCents1), TuningCents1, bCentsAreConstant) &&
+                MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputTuningCents2), TuningCents2, bCentsAreConstant) &&
+                MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputTuningCents3), TuningCents3, bCentsAreConstant) &&
+                MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputTuningCents4), TuningCents4, bCentsAreConstant) &&
+                MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputTuningCents5), TuningCents5, bCentsAreConstant) &&
+                MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputTuningCents6), TuningCents6, bCentsAreConstant) &&
+                MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputTuningCents7), TuningCents7, bCentsAreConstant) &&
+                MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputTuningCents8), TuningCents8, bCentsAreConstant) &&
+                MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputTuningCents9), TuningCents9, bCentsAreConstant) &&
+                MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputTuningCents10), TuningCents10, bCentsAreConstant) &&
+                MetasoundBranches::IsConstantInput(InOutVertexData, METASOUND_GET_PARAM_NAME(InputTuningCents11), TuningCents11, bCentsAreConstant);
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputMIDINoteNumber), MIDINoteNumber);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents0), TuningCents0);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents1), TuningCents1);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents2), TuningCents2);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents3), TuningCents3);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents4), TuningCents4);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents5), TuningCents5);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents6), TuningCents6);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents7), TuningCents7);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents8), TuningCents8);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents9), TuningCents9);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents10), TuningCents10);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents11), TuningCents11);
+
+            UpdateConstants();
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace TuningNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputFrequency), OutputFrequency);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputFrequency), OutputFrequency);
         }
 
         static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutErrors)
@@ -174,6 +196,22 @@ namespace Metasound
             TDataReadReference<float> TuningCents10 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents10), InParams.OperatorSettings);
             TDataReadReference<float> TuningCents11 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents11), InParams.OperatorSettings);
 
+            // Literal cents only need turning into frequencies once; with a literal note as well, so does the output
+            const bool bNoteIsConstant = MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputMIDINoteNumber));
+            const bool bCentsAreConstant =
+                MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputTuningCents0)) &&
+                MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputTuningCents1)) &&
+                MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputTuningCents2)) &&
+                MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputTuningCents3)) &&
+                MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputTuningCents4)) &&
+                MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputTuningCents5)) &&
+                MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputTuningCents6)) &&
+                MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputTuningCents7)) &&
+                MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputTuningCents8)) &&
+                MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputTuningCents9)) &&
+                MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputTuningCents10)) &&
+                MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputTuningCents11));
+
             return MakeUnique<FTuningNodeOperator>(
                 InParams.OperatorSettings,
                 MIDINoteNumber,
@@ -188,38 +226,79 @@ namespace Metasound
                 TuningCents8,
                 TuningCents9,
                 TuningCents10,
-                TuningCents11
+                TuningCents11,
+                bNoteIsConstant,
+                bCentsAreConstant
             );
         }
 
+        virtual void Reset(const IOperator::FResetParams& InParams)
+        {
+            *OutputFrequency = 0.0f;
+            UpdateConstants();
+        }
+
         void Execute()
         {
-            int32 midiNote = *MIDINoteNumber;
-            int32 noteInOctave = midiNote % 12;
-
-            float tuningCentsArray[12] = {
-                *TuningCents0,
-                *TuningCents1,
-                *TuningCents2,
-                *TuningCents3,
-                *TuningCents4,
-                *TuningCents5,
-                *TuningCents6,
-                *TuningCents7,
-                *TuningCents8,
-                *TuningCents9,
-                *TuningCents10,
-                *TuningCents11
-            };
+            METASOUND_BRANCHES_SCOPE_EXECUTE(Tuning, NumFramesPerBlock);
+
+            if (bNoteIsConstant && bCentsAreConstant)
+            {
+                METASOUND_BRANCHES_COUNT_SHORT_CIRCUIT(Tuning);
+                return;
+            }
+
+            if (bCentsAreConstant)
+            {
+                *OutputFrequency = Table.GetFrequency(*MIDINoteNumber);
+                return;
+            }
+
+            float TuningCentsArray[MetasoundBranches::FTuningTable::NumPitchClasses];
+            GetTuningCents(TuningCentsArray);
+
+            int32 Octave;
+            int32 PitchClass;
+            MetasoundBranches::FTuningTable::SplitNote(*MIDINoteNumber, Octave, PitchClass);
 
-            float tuningAdjustmentCents = tuningCentsArray[noteInOctave];
-            float tuningAdjustmentSemitones = tuningAdjustmentCents / 100.0f;
-            float adjustedNote = midiNote + tuningAdjustmentSemitones;
-            float frequency = 440.0f * powf(2.0f, (adjustedNote - 69.0f) / 12.0f);
-            *OutputFrequency = frequency;
+            *OutputFrequency = MetasoundBranches::FTuningTable::GetFrequency(*MIDINoteNumber, TuningCentsArray[PitchClass]);
         }
 
     private:
+        void GetTuningCents(float (&OutCents)[MetasoundBranches::FTuningTable::NumPitchClasses]) const
+        {
+            OutCents[0] = *TuningCents0;
+            OutCents[1] = *TuningCents1;
+            OutCents[2] = *TuningCents2;
+            OutCents[3] = *TuningCents3;
+            OutCents[4] = *TuningCents4;
+            OutCents[5] = *TuningCents5;
+            OutCents[6] = *TuningCents6;
+            OutCents[7] = *TuningCents7;
+            OutCents[8] = *TuningCents8;
+            OutCents[9] = *TuningCents9;
+            OutCents[10] = *TuningCents10;
+            OutCents[11] = *TuningCents11;
+        }
+
+        // Rebuilds whatever the constant inputs let us work out ahead of Execute
+        void UpdateConstants()
+        {
+            if (!bCentsAreConstant)
+            {
+                return;
+            }
+
+            float TuningCentsArray[MetasoundBranches::FTuningTable::NumPitchClasses];
+            GetTuningCents(TuningCentsArray);
+            Table.SetCents(TuningCentsArray);
+
+            if (bNoteIsConstant)
+            {
+                *OutputFrequency = Table.GetFrequency(*MIDINoteNumber);
+            }
+        }
+
         FInt32ReadRef MIDINoteNumber;
         FFloatReadRef TuningCents0;
         FFloatReadRef TuningCents1;
@@ -234,6 +313,15 @@ namespace Metasound
         FFloatReadRef TuningCents10;
         FFloatReadRef TuningCents11;
         FFloatWriteRef OutputFrequency;
+
+        bool bNoteIsConstant = false;
+        bool bCentsAreConstant = false;
+
+        // Frames in each block, for the node stats
+        int32 NumFramesPerBlock = 0;
+
+        // Frequency of every pitch class, kept while the cents are constant
+        MetasoundBranches::FTuningTable Table;
     };
 
     class FTuningNode : public FNodeFacade
@@ -246,6 +334,7 @@ namespace Metasound
     };
 
     METASOUND_REGISTER_NODE(FTuningNode);
+    METASOUND_BRANCHES_LIST_NODE(FTuningNode);
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
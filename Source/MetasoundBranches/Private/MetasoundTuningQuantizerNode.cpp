@@ -0,0 +1,318 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranches/Public/MetasoundTuningQuantizerNode.h"
+#include "MetasoundBranches/Public/DSP/TuningKernel.h"
+#include "MetasoundExecutableOperator.h"
+#include "MetasoundPrimitives.h"
+#include "MetasoundNodeRegistrationMacro.h"
+#include "MetasoundFacade.h"
+#include "MetasoundParamHelper.h"
+#include "MetasoundTrigger.h"
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
+
+#define LOCTEXT_NAMESPACE "MetasoundStandardNodes_TuningQuantizerNode"
+
+namespace Metasound
+{
+    namespace TuningQuantizerNodeNames
+    {
+        METASOUND_PARAM(InputPitch, "In", "Pitch to quantize, in MIDI notes. Values between notes are fine.");
+        METASOUND_PARAM(InputHysteresis, "Hysteresis", "How far past the halfway point to another note, in semitones, the input has to move before the note changes.");
+        METASOUND_PARAM(InputScale, "Scale", "Allowed pitch classes: add 1 for C, 2 for C♯, 4 for D, and so on up to 2048 for B. 2741 is C major; 0 or 4095 allows every note.");
+        METASOUND_PARAM(InputTuningCents0, "+/- Cents C", "Tuning adjustment for note 0 in cents.");
+        METASOUND_PARAM(InputTuningCents1, "+/- Cents C♯ / D♭", "Tuning adjustment for note 1 in cents.");
+        METASOUND_PARAM(InputTuningCents2, "+/- Cents D", "Tuning adjustment for note 2 in cents.");
+        METASOUND_PARAM(InputTuningCents3, "+/- Cents D♯ / E♭", "Tuning adjustment for note 3 in cents.");
+        METASOUND_PARAM(InputTuningCents4, "+/- Cents E", "Tuning adjustment for note 4 in cents.");
+        METASOUND_PARAM(InputTuningCents5, "+/- Cents F", "Tuning adjustment for note 5 in cents.");
+        METASOUND_PARAM(InputTuningCents6, "+/- Cents F♯ / G♭", "Tuning adjustment for note 6 in cents.");
+        METASOUND_PARAM(InputTuningCents7, "+/- Cents G", "Tuning adjustment for note 7 in cents.");
+        METASOUND_PARAM(InputTuningCents8, "+/- Cents G♯ / A♭", "Tuning adjustment for note 8 in cents.");
+        METASOUND_PARAM(InputTuningCents9, "+/- Cents A", "Tuning adjustment for note 9 in cents.");
+        METASOUND_PARAM(InputTuningCents10, "+/- Cents A♯ / B♭", "Tuning adjustment for note 10 in cents.");
+        METASOUND_PARAM(InputTuningCents11, "+/- Cents B", "Tuning adjustment for note 11 in cents.");
+
+        METASOUND_PARAM(OutputFrequency, "Frequency", "Frequency of the quantized note, including its cents.");
+        METASOUND_PARAM(OutputNote, "Note", "Quantized MIDI note number.");
+        METASOUND_PARAM(OutputOnChange, "On Change", "Trigger on the sample where the note changes.");
+    }
+
+    METASOUND_BRANCHES_DECLARE_NODE_STATS(TuningQuantizer, "Tuning Quantizer")
+
+    class FTuningQuantizerNodeOperator : public TExecutableOperator<FTuningQuantizerNodeOperator>
+    {
+    public:
+        FTuningQuantizerNodeOperator(
+            const FOperatorSettings& InSettings,
+            const FAudioBufferReadRef& InPitch,
+            const FFloatReadRef& InHysteresis,
+            const FInt32ReadRef& InScale,
+            const FFloatReadRef& InTuningCents0,
+            const FFloatReadRef& InTuningCents1,
+            const FFloatReadRef& InTuningCents2,
+            const FFloatReadRef& InTuningCents3,
+            const FFloatReadRef& InTuningCents4,
+            const FFloatReadRef& InTuningCents5,
+            const FFloatReadRef& InTuningCents6,
+            const FFloatReadRef& InTuningCents7,
+            const FFloatReadRef& InTuningCents8,
+            const FFloatReadRef& InTuningCents9,
+            const FFloatReadRef& InTuningCents10,
+            const FFloatReadRef& InTuningCents11)
+            : Pitch(InPitch)
+            , Hysteresis(InHysteresis)
+            , Scale(InScale)
+            , TuningCents0(InTuningCents0)
+            , TuningCents1(InTuningCents1)
+            , TuningCents2(InTuningCents2)
+            , TuningCents3(InTuningCents3)
+            , TuningCents4(InTuningCents4)
+            , TuningCents5(InTuningCents5)
+            , TuningCents6(InTuningCents6)
+            , TuningCents7(InTuningCents7)
+            , TuningCents8(InTuningCents8)
+            , TuningCents9(InTuningCents9)
+            , TuningCents10(InTuningCents10)
+            , TuningCents11(InTuningCents11)
+            , OutputFrequency(FAudioBufferWriteRef::CreateNew(InSettings))
+            , OutputNote(FAudioBufferWriteRef::CreateNew(InSettings))
+            , OutputOnChange(FTriggerWriteRef::CreateNew(InSettings))
+        {
+            UpdateTuning();
+        }
+
+        static const FVertexInterface& DeclareVertexInterface()
+        {
+            using namespace TuningQuantizerNodeNames;
+
+            static const FVertexInterface Interface(
+                FInputVertexInterface(
+                    TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputPitch)),
+                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputHysteresis), 0.1f),
+                    TInputDataVertex<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputScale), MetasoundBranches::FTuningQuantizer::AllPitchClasses),
+                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputTuningCents0)),
+                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputTuningCents1)),
+                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputTuningCents2)),
+                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputTuningCents3)),
+                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputTuningCents4)),
+                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputTuningCents5)),
+                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputTuningCents6)),
+                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputTuningCents7)),
+                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputTuningCents8)),
+                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputTuningCents9)),
+                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputTuningCents10)),
+                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputTuningCents11))
+                ),
+                FOutputVertexInterface(
+                    TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputFrequency)),
+                    TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputNote)),
+                    TOutputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputOnChange))
+                )
+            );
+
+            return Interface;
+        }
+
+        static const FNodeClassMetadata& GetNodeInfo()
+        {
+            auto CreateNodeClassMetadata = []() -> FNodeClassMetadata
+            {
+                FVertexInterface NodeInterface = DeclareVertexInterface();
+
+                FNodeClassMetadata Metadata;
+
+                Metadata.ClassName = { TEXT("UE"), TEXT("TuningQuantizer"), TEXT("Audio") };
+                Metadata.MajorVersion = 1;
+                Metadata.MinorVersion = 0;
+                Metadata.DisplayName = METASOUND_LOCTEXT("TuningQuantizerNodeDisplayName", "Tuning Quantizer");
+                Metadata.Description = METASOUND_LOCTEXT("TuningQuantizerNodeDesc", "Quantize an audio-rate pitch to the nearest note of a custom 12-note tuning, with hysteresis and a trigger when the note changes.");
+                Metadata.Author = "Charles Matthews";
+                Metadata.PromptIfMissing = PluginNodeMissingPrompt;
+                Metadata.DefaultInterface = NodeInterface;
+                Metadata.CategoryHierarchy = { METASOUND_LOCTEXT("Custom", "Branches") };
+                Metadata.Keywords = TArray<FText>();
+
+                return Metadata;
+            };
+
+            static const FNodeClassMetadata Metadata = CreateNodeClassMetadata();
+            return Metadata;
+        }
+
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace TuningQuantizerNodeNames;
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputPitch), Pitch);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputHysteresis), Hysteresis);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputScale), Scale);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents0), TuningCents0);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents1), TuningCents1);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents2), TuningCents2);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents3), TuningCents3);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents4), TuningCents4);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents5), TuningCents5);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents6), TuningCents6);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents7), TuningCents7);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents8), TuningCents8);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents9), TuningCents9);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents10), TuningCents10);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents11), TuningCents11);
+
+            UpdateTuning();
+        }
+
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace TuningQuantizerNodeNames;
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputFrequency), OutputFrequency);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputNote), OutputNote);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputOnChange), OutputOnChange);
+        }
+
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutErrors)
+        {
+            using namespace TuningQuantizerNodeNames;
+
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
+
+            TDataReadReference<FAudioBuffer> Pitch = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputPitch), InParams.OperatorSettings);
+            TDataReadReference<float> Hysteresis = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputHysteresis), InParams.OperatorSettings);
+            TDataReadReference<int32> Scale = InputData.GetOrCreateDefaultDataReadReference<int32>(METASOUND_GET_PARAM_NAME(InputScale), InParams.OperatorSettings);
+
+            TDataReadReference<float> TuningCents0 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents0), InParams.OperatorSettings);
+            TDataReadReference<float> TuningCents1 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents1), InParams.OperatorSettings);
+            TDataReadReference<float> TuningCents2 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents2), InParams.OperatorSettings);
+            TDataReadReference<float> TuningCents3 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents3), InParams.OperatorSettings);
+            TDataReadReference<float> TuningCents4 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents4), InParams.OperatorSettings);
+            TDataReadReference<float> TuningCents5 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents5), InParams.OperatorSettings);
+            TDataReadReference<float> TuningCents6 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents6), InParams.OperatorSettings);
+            TDataReadReference<float> TuningCents7 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents7), InParams.OperatorSettings);
+            TDataReadReference<float> TuningCents8 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents8), InParams.OperatorSettings);
+            TDataReadReference<float> TuningCents9 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents9), InParams.OperatorSettings);
+            TDataReadReference<float> TuningCents10 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents10), InParams.OperatorSettings);
+            TDataReadReference<float> TuningCents11 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents11), InParams.OperatorSettings);
+
+            return MakeUnique<FTuningQuantizerNodeOperator>(
+                InParams.OperatorSettings,
+                Pitch,
+                Hysteresis,
+                Scale,
+                TuningCents0,
+                TuningCents1,
+                TuningCents2,
+                TuningCents3,
+                TuningCents4,
+                TuningCents5,
+                TuningCents6,
+                TuningCents7,
+                TuningCents8,
+                TuningCents9,
+                TuningCents10,
+                TuningCents11
+            );
+        }
+
+        virtual void Reset(const IOperator::FResetParams& InParams)
+        {
+            OutputOnChange->Reset();
+            OutputFrequency->Zero();
+            OutputNote->Zero();
+
+            Quantizer.Reset();
+            UpdateTuning();
+        }
+
+        void Execute()
+        {
+            METASOUND_BRANCHES_SCOPE_EXECUTE(TuningQuantizer, Pitch->Num());
+
+            OutputOnChange->AdvanceBlock();
+
+            UpdateTuning();
+
+            Quantizer.ProcessBuffer(Pitch->GetData(), OutputNote->GetData(), OutputFrequency->GetData(), Pitch->Num(), *Hysteresis,
+                [this](int32 Frame) { OutputOnChange->TriggerFrame(Frame); });
+
+            METASOUND_BRANCHES_COUNT_TRIGGERS(TuningQuantizer, OutputOnChange->NumTriggeredInBlock());
+        }
+
+    private:
+        void GetTuningCents(float (&OutCents)[MetasoundBranches::FTuningTable::NumPitchClasses]) const
+        {
+            OutCents[0] = *TuningCents0;
+            OutCents[1] = *TuningCents1;
+            OutCents[2] = *TuningCents2;
+            OutCents[3] = *TuningCents3;
+            OutCents[4] = *TuningCents4;
+            OutCents[5] = *TuningCents5;
+            OutCents[6] = *TuningCents6;
+            OutCents[7] = *TuningCents7;
+            OutCents[8] = *TuningCents8;
+            OutCents[9] = *TuningCents9;
+            OutCents[10] = *TuningCents10;
+            OutCents[11] = *TuningCents11;
+        }
+
+        // Rebuilds the degree table if the cents or the scale have changed since it was last built
+        void UpdateTuning()
+        {
+            float TuningCentsArray[MetasoundBranches::FTuningTable::NumPitchClasses];
+            GetTuningCents(TuningCentsArray);
+
+            if (bTuningValid && *Scale == LastScale && FMemory::Memcmp(TuningCentsArray, LastCents, sizeof(LastCents)) == 0)
+            {
+                return;
+            }
+
+            Quantizer.SetTuning(TuningCentsArray, *Scale);
+
+            FMemory::Memcpy(LastCents, TuningCentsArray, sizeof(LastCents));
+            LastScale = *Scale;
+            bTuningValid = true;
+        }
+
+        FAudioBufferReadRef Pitch;
+        FFloatReadRef Hysteresis;
+        FInt32ReadRef Scale;
+        FFloatReadRef TuningCents0;
+        FFloatReadRef TuningCents1;
+        FFloatReadRef TuningCents2;
+        FFloatReadRef TuningCents3;
+        FFloatReadRef TuningCents4;
+        FFloatReadRef TuningCents5;
+        FFloatReadRef TuningCents6;
+        FFloatReadRef TuningCents7;
+        FFloatReadRef TuningCents8;
+        FFloatReadRef TuningCents9;
+        FFloatReadRef TuningCents10;
+        FFloatReadRef TuningCents11;
+
+        FAudioBufferWriteRef OutputFrequency;
+        FAudioBufferWriteRef OutputNote;
+        FTriggerWriteRef OutputOnChange;
+
+        MetasoundBranches::FTuningQuantizer Quantizer;
+
+        // Inputs the degree table was last built from
+        float LastCents[MetasoundBranches::FTuningTable::NumPitchClasses] = {};
+        int32 LastScale = 0;
+        bool bTuningValid = false;
+    };
+
+    class FTuningQuantizerNode : public FNodeFacade
+    {
+    public:
+        FTuningQuantizerNode(const FNodeInitData& InitData)
+            : FNodeFacade(InitData.InstanceName, InitData.InstanceID, TFacadeOperatorClass<FTuningQuantizerNodeOperator>())
+        {
+        }
+    };
+
+    METASOUND_REGISTER_NODE(FTuningQuantizerNode);
+    METASOUND_BRANCHES_LIST_NODE(FTuningQuantizerNode);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -1,12 +1,15 @@
 // Copyright 2025 Charles Matthews. All Rights Reserved.
 
 #include "MetasoundBranches/Public/MetasoundZeroCrossingNode.h"
+#include "MetasoundBranches/Public/DSP/ZeroCrossingKernel.h"
 #include "MetasoundExecutableOperator.h"     // TExecutableOperator class
 #include "MetasoundPrimitives.h"             // ReadRef and WriteRef for data types
 #include "MetasoundNodeRegistrationMacro.h"  // METASOUND_LOCTEXT and METASOUND_REGISTER_NODE macros
 #include "MetasoundFacade.h"                 // FNodeFacade class
 #include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
 #include "MetasoundTrigger.h"                // For FTriggerWriteRef and FTrigger
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+#include "MetasoundBranches/Private/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_ZeroCrossing"
 
@@ -19,6 +22,8 @@ namespace Metasound
         METASOUND_PARAM(OutputTriggerZeroCrossing, "Zero Crossing", "Trigger on zero crossing.");
     }
 
+    METASOUND_BRANCHES_DECLARE_NODE_STATS(ZeroCrossing, "Zero Crossing")
+
     class FZeroCrossingOperator : public TExecutableOperator<FZeroCrossingOperator>
     {
     public:
@@ -31,9 +36,7 @@ namespace Metasound
             : InputSignal(InSignal)
             , InputDebounce(InDebounce)
             , OutputTriggerZeroCrossing(FTriggerWriteRef::CreateNew(InSettings))
-            , PreviousSignalValue(0.0f)
             , DebounceSamples(0)
-            , DebounceCounter(0)
             , SampleRate(InSampleRate)
         {
         }
@@ -81,25 +84,19 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace ZeroCrossingNames;
 
-            FDataReferenceCollection InputDataReferences;
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputDebounce), InputDebounce);
-
-            return InputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputDebounce), InputDebounce);
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace ZeroCrossingNames;
 
-            FDataReferenceCollection OutputDataReferences;
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTriggerZeroCrossing), OutputTriggerZeroCrossing);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTriggerZeroCrossing), OutputTriggerZeroCrossing);
         }
 
         static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutErrors)
@@ -125,22 +122,14 @@ namespace Metasound
             // Reset trigger
             OutputTriggerZeroCrossing->Reset();
 
-            // Initialize PreviousSignalValue
-            if (InputSignal->Num() > 0)
-            {
-                PreviousSignalValue = InputSignal->GetData()[0];
-            }
-            else
-            {
-                PreviousSignalValue = 0.0f;
-            }
-
-            // Reset debounce counter
-            DebounceCounter = 0;
+            // Start from the first sample of the incoming signal to prevent a false crossing, and reset the debounce counter
+            ZeroCrossing.Reset(InputSignal->Num() > 0 ? InputSignal->GetData()[0] : 0.0f);
         }
 
         void Execute()
         {
+            METASOUND_BRANCHES_SCOPE_EXECUTE(ZeroCrossing, InputSignal->Num());
+
             OutputTriggerZeroCrossing->AdvanceBlock();
 
             const float* SignalData = InputSignal->GetData();
@@ -150,40 +139,15 @@ namespace Metasound
             // Recalculate debounce samples if debounce time or sample rate has changed
             if (LastDebounceTime != DebounceTime || LastSampleRate != SampleRate)
             {
-                DebounceSamples = FMath::RoundToInt(FMath::Clamp(DebounceTime, 0.001f, 5.0f) * SampleRate);
+                DebounceSamples = MetasoundBranches::FZeroCrossingKernel::GetDebounceSamples(DebounceTime, SampleRate);
                 LastDebounceTime = DebounceTime;
                 LastSampleRate = SampleRate;
             }
 
-            for (int32 i = 0; i < NumFrames; ++i)
-            {
-                float CurrentSignal = SignalData[i];
-
-                if (DebounceCounter > 0)
-                {
-                    DebounceCounter--;
-                }
-
-                bool PreviousNonPositive = (PreviousSignalValue <= 0.0f);
-                bool CurrentPositive = (CurrentSignal > 0.0f);
-                bool PreviousNonNegative = (PreviousSignalValue >= 0.0f);
-                bool CurrentNegative = (CurrentSignal < 0.0f);
-
-                // Crossing from negative or zero to positive
-                if (PreviousNonPositive && CurrentPositive && DebounceCounter <= 0)
-                {
-                    OutputTriggerZeroCrossing->TriggerFrame(i);
-                    DebounceCounter = DebounceSamples;
-                }
-                // Crossing from positive or zero to negative
-                else if (PreviousNonNegative && CurrentNegative && DebounceCounter <= 0)
-                {
-                    OutputTriggerZeroCrossing->TriggerFrame(i);
-                    DebounceCounter = DebounceSamples;
-                }
-
-                PreviousSignalValue = CurrentSignal;
-            }
+            ZeroCrossing.ProcessBuffer(SignalData, NumFrames, DebounceSamples,
+                [this](int32 Frame) { OutputTriggerZeroCrossing->TriggerFrame(Frame); });
+
+            METASOUND_BRANCHES_COUNT_TRIGGERS(ZeroCrossing, OutputTriggerZeroCrossing->NumTriggeredInBlock());
         }
 
     private:
@@ -195,9 +159,8 @@ namespace Metasound
         FTriggerWriteRef OutputTriggerZeroCrossing;
 
         // Internal variables
-        float PreviousSignalValue;
+        MetasoundBranches::FZeroCrossingKernel ZeroCrossing;
         int32 DebounceSamples;
-        int32 DebounceCounter;
         float SampleRate;
 
         // Variables to track changes in debounce time and sample rate
@@ -215,6 +178,7 @@ namespace Metasound
     };
 
     METASOUND_REGISTER_NODE(FZeroCrossingNode);
+    METASOUND_BRANCHES_LIST_NODE(FZeroCrossingNode);
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,302 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DSP/FFTAlgorithm.h"
+#include "Math/VectorRegister.h"
+#include "MetasoundBranches/Public/DSP/AllPassKernel.h"
+
+namespace MetasoundBranches
+{
+    // The Phase Disperser cascade applied as a fixed filter, for high stage counts that don't change.
+    //
+    // With a fixed coefficient the cascade is linear and time-invariant, so it can be replaced by its impulse response,
+    // truncated once what remains is far below audibility. Every stage is a function of z^-2, so only even taps are
+    // non-zero. The first PartitionSize taps run as a direct FIR, which keeps the output free of latency at any block
+    // size. The rest run as uniformly partitioned overlap-save convolution: each completed partition of input is
+    // transformed once and multiplied against every tail partition's spectrum, and the result is due one partition
+    // later, which is exactly where the tail starts.
+    //
+    // The output matches FPhaseDisperserKernel to within the truncation and float rounding, not bit for bit.
+    class FPhaseDisperserConvolutionKernel
+    {
+    public:
+        // Taps in the direct head, and samples per tail partition. Transforms are twice this.
+        static constexpr int32 PartitionSize = 64;
+
+        // Longest response kept; 128 stages need under 900 samples
+        static constexpr int32 MaxImpulseLength = 2048;
+
+        // The response is cut where the energy left in its tail falls below this fraction of the total (-100 dB)
+        static constexpr double TruncationEnergy = 1.0e-10;
+
+        // Builds the filter for InNumFilters stages and clears the history. Returns false if no FFT of the
+        // required size is available on this platform, in which case the caller should keep the IIR cascade.
+        bool Init(int32 InNumFilters)
+        {
+            NumFilters = 0;
+
+            if (!FFT.IsValid())
+            {
+                Audio::FFFTSettings Settings;
+                Settings.Log2Size = FMath::FloorLog2(PartitionSize * 2);
+                Settings.bArrays128BitAligned = false;
+                Settings.bEnableHardwareAcceleration = false;
+
+                FFT = Audio::FFFTFactory::NewFFTAlgorithm(Settings);
+                if (!FFT.IsValid() || FFT->NumOutputFloats() != SpectrumFloats)
+                {
+                    FFT.Reset();
+                    return false;
+                }
+            }
+
+            TArray<float> Impulse;
+            GetImpulseResponse(InNumFilters, Impulse);
+
+            HeadTaps.SetNumZeroed(PartitionSize / 2);
+            for (int32 Tap = 0; Tap < HeadTaps.Num() && Tap * 2 < Impulse.Num(); ++Tap)
+            {
+                HeadTaps[Tap] = Impulse[Tap * 2];
+            }
+
+            NumTailPartitions = FMath::DivideAndRoundUp(FMath::Max(Impulse.Num() - PartitionSize, 0), PartitionSize);
+
+            Frame.SetNumZeroed(PartitionSize * 2);
+            TimeScratch.SetNumZeroed(PartitionSize * 2);
+            TailOutput.SetNumZeroed(PartitionSize);
+            Accumulator.SetNumZeroed(SpectrumFloats);
+            InputSpectra.SetNumZeroed(NumTailPartitions * SpectrumFloats);
+            FilterSpectra.SetNumZeroed(NumTailPartitions * SpectrumFloats);
+
+            // Whatever scaling the FFT applies over a forward and inverse pass is folded into the filter spectra
+            const float RoundTripScale = 1.0f / GetRoundTripGain();
+
+            for (int32 Partition = 0; Partition < NumTailPartitions; ++Partition)
+            {
+                const int32 FirstTap = PartitionSize * (Partition + 1);
+                const int32 NumTaps = FMath::Min(PartitionSize, Impulse.Num() - FirstTap);
+
+                FMemory::Memzero(TimeScratch.GetData(), TimeScratch.Num() * sizeof(float));
+                for (int32 Tap = 0; Tap < NumTaps; ++Tap)
+                {
+                    TimeScratch[Tap] = Impulse[FirstTap + Tap] * RoundTripScale;
+                }
+
+                FFT->ForwardRealToComplex(TimeScratch.GetData(), FilterSpectra.GetData() + Partition * SpectrumFloats);
+            }
+
+            NumFilters = FMath::Clamp(InNumFilters, 1, FPhaseDisperserKernel::MaxAllowedFilters);
+            Reset();
+            return true;
+        }
+
+        // Stage count the filter was built for, or 0 if it hasn't been built
+        int32 GetNumFilters() const
+        {
+            return NumFilters;
+        }
+
+        void Reset()
+        {
+            FMemory::Memzero(Frame.GetData(), Frame.Num() * sizeof(float));
+            FMemory::Memzero(TailOutput.GetData(), TailOutput.Num() * sizeof(float));
+            FMemory::Memzero(InputSpectra.GetData(), InputSpectra.Num() * sizeof(float));
+            FramePosition = 0;
+            NewestSpectrum = 0;
+        }
+
+        SIZE_T GetAllocatedSize() const
+        {
+            return HeadTaps.GetAllocatedSize() + Frame.GetAllocatedSize() + TimeScratch.GetAllocatedSize() + TailOutput.GetAllocatedSize()
+                + Accumulator.GetAllocatedSize() + InputSpectra.GetAllocatedSize() + FilterSpectra.GetAllocatedSize();
+        }
+
+        // InSignal and OutSignal may point to the same buffer
+        void Process(const float* InSignal, float* OutSignal, int32 NumSamples)
+        {
+            check(NumFilters > 0);
+
+            const float* Taps = HeadTaps.GetData();
+            const int32 NumHeadTaps = HeadTaps.Num();
+
+            int32 i = 0;
+            while (i < NumSamples)
+            {
+                const int32 NumRun = FMath::Min(NumSamples - i, PartitionSize - FramePosition);
+
+                // The frame holds the previous partition and then the current one, so the head always has
+                // PartitionSize samples of history behind the sample being produced
+                float* Current = Frame.GetData() + PartitionSize + FramePosition;
+                FMemory::Memcpy(Current, InSignal + i, NumRun * sizeof(float));
+
+                for (int32 j = 0; j < NumRun; ++j)
+                {
+                    const float* Input = Current + j;
+                    float Sum = TailOutput[FramePosition + j];
+
+                    for (int32 Tap = 0; Tap < NumHeadTaps; ++Tap)
+                    {
+                        Sum += Taps[Tap] * Input[-2 * Tap];
+                    }
+
+                    OutSignal[i + j] = Sum;
+                }
+
+                i += NumRun;
+                FramePosition += NumRun;
+
+                if (FramePosition == PartitionSize)
+                {
+                    ProcessPartition();
+                    FramePosition = 0;
+                }
+            }
+        }
+
+        // The cascade's response to a unit impulse, worked out in double precision and truncated
+        static void GetImpulseResponse(int32 InNumFilters, TArray<float>& OutImpulse)
+        {
+            const int32 CurrentNumFilters = FMath::Clamp(InNumFilters, 1, FPhaseDisperserKernel::MaxAllowedFilters);
+            const double Feedback = FPhaseDisperserKernel::Feedback;
+
+            TArray<double> Response;
+            Response.SetNumZeroed(MaxImpulseLength);
+            Response[0] = 1.0;
+
+            // One stage at a time over the whole response: y[n] = -a * x[n] + x[n - 2] + a * y[n - 2]
+            for (int32 Stage = 0; Stage < CurrentNumFilters; ++Stage)
+            {
+                double In[2] = { 0.0, 0.0 };
+                double Out[2] = { 0.0, 0.0 };
+
+                for (int32 n = 0; n < MaxImpulseLength; ++n)
+                {
+                    const int32 Slot = n & 1;
+                    const double Input = Response[n];
+                    const double Output = -Feedback * Input + In[Slot] + Feedback * Out[Slot];
+
+                    In[Slot] = Input;
+                    Out[Slot] = Output;
+                    Response[n] = Output;
+                }
+            }
+
+            double TotalEnergy = 0.0;
+            for (double Sample : Response)
+            {
+                TotalEnergy += Sample * Sample;
+            }
+
+            int32 Length = MaxImpulseLength;
+            double TailEnergy = 0.0;
+            while (Length > 1)
+            {
+                const double Sample = Response[Length - 1];
+                if (TailEnergy + Sample * Sample >= TruncationEnergy * TotalEnergy)
+                {
+                    break;
+                }
+                TailEnergy += Sample * Sample;
+                --Length;
+            }
+
+            OutImpulse.SetNumUninitialized(Length);
+            for (int32 n = 0; n < Length; ++n)
+            {
+                OutImpulse[n] = static_cast<float>(Response[n]);
+            }
+        }
+
+    private:
+        // Complex bins of a real transform of twice the partition size, interleaved real and imaginary
+        static constexpr int32 SpectrumFloats = (PartitionSize + 1) * 2;
+
+        // Runs once per completed partition of input: adds it to the spectrum history and works out the tail's
+        // contribution to the next partition of output
+        void ProcessPartition()
+        {
+            if (NumTailPartitions > 0)
+            {
+                NewestSpectrum = (NewestSpectrum + 1) % NumTailPartitions;
+                FFT->ForwardRealToComplex(Frame.GetData(), InputSpectra.GetData() + NewestSpectrum * SpectrumFloats);
+
+                FMemory::Memzero(Accumulator.GetData(), SpectrumFloats * sizeof(float));
+                for (int32 Partition = 0; Partition < NumTailPartitions; ++Partition)
+                {
+                    const int32 InputIndex = (NewestSpectrum - Partition + NumTailPartitions) % NumTailPartitions;
+                    ComplexMultiplyAdd(FilterSpectra.GetData() + Partition * SpectrumFloats, InputSpectra.GetData() + InputIndex * SpectrumFloats, Accumulator.GetData());
+                }
+
+                // Overlap-save: the second half of the inverse is the valid part
+                FFT->InverseComplexToReal(Accumulator.GetData(), TimeScratch.GetData());
+                FMemory::Memcpy(TailOutput.GetData(), TimeScratch.GetData() + PartitionSize, PartitionSize * sizeof(float));
+            }
+
+            FMemory::Memcpy(Frame.GetData(), Frame.GetData() + PartitionSize, PartitionSize * sizeof(float));
+        }
+
+        // Out += A * B over interleaved complex bins, two bins per register
+        static void ComplexMultiplyAdd(const float* A, const float* B, float* Out)
+        {
+            const VectorRegister4Float Signs = MakeVectorRegisterFloat(-1.0f, 1.0f, -1.0f, 1.0f);
+
+            int32 i = 0;
+            for (; i + 4 <= SpectrumFloats; i += 4)
+            {
+                const VectorRegister4Float ValueA = VectorLoad(A + i);
+                const VectorRegister4Float ValueB = VectorLoad(B + i);
+
+                const VectorRegister4Float RealA = VectorSwizzle(ValueA, 0, 0, 2, 2);
+                const VectorRegister4Float ImagA = VectorSwizzle(ValueA, 1, 1, 3, 3);
+                const VectorRegister4Float SwappedB = VectorSwizzle(ValueB, 1, 0, 3, 2);
+
+                // (ar * br - ai * bi, ar * bi + ai * br)
+                const VectorRegister4Float Product = VectorMultiplyAdd(RealA, ValueB, VectorMultiply(ImagA, VectorMultiply(SwappedB, Signs)));
+                VectorStore(VectorAdd(VectorLoad(Out + i), Product), Out + i);
+            }
+
+            for (; i < SpectrumFloats; i += 2)
+            {
+                Out[i] += A[i] * B[i] - A[i + 1] * B[i + 1];
+                Out[i + 1] += A[i] * B[i + 1] + A[i + 1] * B[i];
+            }
+        }
+
+        // Gain of a unit impulse through a forward and inverse pass, which depends on the FFT implementation
+        float GetRoundTripGain()
+        {
+            FMemory::Memzero(TimeScratch.GetData(), TimeScratch.Num() * sizeof(float));
+            TimeScratch[0] = 1.0f;
+
+            FFT->ForwardRealToComplex(TimeScratch.GetData(), Accumulator.GetData());
+            FFT->InverseComplexToReal(Accumulator.GetData(), TimeScratch.GetData());
+
+            return TimeScratch[0] != 0.0f ? TimeScratch[0] : 1.0f;
+        }
+
+        TUniquePtr<Audio::IFFTAlgorithm> FFT;
+
+        int32 NumFilters = 0;
+        int32 NumTailPartitions = 0;
+
+        // Even taps of the first partition
+        TArray<float> HeadTaps;
+
+        // Previous partition of input followed by the one being filled
+        TArray<float> Frame;
+        int32 FramePosition = 0;
+
+        // Tail output for the partition being filled, worked out when the previous partition completed
+        TArray<float> TailOutput;
+
+        // One spectrum per tail partition. Input spectra are a ring, newest at NewestSpectrum.
+        TArray<float> FilterSpectra;
+        TArray<float> InputSpectra;
+        int32 NewestSpectrum = 0;
+
+        TArray<float> Accumulator;
+        TArray<float> TimeScratch;
+    };
+}
@@ -0,0 +1,361 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/VectorRegister.h"
+
+namespace MetasoundBranches
+{
+    // Cascade of allpass stages used by Phase Disperser.
+    //
+    // Each stage is y[n] = -a * x[n] + d[n] followed by d[n] = x[n] + a * y[n], alternating between two delay slots,
+    // so a stage is two floats. Stages live inline in the kernel up to NumInlineFilters and move to a single
+    // contiguous heap block beyond that. Storage is sized to the stage count in use and only grows.
+    class FPhaseDisperserKernel
+    {
+    public:
+        // Maximum number of allowed allpass filters
+        static constexpr int32 MaxAllowedFilters = 128;
+
+        // Stages stored without a heap allocation
+        static constexpr int32 NumInlineFilters = 8;
+
+        static constexpr float Feedback = 0.5f;
+
+        explicit FPhaseDisperserKernel(int32 InNumFilters = 1)
+        {
+            Reserve(InNumFilters);
+        }
+
+        // Makes room for InNumFilters stages. New stages start silent, as stages that have never run did before.
+        void Reserve(int32 InNumFilters)
+        {
+            const int32 NumFilters = FMath::Clamp(InNumFilters, 1, MaxAllowedFilters);
+
+            if (NumFilters > Stages.Num())
+            {
+                Stages.SetNumZeroed(NumFilters);
+            }
+        }
+
+        void Reset()
+        {
+            for (FStage& Stage : Stages)
+            {
+                Stage = FStage();
+            }
+        }
+
+        int32 GetNumAllocatedFilters() const
+        {
+            return Stages.Num();
+        }
+
+        // Heap memory held by the kernel, zero while the stages fit inline
+        SIZE_T GetAllocatedSize() const
+        {
+            return Stages.GetAllocatedSize();
+        }
+
+        // Runs the first InNumFilters stages over the buffer in place, growing the storage if needed
+        void ProcessInPlace(float* InOutBuffer, int32 NumSamples, int32 InNumFilters)
+        {
+            const int32 CurrentNumFilters = FMath::Clamp(InNumFilters, 1, MaxAllowedFilters);
+            Reserve(CurrentNumFilters);
+
+            for (int32 i = 0; i < CurrentNumFilters; ++i)
+            {
+                ProcessStage(Stages[i], InOutBuffer, NumSamples);
+            }
+        }
+
+    private:
+        // Delay[0] is always the slot read by the next sample
+        struct FStage
+        {
+            float Delay[2] = { 0.0f, 0.0f };
+        };
+
+        static void ProcessStage(FStage& Stage, float* InOutBuffer, int32 NumSamples)
+        {
+            float Delay0 = Stage.Delay[0];
+            float Delay1 = Stage.Delay[1];
+
+            int32 i = 0;
+            for (; i + 1 < NumSamples; i += 2)
+            {
+                const float In0 = InOutBuffer[i];
+                const float Out0 = -Feedback * In0 + Delay0;
+                Delay0 = In0 + Feedback * Out0;
+
+                const float In1 = InOutBuffer[i + 1];
+                const float Out1 = -Feedback * In1 + Delay1;
+                Delay1 = In1 + Feedback * Out1;
+
+                InOutBuffer[i] = Out0;
+                InOutBuffer[i + 1] = Out1;
+            }
+
+            if (i < NumSamples)
+            {
+                // An odd-length block ends halfway through the pair, so the other slot is read next
+                const float In0 = InOutBuffer[i];
+                const float Out0 = -Feedback * In0 + Delay0;
+                InOutBuffer[i] = Out0;
+
+                Stage.Delay[0] = Delay1;
+                Stage.Delay[1] = In0 + Feedback * Out0;
+            }
+            else
+            {
+                Stage.Delay[0] = Delay0;
+                Stage.Delay[1] = Delay1;
+            }
+        }
+
+        TArray<FStage, TInlineAllocator<NumInlineFilters>> Stages;
+    };
+
+    // The same cascade for several channels at once. Channels are processed four to a vector register, so a
+    // stereo or quad disperser runs one stage loop rather than one per channel.
+    //
+    // Every channel has its own feedback coefficient per stage, which lets channels be slightly decorrelated.
+    // With every coefficient at Feedback, each channel matches FPhaseDisperserKernel exactly.
+    class FMultichannelPhaseDisperserKernel
+    {
+    public:
+        static constexpr int32 MaxAllowedFilters = FPhaseDisperserKernel::MaxAllowedFilters;
+        static constexpr int32 LaneWidth = 4;
+
+        // Keeps every stage stable
+        static constexpr float MaxFeedback = 0.99f;
+
+        explicit FMultichannelPhaseDisperserKernel(int32 InNumChannels = 2, int32 InNumFilters = 1)
+        {
+            Init(InNumChannels, InNumFilters);
+        }
+
+        void Init(int32 InNumChannels, int32 InNumFilters = 1)
+        {
+            NumChannels = FMath::Max(InNumChannels, 1);
+            NumGroups = (NumChannels + LaneWidth - 1) / LaneWidth;
+
+            ChannelFeedback.Reset();
+            ChannelFeedback.SetNum(NumChannels);
+            for (FChannelCoefficients& Coefficients : ChannelFeedback)
+            {
+                Coefficients.Add(FPhaseDisperserKernel::Feedback);
+            }
+
+            Stages.Reset();
+            NumAllocatedFilters = 0;
+            Reserve(InNumFilters);
+        }
+
+        int32 GetNumChannels() const
+        {
+            return NumChannels;
+        }
+
+        int32 GetNumAllocatedFilters() const
+        {
+            return NumAllocatedFilters;
+        }
+
+        SIZE_T GetAllocatedSize() const
+        {
+            SIZE_T Size = Stages.GetAllocatedSize() + ChannelFeedback.GetAllocatedSize();
+            for (const FChannelCoefficients& Coefficients : ChannelFeedback)
+            {
+                Size += Coefficients.GetAllocatedSize();
+            }
+            return Size;
+        }
+
+        // Sets one coefficient per stage for a channel. Stages past the end of the list use its last value.
+        void SetChannelFeedback(int32 InChannel, TArrayView<const float> InFeedbackPerStage)
+        {
+            if (!ChannelFeedback.IsValidIndex(InChannel) || InFeedbackPerStage.Num() == 0)
+            {
+                return;
+            }
+
+            FChannelCoefficients& Coefficients = ChannelFeedback[InChannel];
+            Coefficients.Reset();
+            for (float Coefficient : InFeedbackPerStage)
+            {
+                Coefficients.Add(FMath::Clamp(Coefficient, -MaxFeedback, MaxFeedback));
+            }
+
+            for (int32 Stage = 0; Stage < NumAllocatedFilters; ++Stage)
+            {
+                GetLanes(Stage, InChannel / LaneWidth).Feedback[InChannel % LaneWidth] = GetChannelFeedback(InChannel, Stage);
+            }
+        }
+
+        // Sets the same coefficient on every stage of a channel
+        void SetChannelFeedback(int32 InChannel, float InFeedback)
+        {
+            SetChannelFeedback(InChannel, TArrayView<const float>(&InFeedback, 1));
+        }
+
+        void Reserve(int32 InNumFilters)
+        {
+            const int32 NumFilters = FMath::Clamp(InNumFilters, 1, MaxAllowedFilters);
+
+            if (NumFilters > NumAllocatedFilters)
+            {
+                Stages.SetNumZeroed(NumFilters * NumGroups);
+
+                for (int32 Stage = NumAllocatedFilters; Stage < NumFilters; ++Stage)
+                {
+                    for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+                    {
+                        GetLanes(Stage, Channel / LaneWidth).Feedback[Channel % LaneWidth] = GetChannelFeedback(Channel, Stage);
+                    }
+                }
+
+                NumAllocatedFilters = NumFilters;
+            }
+        }
+
+        void Reset()
+        {
+            for (FStageLanes& Lanes : Stages)
+            {
+                for (int32 Lane = 0; Lane < LaneWidth; ++Lane)
+                {
+                    Lanes.Delay0[Lane] = 0.0f;
+                    Lanes.Delay1[Lane] = 0.0f;
+                }
+            }
+        }
+
+        // Runs the first InNumFilters stages over one buffer per channel, in place
+        void ProcessInPlace(TArrayView<float* const> InOutChannels, int32 NumSamples, int32 InNumFilters)
+        {
+            const int32 CurrentNumFilters = FMath::Clamp(InNumFilters, 1, MaxAllowedFilters);
+            Reserve(CurrentNumFilters);
+
+            alignas(16) float Frames[ChunkFrames * LaneWidth];
+            const int32 NumActiveChannels = FMath::Min(NumChannels, InOutChannels.Num());
+
+            for (int32 Group = 0; Group < NumGroups; ++Group)
+            {
+                const int32 FirstChannel = Group * LaneWidth;
+                const int32 NumLanes = FMath::Clamp(NumActiveChannels - FirstChannel, 0, LaneWidth);
+
+                for (int32 ChunkStart = 0; ChunkStart < NumSamples; ChunkStart += ChunkFrames)
+                {
+                    const int32 NumChunkFrames = FMath::Min(ChunkFrames, NumSamples - ChunkStart);
+
+                    // Unused lanes run on silence
+                    for (int32 Lane = 0; Lane < LaneWidth; ++Lane)
+                    {
+                        const float* Channel = Lane < NumLanes ? InOutChannels[FirstChannel + Lane] + ChunkStart : nullptr;
+                        for (int32 i = 0; i < NumChunkFrames; ++i)
+                        {
+                            Frames[i * LaneWidth + Lane] = Channel ? Channel[i] : 0.0f;
+                        }
+                    }
+
+                    for (int32 Stage = 0; Stage < CurrentNumFilters; ++Stage)
+                    {
+                        ProcessStage(GetLanes(Stage, Group), Frames, NumChunkFrames);
+                    }
+
+                    for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+                    {
+                        float* Channel = InOutChannels[FirstChannel + Lane] + ChunkStart;
+                        for (int32 i = 0; i < NumChunkFrames; ++i)
+                        {
+                            Channel[i] = Frames[i * LaneWidth + Lane];
+                        }
+                    }
+                }
+            }
+        }
+
+    private:
+        // Frames interleaved on the stack per pass. Even, so a full chunk leaves each stage's delays in the same
+        // slots as the whole block would, and chunked output matches unchunked exactly.
+        static constexpr int32 ChunkFrames = 128;
+        static_assert(ChunkFrames % 2 == 0, "ProcessStage works on pairs of frames");
+
+        // One stage for four channels. Delay0 is always the slot read by the next frame, as in FPhaseDisperserKernel.
+        struct FStageLanes
+        {
+            float Delay0[LaneWidth];
+            float Delay1[LaneWidth];
+            float Feedback[LaneWidth];
+        };
+
+        FStageLanes& GetLanes(int32 InStage, int32 InGroup)
+        {
+            return Stages[InStage * NumGroups + InGroup];
+        }
+
+        float GetChannelFeedback(int32 InChannel, int32 InStage) const
+        {
+            const FChannelCoefficients& Coefficients = ChannelFeedback[InChannel];
+            return Coefficients[FMath::Min(InStage, Coefficients.Num() - 1)];
+        }
+
+        // Same operation order as FPhaseDisperserKernel::ProcessStage, one frame of four channels per register
+        static void ProcessStage(FStageLanes& Lanes, float* InOutFrames, int32 NumSamples)
+        {
+            const VectorRegister4Float Feedback = VectorLoad(Lanes.Feedback);
+            const VectorRegister4Float NegativeFeedback = VectorNegate(Feedback);
+
+            VectorRegister4Float Delay0 = VectorLoad(Lanes.Delay0);
+            VectorRegister4Float Delay1 = VectorLoad(Lanes.Delay1);
+
+            int32 i = 0;
+            for (; i + 1 < NumSamples; i += 2)
+            {
+                float* Frame0 = InOutFrames + i * LaneWidth;
+                float* Frame1 = Frame0 + LaneWidth;
+
+                const VectorRegister4Float In0 = VectorLoad(Frame0);
+                const VectorRegister4Float Out0 = VectorAdd(VectorMultiply(NegativeFeedback, In0), Delay0);
+                Delay0 = VectorAdd(In0, VectorMultiply(Feedback, Out0));
+
+                const VectorRegister4Float In1 = VectorLoad(Frame1);
+                const VectorRegister4Float Out1 = VectorAdd(VectorMultiply(NegativeFeedback, In1), Delay1);
+                Delay1 = VectorAdd(In1, VectorMultiply(Feedback, Out1));
+
+                VectorStore(Out0, Frame0);
+                VectorStore(Out1, Frame1);
+            }
+
+            if (i < NumSamples)
+            {
+                float* Frame0 = InOutFrames + i * LaneWidth;
+
+                const VectorRegister4Float In0 = VectorLoad(Frame0);
+                const VectorRegister4Float Out0 = VectorAdd(VectorMultiply(NegativeFeedback, In0), Delay0);
+                VectorStore(Out0, Frame0);
+
+                VectorStore(Delay1, Lanes.Delay0);
+                VectorStore(VectorAdd(In0, VectorMultiply(Feedback, Out0)), Lanes.Delay1);
+            }
+            else
+            {
+                VectorStore(Delay0, Lanes.Delay0);
+                VectorStore(Delay1, Lanes.Delay1);
+            }
+        }
+
+        int32 NumChannels = 0;
+        int32 NumGroups = 0;
+        int32 NumAllocatedFilters = 0;
+
+        // Inline up to the mono kernel's inline stage count for a single group, so a stereo or quad disperser at
+        // a modest stage count builds without touching the heap. Most channels use one coefficient for every stage.
+        using FChannelCoefficients = TArray<float, TInlineAllocator<1>>;
+
+        TArray<FStageLanes, TInlineAllocator<FPhaseDisperserKernel::NumInlineFilters>> Stages;
+        TArray<FChannelCoefficients, TInlineAllocator<LaneWidth>> ChannelFeedback;
+    };
+}
@@ -0,0 +1,71 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace MetasoundBranches
+{
+    // Eight-step counter behind Clock Divider. Each input trigger advances the count and returns the outputs
+    // that fire on it, one bit per output: the first output fires on every trigger, the others on the counts
+    // that divide by their number within the cycle of eight.
+    class FClockDividerKernel
+    {
+    public:
+        static constexpr int32 NumOutputs = 8;
+
+        void Reset()
+        {
+            Counter = 0;
+        }
+
+        // Bit n set means output n + 1 fires
+        uint32 Advance()
+        {
+            static constexpr uint32 OutputMasks[NumOutputs] =
+            {
+                0x01,   // 1
+                0x03,   // 1, 2
+                0x05,   // 1, 3
+                0x0B,   // 1, 2, 4
+                0x11,   // 1, 5
+                0x27,   // 1, 2, 3, 6
+                0x41,   // 1, 7
+                0x8B    // 1, 2, 4, 8
+            };
+
+            Counter = (Counter + 1) % NumOutputs;
+            return OutputMasks[Counter];
+        }
+
+        // Calls OnTrigger(Frame, Mask) for each of InNumTriggers input triggers. Resets are applied in frame order
+        // with the triggers, so the count doesn't depend on where block boundaries fall; a reset on the same frame
+        // as a trigger is applied first, and resets after the last trigger still clear the count.
+        template <typename TriggerFrameFuncType, typename ResetFrameFuncType, typename OnTriggerFuncType>
+        void ProcessTriggers(int32 InNumTriggers, TriggerFrameFuncType&& GetTriggerFrame, int32 InNumResets, ResetFrameFuncType&& GetResetFrame, OnTriggerFuncType&& OnTrigger)
+        {
+            int32 ResetIndex = 0;
+
+            for (int32 TriggerIndex = 0; TriggerIndex < InNumTriggers; ++TriggerIndex)
+            {
+                const int32 Frame = GetTriggerFrame(TriggerIndex);
+
+                while (ResetIndex < InNumResets && GetResetFrame(ResetIndex) <= Frame)
+                {
+                    Reset();
+                    ++ResetIndex;
+                }
+
+                OnTrigger(Frame, Advance());
+            }
+
+            if (ResetIndex < InNumResets)
+            {
+                Reset();
+            }
+        }
+
+    private:
+        int32 Counter = 0;
+    };
+}
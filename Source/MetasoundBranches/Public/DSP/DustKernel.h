@@ -0,0 +1,121 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MetasoundBranches/Public/DSP/SparseBuffer.h"
+
+namespace MetasoundBranches
+{
+    // Linear congruential generator with the same constants as FRandomStream, kept here with unsigned arithmetic
+    // so the single-voice and voice-batched Dust kernels produce identical sequences from the same seed.
+    struct FDustRandom
+    {
+        static uint32 Next(uint32 InSeed)
+        {
+            return InSeed * 196314165U + 907633515U;
+        }
+
+        // Uniform value in [0, 1) from the top 23 bits of the seed
+        static float ToFraction(uint32 InSeed)
+        {
+            const uint32 Bits = 0x3F800000U | (InSeed >> 9);
+            float Result;
+            FMemory::Memcpy(&Result, &Bits, sizeof(Result));
+            return Result - 1.0f;
+        }
+    };
+
+    // Randomly timed single-sample impulses, as used by Dust (Audio)
+    class FDustKernel
+    {
+    public:
+        // Scales density into a per-sample probability
+        static constexpr float DensityScale = 0.0009f;
+
+        explicit FDustKernel(uint32 InSeed = 0)
+            : InitialSeed(InSeed)
+            , Seed(InSeed)
+        {
+        }
+
+        // Rewinds to the seed given at construction
+        void Reset()
+        {
+            Seed = InitialSeed;
+            SignalIsPositive = true;
+        }
+
+        // Writes one block of impulses, zeros included. Density is the modulation input per sample plus a constant offset.
+        // Returns the number of impulses written.
+        int32 ProcessBuffer(const float* InDensity, float InDensityOffset, bool bBiPolar, float* OutSignal, int32 NumFrames)
+        {
+            FMemory::Memzero(OutSignal, NumFrames * sizeof(float));
+
+            auto Write = [OutSignal](int32 Frame, float Value)
+            {
+                OutSignal[Frame] = Value;
+            };
+
+            return bBiPolar
+                ? GenerateImpulses<true>(InDensity, InDensityOffset, NumFrames, Write)
+                : GenerateImpulses<false>(InDensity, InDensityOffset, NumFrames, Write);
+        }
+
+        // As ProcessBuffer, but only clears the frames the writer wrote last block, so a sparse output
+        // costs the random draws and the impulses rather than a full pass over the buffer.
+        int32 ProcessSparse(const float* InDensity, float InDensityOffset, bool bBiPolar, float* OutSignal, int32 NumFrames, FSparseBufferWriter& Writer)
+        {
+            Writer.Clear(OutSignal, NumFrames);
+
+            auto Write = [OutSignal, &Writer](int32 Frame, float Value)
+            {
+                Writer.Write(OutSignal, Frame, Value);
+            };
+
+            return bBiPolar
+                ? GenerateImpulses<true>(InDensity, InDensityOffset, NumFrames, Write)
+                : GenerateImpulses<false>(InDensity, InDensityOffset, NumFrames, Write);
+        }
+
+    private:
+        // Calls OnImpulse(Frame, Value) for each impulse in the block. Polarity is a template parameter so the
+        // loop carries no flag tests; the callers pick the instantiation once per block.
+        template <bool bBiPolar, typename ImpulseFuncType>
+        int32 GenerateImpulses(const float* InDensity, float InDensityOffset, int32 NumFrames, ImpulseFuncType&& OnImpulse)
+        {
+            int32 NumImpulses = 0;
+
+            for (int32 i = 0; i < NumFrames; ++i)
+            {
+                const float AbsDensity = FMath::Abs(InDensity[i]) + InDensityOffset;
+                const float Threshold = 1.0f - AbsDensity * DensityScale;
+
+                Seed = FDustRandom::Next(Seed);
+
+                if (FDustRandom::ToFraction(Seed) > Threshold)
+                {
+                    ++NumImpulses;
+
+                    if constexpr (bBiPolar)
+                    {
+                        OnImpulse(i, SignalIsPositive ? 1.0f : -1.0f);
+                        SignalIsPositive = !SignalIsPositive;
+                    }
+                    else
+                    {
+                        OnImpulse(i, 1.0f);
+                    }
+                }
+            }
+
+            return NumImpulses;
+        }
+
+        uint32 InitialSeed = 0;
+        uint32 Seed = 0;
+
+        // Toggle flag for polarity
+        bool SignalIsPositive = true;
+    };
+}
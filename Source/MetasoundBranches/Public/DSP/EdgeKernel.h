@@ -0,0 +1,65 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace MetasoundBranches
+{
+    // Rising/falling edge detection with debounce, as used by Edge.
+    // A rise is only reported after a fall (and vice versa), and not within the debounce period of the last edge.
+    class FEdgeKernel
+    {
+    public:
+        static int32 GetDebounceSamples(float InDebounceSeconds, float InSampleRate)
+        {
+            return FMath::RoundToInt(FMath::Clamp(InDebounceSeconds, 0.001f, 5.0f) * InSampleRate);
+        }
+
+        void Reset(float InPreviousValue = 0.0f)
+        {
+            PreviousSignalValue = InPreviousValue;
+            PreviousIsRising = false;
+            DebounceCounter = 0;
+        }
+
+        // Calls OnRise(Frame) or OnFall(Frame) for every edge in the block
+        template <typename RiseFuncType, typename FallFuncType>
+        void ProcessBuffer(const float* InSignal, int32 NumFrames, int32 InDebounceSamples, RiseFuncType&& OnRise, FallFuncType&& OnFall)
+        {
+            for (int32 i = 0; i < NumFrames; ++i)
+            {
+                float CurrentSignal = InSignal[i];
+
+                // Decrement debounce counter
+                if (DebounceCounter > 0)
+                {
+                    DebounceCounter--;
+                }
+
+                // Detect rising edge
+                if (CurrentSignal > PreviousSignalValue && !PreviousIsRising && DebounceCounter <= 0)
+                {
+                    OnRise(i);
+                    DebounceCounter = InDebounceSamples;
+                    PreviousIsRising = true;
+                }
+                // Detect falling edge
+                else if (CurrentSignal < PreviousSignalValue && PreviousIsRising && DebounceCounter <= 0)
+                {
+                    OnFall(i);
+                    DebounceCounter = InDebounceSamples;
+                    PreviousIsRising = false;
+                }
+
+                // Update previous signal value
+                PreviousSignalValue = CurrentSignal;
+            }
+        }
+
+    private:
+        float PreviousSignalValue = 0.0f;
+        bool PreviousIsRising = false;
+        int32 DebounceCounter = 0;
+    };
+}
@@ -0,0 +1,371 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/VectorRegister.h"
+#include "MetasoundBranches/Public/DSP/SlewKernel.h"
+
+namespace MetasoundBranches
+{
+    enum class EEnvelopeFollowerMode : uint8
+    {
+        // Rectified signal, smoothed
+        Peak,
+
+        // Squared signal, smoothed, then square rooted
+        RMS,
+
+        // Root mean square over a sliding window, then smoothed
+        WindowedRMS
+    };
+
+    // Envelope follower built on the attack/release recurrence of FSlewKernel: attack is the rise time and
+    // release the fall time. Rectifying and smoothing are one pass over the input, a chunk at a time, so the
+    // detector signal never leaves the stack.
+    //
+    // With a decimation factor above one the recurrence runs once per group of samples, on the group's peak
+    // or mean square, and the output holds the last update until the next group completes. Groups run on across
+    // blocks, so the output doesn't depend on the block size. The peak reduction vectorizes; the mean square is
+    // summed in sample order in double precision, so where a block boundary falls can't change its rounding.
+    class FEnvelopeFollowerKernel
+    {
+    public:
+        static constexpr float MaxWindowSeconds = 1.0f;
+
+        // Samples rectified at a time before smoothing
+        static constexpr int32 ChunkSize = 64;
+
+        static EEnvelopeFollowerMode GetMode(int32 InMode)
+        {
+            return static_cast<EEnvelopeFollowerMode>(FMath::Clamp(InMode, 0, 2));
+        }
+
+        // Window history needed for the longest window at a sample rate
+        static int32 GetMaxWindowSamples(float InSampleRate)
+        {
+            return FMath::Max(FMath::RoundToInt(MaxWindowSeconds * InSampleRate), 1);
+        }
+
+        // Largest |x| in the buffer
+        static float GetPeak(const float* InSignal, int32 NumSamples)
+        {
+            VectorRegister4Float Peak = VectorZeroFloat();
+
+            int32 i = 0;
+            for (; i + 4 <= NumSamples; i += 4)
+            {
+                Peak = VectorMax(Peak, VectorAbs(VectorLoad(InSignal + i)));
+            }
+
+            alignas(16) float Lanes[4];
+            VectorStoreAligned(Peak, Lanes);
+
+            float Result = FMath::Max(FMath::Max(Lanes[0], Lanes[1]), FMath::Max(Lanes[2], Lanes[3]));
+            for (; i < NumSamples; ++i)
+            {
+                Result = FMath::Max(Result, FMath::Abs(InSignal[i]));
+            }
+
+            return Result;
+        }
+
+        void Reset()
+        {
+            Smoother.Reset();
+
+            if (Window.Num() > 0)
+            {
+                FMemory::Memzero(Window.GetData(), Window.Num() * sizeof(float));
+            }
+            WindowSum = 0.0;
+            WindowPosition = 0;
+            NumSinceWindowSum = 0;
+
+            ClearGroup();
+        }
+
+        // Switches the detector, converting the smoothed state between amplitude and power so the output doesn't jump
+        void SetMode(EEnvelopeFollowerMode InMode)
+        {
+            if (InMode == Mode)
+            {
+                return;
+            }
+
+            const float Value = GetValue();
+            Mode = InMode;
+            Smoother.Reset(Mode == EEnvelopeFollowerMode::RMS ? Value * Value : Value);
+
+            // A part-finished group holds the old detector's reduction
+            ClearGroup();
+        }
+
+        // Allocates the WindowedRMS history for windows up to InMaxNumSamples long and clears it. Call this before
+        // processing, off the audio thread; nothing else allocates.
+        void InitWindow(int32 InMaxNumSamples)
+        {
+            Window.SetNumZeroed(FMath::Max(InMaxNumSamples, 1));
+            WindowLength = FMath::Clamp(WindowLength, 1, Window.Num());
+            WindowSum = 0.0;
+            WindowPosition = 0;
+            NumSinceWindowSum = 0;
+        }
+
+        // Sets the sliding window for WindowedRMS, up to the length given to InitWindow. The history is kept across
+        // a change, so the new window is summed from the most recent samples rather than starting from silence.
+        void SetWindowLength(int32 InNumSamples)
+        {
+            const int32 NumSamples = FMath::Clamp(InNumSamples, 1, Window.Num() > 0 ? Window.Num() : MAX_int32);
+            if (NumSamples == WindowLength)
+            {
+                return;
+            }
+
+            WindowLength = NumSamples;
+            if (Window.Num() > 0)
+            {
+                SumWindow();
+            }
+        }
+
+        SIZE_T GetAllocatedSize() const
+        {
+            return Window.GetAllocatedSize();
+        }
+
+        // Current envelope in signal units
+        float GetValue() const
+        {
+            const float State = Smoother.GetValue();
+            return (Mode == EEnvelopeFollowerMode::RMS) ? FMath::Sqrt(FMath::Max(State, 0.0f)) : State;
+        }
+
+        // Writes the envelope of InSignal to OutEnvelope and returns its last value. The alphas are per sample,
+        // from FSlewKernel::GetAlpha; a decimation of one updates the envelope on every sample.
+        float ProcessBuffer(const float* InSignal, float* OutEnvelope, int32 NumSamples, float InAttackAlpha, float InReleaseAlpha, int32 InDecimation = 1)
+        {
+            // Callers that never set up the history get one just long enough for the current window
+            if (Mode == EEnvelopeFollowerMode::WindowedRMS && Window.Num() == 0)
+            {
+                InitWindow(WindowLength);
+            }
+
+            if (InDecimation > 1)
+            {
+                ProcessDecimated(InSignal, OutEnvelope, NumSamples, InAttackAlpha, InReleaseAlpha, InDecimation);
+            }
+            else
+            {
+                ClearGroup();
+
+                for (int32 Start = 0; Start < NumSamples; Start += ChunkSize)
+                {
+                    ProcessChunk(InSignal + Start, OutEnvelope + Start, FMath::Min(ChunkSize, NumSamples - Start), InAttackAlpha, InReleaseAlpha);
+                }
+            }
+
+            return GetValue();
+        }
+
+    private:
+        // Pushes one squared sample into the history and returns the mean square of the last WindowLength samples
+        float PushWindow(float InSquare)
+        {
+            const int32 NumHistory = Window.Num();
+
+            int32 Leaving = WindowPosition - WindowLength;
+            if (Leaving < 0)
+            {
+                Leaving += NumHistory;
+            }
+
+            WindowSum += InSquare - Window[Leaving];
+            Window[WindowPosition] = InSquare;
+
+            if (++WindowPosition == NumHistory)
+            {
+                WindowPosition = 0;
+            }
+
+            // Re-sum once per window so rounding in the running sum can't build up
+            if (++NumSinceWindowSum >= WindowLength)
+            {
+                SumWindow();
+            }
+
+            return static_cast<float>(FMath::Max(WindowSum, 0.0) / WindowLength);
+        }
+
+        // Sums the last WindowLength samples of the history from scratch
+        void SumWindow()
+        {
+            double Sum = 0.0;
+            int32 Index = WindowPosition;
+
+            for (int32 i = 0; i < WindowLength; ++i)
+            {
+                if (--Index < 0)
+                {
+                    Index = Window.Num() - 1;
+                }
+                Sum += Window[Index];
+            }
+
+            WindowSum = Sum;
+            NumSinceWindowSum = 0;
+        }
+
+        void ProcessChunk(const float* InSignal, float* OutEnvelope, int32 NumSamples, float InAttackAlpha, float InReleaseAlpha)
+        {
+            // Rectify or square four at a time
+            alignas(16) float Detector[ChunkSize];
+
+            int32 i = 0;
+            if (Mode == EEnvelopeFollowerMode::Peak)
+            {
+                for (; i + 4 <= NumSamples; i += 4)
+                {
+                    VectorStoreAligned(VectorAbs(VectorLoad(InSignal + i)), Detector + i);
+                }
+                for (; i < NumSamples; ++i)
+                {
+                    Detector[i] = FMath::Abs(InSignal[i]);
+                }
+            }
+            else
+            {
+                for (; i + 4 <= NumSamples; i += 4)
+                {
+                    const VectorRegister4Float Sample = VectorLoad(InSignal + i);
+                    VectorStoreAligned(VectorMultiply(Sample, Sample), Detector + i);
+                }
+                for (; i < NumSamples; ++i)
+                {
+                    Detector[i] = InSignal[i] * InSignal[i];
+                }
+            }
+
+            switch (Mode)
+            {
+            case EEnvelopeFollowerMode::Peak:
+                Smoother.ProcessBuffer(Detector, OutEnvelope, NumSamples, InAttackAlpha, InReleaseAlpha);
+                break;
+
+            case EEnvelopeFollowerMode::RMS:
+                for (i = 0; i < NumSamples; ++i)
+                {
+                    OutEnvelope[i] = FMath::Sqrt(Smoother.ProcessSample(Detector[i], InAttackAlpha, InReleaseAlpha));
+                }
+                break;
+
+            case EEnvelopeFollowerMode::WindowedRMS:
+                for (i = 0; i < NumSamples; ++i)
+                {
+                    OutEnvelope[i] = Smoother.ProcessSample(FMath::Sqrt(PushWindow(Detector[i])), InAttackAlpha, InReleaseAlpha);
+                }
+                break;
+            }
+        }
+
+        void ProcessDecimated(const float* InSignal, float* OutEnvelope, int32 NumSamples, float InAttackAlpha, float InReleaseAlpha, int32 InDecimation)
+        {
+            // One update covers a whole group, so the per-sample alphas are raised to the group length
+            const float GroupAttackAlpha = FMath::Pow(InAttackAlpha, static_cast<float>(InDecimation));
+            const float GroupReleaseAlpha = FMath::Pow(InReleaseAlpha, static_cast<float>(InDecimation));
+
+            for (int32 Start = 0; Start < NumSamples;)
+            {
+                // Take the rest of the group, or as much of it as this block has. A group begun before the decimation
+                // was lowered is already past its end and closes on its next sample.
+                const int32 NumTaken = FMath::Clamp(InDecimation - GroupPhase, 1, NumSamples - Start);
+                const float* GroupSignal = InSignal + Start;
+
+                switch (Mode)
+                {
+                case EEnvelopeFollowerMode::Peak:
+                    GroupPeak = FMath::Max(GroupPeak, GetPeak(GroupSignal, NumTaken));
+                    break;
+
+                case EEnvelopeFollowerMode::RMS:
+                    for (int32 i = 0; i < NumTaken; ++i)
+                    {
+                        GroupSumOfSquares += static_cast<double>(GroupSignal[i]) * GroupSignal[i];
+                    }
+                    break;
+
+                case EEnvelopeFollowerMode::WindowedRMS:
+                    // The window still moves a sample at a time; only the smoothing is decimated
+                    for (int32 i = 0; i < NumTaken; ++i)
+                    {
+                        GroupMeanSquare = PushWindow(GroupSignal[i] * GroupSignal[i]);
+                    }
+                    break;
+                }
+
+                GroupPhase += NumTaken;
+
+                // Hold the last update until the group completes, then update on its final sample
+                const float Held = GetValue();
+                for (int32 i = 0; i < NumTaken; ++i)
+                {
+                    OutEnvelope[Start + i] = Held;
+                }
+
+                if (GroupPhase >= InDecimation)
+                {
+                    const bool bFullGroup = GroupPhase == InDecimation;
+                    const float AttackAlpha = bFullGroup ? GroupAttackAlpha : FMath::Pow(InAttackAlpha, static_cast<float>(GroupPhase));
+                    const float ReleaseAlpha = bFullGroup ? GroupReleaseAlpha : FMath::Pow(InReleaseAlpha, static_cast<float>(GroupPhase));
+
+                    switch (Mode)
+                    {
+                    case EEnvelopeFollowerMode::Peak:
+                        Smoother.ProcessSample(GroupPeak, AttackAlpha, ReleaseAlpha);
+                        break;
+
+                    case EEnvelopeFollowerMode::RMS:
+                        Smoother.ProcessSample(static_cast<float>(GroupSumOfSquares / GroupPhase), AttackAlpha, ReleaseAlpha);
+                        break;
+
+                    case EEnvelopeFollowerMode::WindowedRMS:
+                        Smoother.ProcessSample(FMath::Sqrt(GroupMeanSquare), AttackAlpha, ReleaseAlpha);
+                        break;
+                    }
+
+                    OutEnvelope[Start + NumTaken - 1] = GetValue();
+                    ClearGroup();
+                }
+
+                Start += NumTaken;
+            }
+        }
+
+        void ClearGroup()
+        {
+            GroupPhase = 0;
+            GroupPeak = 0.0f;
+            GroupSumOfSquares = 0.0;
+            GroupMeanSquare = 0.0f;
+        }
+
+        // Smoothed detector: amplitude for Peak and WindowedRMS, power for RMS
+        FSlewKernel Smoother;
+        EEnvelopeFollowerMode Mode = EEnvelopeFollowerMode::Peak;
+
+        // History of squared samples for WindowedRMS, as long as the longest window. WindowSum covers the last
+        // WindowLength of them.
+        TArray<float> Window;
+        double WindowSum = 0.0;
+        int32 WindowLength = 1;
+        int32 WindowPosition = 0;
+        int32 NumSinceWindowSum = 0;
+
+        // The decimation group in progress, which may have started in an earlier block: samples taken so far,
+        // and their peak, sum of squares or latest window mean square
+        int32 GroupPhase = 0;
+        float GroupPeak = 0.0f;
+        double GroupSumOfSquares = 0.0;
+        float GroupMeanSquare = 0.0f;
+    };
+}
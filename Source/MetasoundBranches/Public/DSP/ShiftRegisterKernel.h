@@ -0,0 +1,41 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace MetasoundBranches
+{
+    // Eight-stage shift register, as used by Shift Register. Each shift moves every stage along one and loads the
+    // first stage with the new value.
+    class FShiftRegisterKernel
+    {
+    public:
+        static constexpr int32 NumStages = 8;
+
+        void Reset()
+        {
+            for (float& Stage : Stages)
+            {
+                Stage = 0.0f;
+            }
+        }
+
+        void Shift(float InValue)
+        {
+            for (int32 Stage = NumStages - 1; Stage > 0; --Stage)
+            {
+                Stages[Stage] = Stages[Stage - 1];
+            }
+            Stages[0] = InValue;
+        }
+
+        float GetStage(int32 Index) const
+        {
+            return Stages[Index];
+        }
+
+    private:
+        float Stages[NumStages] = {};
+    };
+}
@@ -0,0 +1,237 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace MetasoundBranches
+{
+    // One-pole slew with separate rise and fall coefficients.
+    // Shared by Slew (Audio), Slew (Float), Bool To Audio and the render harness.
+    class FSlewKernel
+    {
+    public:
+        // Alpha = exp(-1 / (time * sample rate)), a zero time passes the target straight through
+        static float GetAlpha(float InTimeSeconds, float InSampleRate)
+        {
+            return (InTimeSeconds > 0.0f) ? FMath::Exp(-1.0f / (InTimeSeconds * InSampleRate)) : 0.0f;
+        }
+
+        void Reset(float InValue = 0.0f)
+        {
+            PreviousOutputSample = InValue;
+        }
+
+        float GetValue() const
+        {
+            return PreviousOutputSample;
+        }
+
+        float ProcessSample(float InTarget, float InRiseAlpha, float InFallAlpha)
+        {
+            float OutputSample = PreviousOutputSample;
+
+            if (InTarget > PreviousOutputSample)
+            {
+                OutputSample = InRiseAlpha * PreviousOutputSample + (1.0f - InRiseAlpha) * InTarget;
+            }
+            else if (InTarget < PreviousOutputSample)
+            {
+                OutputSample = InFallAlpha * PreviousOutputSample + (1.0f - InFallAlpha) * InTarget;
+            }
+            else
+            {
+                OutputSample = InTarget;
+            }
+
+            PreviousOutputSample = OutputSample;
+            return OutputSample;
+        }
+
+        // InSignal and OutSignal may point to the same buffer
+        void ProcessBuffer(const float* InSignal, float* OutSignal, int32 NumSamples, float InRiseAlpha, float InFallAlpha)
+        {
+            for (int32 i = 0; i < NumSamples; ++i)
+            {
+                OutSignal[i] = ProcessSample(InSignal[i], InRiseAlpha, InFallAlpha);
+            }
+        }
+
+        // Slews towards a target that is constant for the whole buffer
+        void ProcessConstant(float InTarget, float* OutSignal, int32 NumSamples, float InRiseAlpha, float InFallAlpha)
+        {
+            for (int32 i = 0; i < NumSamples; ++i)
+            {
+                OutSignal[i] = ProcessSample(InTarget, InRiseAlpha, InFallAlpha);
+            }
+        }
+
+        // Jumps to where the slew would be after InElapsedSeconds towards a held target, in one step.
+        // Equivalent to ProcessConstant at any rate, so the result doesn't depend on how time is divided into blocks.
+        float ProcessElapsed(float InTarget, float InElapsedSeconds, float InRiseTime, float InFallTime)
+        {
+            const float TimeSeconds = (InTarget > PreviousOutputSample) ? InRiseTime : InFallTime;
+
+            PreviousOutputSample = (TimeSeconds > 0.0f)
+                ? InTarget + (PreviousOutputSample - InTarget) * FMath::Exp(-InElapsedSeconds / TimeSeconds)
+                : InTarget;
+
+            return PreviousOutputSample;
+        }
+
+    private:
+        float PreviousOutputSample = 0.0f;
+    };
+
+    // Linear slew: the output moves towards the target by at most a fixed step per sample, so a time is the
+    // time taken to move by 1.0 rather than a time constant. Each sample is the target clamped to a window
+    // around the previous output, so the target is reached exactly.
+    class FLinearSlewKernel
+    {
+    public:
+        // Largest change per sample for a time per unit change; a zero time jumps straight to the target
+        static float GetStep(float InTimeSeconds, float InSampleRate)
+        {
+            return (InTimeSeconds > 0.0f) ? 1.0f / (InTimeSeconds * InSampleRate) : TNumericLimits<float>::Max();
+        }
+
+        void Reset(float InValue = 0.0f)
+        {
+            PreviousOutputSample = InValue;
+            bWasAtTarget = false;
+        }
+
+        float GetValue() const
+        {
+            return PreviousOutputSample;
+        }
+
+        float ProcessSample(float InTarget, float InRiseStep, float InFallStep)
+        {
+            PreviousOutputSample = FMath::Clamp(InTarget, PreviousOutputSample - InFallStep, PreviousOutputSample + InRiseStep);
+            return PreviousOutputSample;
+        }
+
+        // Calls OnReached(Frame) when the output arrives at the target after being held back by the step limit,
+        // so a signal the slew can follow exactly does not fire on every sample.
+        // InSignal and OutSignal may point to the same buffer.
+        template <typename ReachedFuncType>
+        void ProcessBuffer(const float* InSignal, float* OutSignal, int32 NumSamples, float InRiseStep, float InFallStep, ReachedFuncType&& OnReached)
+        {
+            float Previous = PreviousOutputSample;
+            bool bAtTarget = bWasAtTarget;
+
+            for (int32 i = 0; i < NumSamples; ++i)
+            {
+                const float Target = InSignal[i];
+                const float Output = FMath::Clamp(Target, Previous - InFallStep, Previous + InRiseStep);
+
+                const bool bReached = Output == Target;
+                if (bReached && !bAtTarget && Output != Previous)
+                {
+                    OnReached(i);
+                }
+
+                bAtTarget = bReached;
+                Previous = Output;
+                OutSignal[i] = Output;
+            }
+
+            PreviousOutputSample = Previous;
+            bWasAtTarget = bAtTarget;
+        }
+
+        // Moves towards a target held for the whole buffer. Each sample depends only on the value at the start
+        // of the buffer, so the loop has no carried dependency and vectorizes. Returns the frame the target was
+        // reached on, following the same rule as ProcessBuffer, or INDEX_NONE.
+        int32 ProcessConstant(float InTarget, float* OutSignal, int32 NumSamples, float InRiseStep, float InFallStep)
+        {
+            const float Start = PreviousOutputSample;
+
+            for (int32 i = 0; i < NumSamples; ++i)
+            {
+                OutSignal[i] = GetConstantSample(InTarget, Start, i, InRiseStep, InFallStep);
+            }
+
+            if (NumSamples <= 0)
+            {
+                return INDEX_NONE;
+            }
+
+            int32 ReachedFrame = INDEX_NONE;
+            if (OutSignal[NumSamples - 1] == InTarget)
+            {
+                // The output is monotonic, so the first frame on the target is the arrival
+                int32 FirstFrame = 0;
+                while (OutSignal[FirstFrame] != InTarget)
+                {
+                    ++FirstFrame;
+                }
+
+                ReachedFrame = GetReachedFrame(FirstFrame, Start, InTarget);
+            }
+
+            PreviousOutputSample = OutSignal[NumSamples - 1];
+            bWasAtTarget = PreviousOutputSample == InTarget;
+            return ReachedFrame;
+        }
+
+        // As ProcessConstant without writing the block, for callers that only need the value at the end of it.
+        // The arrival is found by a binary search over the same closed form, so the result and the reached frame
+        // match ProcessConstant exactly.
+        int32 AdvanceConstant(float InTarget, int32 NumSamples, float InRiseStep, float InFallStep)
+        {
+            if (NumSamples <= 0)
+            {
+                return INDEX_NONE;
+            }
+
+            const float Start = PreviousOutputSample;
+            const float LastSample = GetConstantSample(InTarget, Start, NumSamples - 1, InRiseStep, InFallStep);
+
+            int32 ReachedFrame = INDEX_NONE;
+            if (LastSample == InTarget)
+            {
+                int32 Low = 0;
+                int32 High = NumSamples - 1;
+
+                while (Low < High)
+                {
+                    const int32 Middle = Low + (High - Low) / 2;
+                    if (GetConstantSample(InTarget, Start, Middle, InRiseStep, InFallStep) == InTarget)
+                    {
+                        High = Middle;
+                    }
+                    else
+                    {
+                        Low = Middle + 1;
+                    }
+                }
+
+                ReachedFrame = GetReachedFrame(Low, Start, InTarget);
+            }
+
+            PreviousOutputSample = LastSample;
+            bWasAtTarget = LastSample == InTarget;
+            return ReachedFrame;
+        }
+
+    private:
+        static float GetConstantSample(float InTarget, float InStart, int32 InFrame, float InRiseStep, float InFallStep)
+        {
+            const float NumSteps = static_cast<float>(InFrame + 1);
+            return FMath::Clamp(InTarget, InStart - NumSteps * InFallStep, InStart + NumSteps * InRiseStep);
+        }
+
+        // Arriving on the first frame only counts if the previous block ended held back
+        int32 GetReachedFrame(int32 InFirstFrame, float InStart, float InTarget) const
+        {
+            return (InFirstFrame > 0 || (!bWasAtTarget && InStart != InTarget)) ? InFirstFrame : INDEX_NONE;
+        }
+
+        float PreviousOutputSample = 0.0f;
+
+        // Whether the last output sample equalled its target, so that Reached only fires on arrival
+        bool bWasAtTarget = false;
+    };
+}
@@ -0,0 +1,81 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace MetasoundBranches
+{
+    // Keeps an output buffer that is mostly zeros clean by remembering which frames were written, so each block
+    // only clears last block's events instead of the whole buffer. Used by the impulse generators.
+    //
+    // Anything that may have written to the buffer behind the writer's back (a reset, a rebound output)
+    // should call MarkDirty, which makes the next Clear zero the whole buffer.
+    class FSparseBufferWriter
+    {
+    public:
+        // Past this many events in a block, clearing everything is as cheap as clearing frame by frame
+        static constexpr int32 MaxTrackedFrames = 32;
+
+        void MarkDirty()
+        {
+            bDirty = true;
+            WrittenFrames.Reset();
+        }
+
+        // The caller has zeroed the whole buffer itself
+        void MarkZeroed()
+        {
+            bDirty = false;
+            WrittenFrames.Reset();
+        }
+
+        // Zeros whatever was written since the last Clear. Returns false if nothing needed clearing.
+        bool Clear(float* OutBuffer, int32 NumFrames)
+        {
+            if (bDirty)
+            {
+                FMemory::Memzero(OutBuffer, NumFrames * sizeof(float));
+                bDirty = false;
+                return true;
+            }
+
+            if (WrittenFrames.Num() == 0)
+            {
+                return false;
+            }
+
+            for (int32 Frame : WrittenFrames)
+            {
+                OutBuffer[Frame] = 0.0f;
+            }
+            WrittenFrames.Reset();
+            return true;
+        }
+
+        void Write(float* OutBuffer, int32 Frame, float InValue)
+        {
+            OutBuffer[Frame] = InValue;
+
+            if (bDirty)
+            {
+                return;
+            }
+
+            if (WrittenFrames.Num() < MaxTrackedFrames)
+            {
+                WrittenFrames.Add(Frame);
+            }
+            else
+            {
+                MarkDirty();
+            }
+        }
+
+    private:
+        TArray<int32, TInlineAllocator<MaxTrackedFrames>> WrittenFrames;
+
+        // Starts dirty so the first block clears whatever the buffer was created with
+        bool bDirty = true;
+    };
+}
@@ -0,0 +1,559 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/VectorRegister.h"
+
+// Block processing for the stereo utility nodes.
+// Every function reads both input samples of a frame before writing it, so outputs may alias inputs.
+namespace MetasoundBranches
+{
+    // Equal-power gains for a balance of -1.0 (full left) to 1.0 (full right)
+    inline void GetBalanceGains(float InBalance, float& OutLeftGain, float& OutRightGain)
+    {
+        const float Balance = FMath::Clamp(InBalance, -1.0f, 1.0f);
+        const float Angle = (Balance + 1.0f) * (PI / 4.0f);
+
+        OutLeftGain = FMath::Cos(Angle);
+        OutRightGain = FMath::Sin(Angle);
+    }
+
+    // Equal-power gains for a crossfade of 0.0 (first input) to 1.0 (second input)
+    inline void GetCrossfadeGains(float InCrossfade, float& OutGain1, float& OutGain2)
+    {
+        const float CrossfadeFactor = FMath::Clamp(InCrossfade, 0.0f, 1.0f);
+
+        OutGain1 = FMath::Cos(CrossfadeFactor * HALF_PI);
+        OutGain2 = FMath::Sin(CrossfadeFactor * HALF_PI);
+    }
+
+    // 2x2 mix applied to a stereo frame: OutL = LL * InL + LR * InR, OutR = RL * InL + RR * InR
+    struct FStereoMatrix
+    {
+        float LL = 1.0f;
+        float LR = 0.0f;
+        float RL = 0.0f;
+        float RR = 1.0f;
+    };
+
+    // Folds Stereo Inverter -> Stereo Width -> Stereo Balance -> Stereo Gain into one matrix.
+    // Each stage is linear, so the product gives the same result as running them in sequence.
+    inline FStereoMatrix GetStereoStripMatrix(bool bInvertLeft, bool bInvertRight, bool bSwap, float InWidth, float InBalance, float InGain)
+    {
+        const float LMult = bInvertLeft ? -1.0f : 1.0f;
+        const float RMult = bInvertRight ? -1.0f : 1.0f;
+
+        // Inverter: which input feeds each side, and its sign
+        const float InvLL = bSwap ? 0.0f : LMult;
+        const float InvLR = bSwap ? LMult : 0.0f;
+        const float InvRL = bSwap ? RMult : 0.0f;
+        const float InvRR = bSwap ? 0.0f : RMult;
+
+        // Width: Mid +/- Side, with Side scaled by the width factor
+        const float WidthFactor = FMath::Clamp(InWidth, 0.0f, 2.0f);
+        const float Direct = 0.5f + 0.5f * WidthFactor;
+        const float Cross = 0.5f - 0.5f * WidthFactor;
+
+        float LeftGain;
+        float RightGain;
+        GetBalanceGains(InBalance, LeftGain, RightGain);
+        LeftGain *= InGain;
+        RightGain *= InGain;
+
+        FStereoMatrix Matrix;
+        Matrix.LL = LeftGain * (Direct * InvLL + Cross * InvRL);
+        Matrix.LR = LeftGain * (Direct * InvLR + Cross * InvRR);
+        Matrix.RL = RightGain * (Cross * InvLL + Direct * InvRL);
+        Matrix.RR = RightGain * (Cross * InvLR + Direct * InvRR);
+        return Matrix;
+    }
+
+    // Plain per-sample loops. These are the reference the vector paths below are checked against,
+    // and also handle the frames left over after the last full vector.
+    namespace Scalar
+    {
+        inline void ProcessStereoGain(const float* InLeft, const float* InRight, float* OutLeft, float* OutRight, int32 NumFrames, float InGain)
+        {
+            for (int32 i = 0; i < NumFrames; ++i)
+            {
+                OutLeft[i] = InLeft[i] * InGain;
+                OutRight[i] = InRight[i] * InGain;
+            }
+        }
+
+        // Balance with the gains already worked out by GetBalanceGains
+        inline void ProcessStereoBalanceGains(const float* InLeft, const float* InRight, float* OutLeft, float* OutRight, int32 NumFrames, float InLeftGain, float InRightGain)
+        {
+            for (int32 i = 0; i < NumFrames; ++i)
+            {
+                OutLeft[i] = InLeft[i] * InLeftGain;
+                OutRight[i] = InRight[i] * InRightGain;
+            }
+        }
+
+        inline void ProcessStereoBalance(const float* InLeft, const float* InRight, float* OutLeft, float* OutRight, int32 NumFrames, float InBalance)
+        {
+            float LeftGain;
+            float RightGain;
+            GetBalanceGains(InBalance, LeftGain, RightGain);
+
+            ProcessStereoBalanceGains(InLeft, InRight, OutLeft, OutRight, NumFrames, LeftGain, RightGain);
+        }
+
+        // Mid-side width, 0.0 (mono) to 2.0 (200%)
+        inline void ProcessStereoWidth(const float* InLeft, const float* InRight, float* OutLeft, float* OutRight, int32 NumFrames, float InWidth)
+        {
+            const float WidthFactor = FMath::Clamp(InWidth, 0.0f, 2.0f);
+
+            for (int32 i = 0; i < NumFrames; ++i)
+            {
+                const float Left = InLeft[i];
+                const float Right = InRight[i];
+
+                const float Mid = 0.5f * (Left + Right);
+                const float Side = 0.5f * (Left - Right) * WidthFactor;
+
+                OutLeft[i] = Mid + Side;
+                OutRight[i] = Mid - Side;
+            }
+        }
+
+        inline void ProcessStereoInverter(const float* InLeft, const float* InRight, float* OutLeft, float* OutRight, int32 NumFrames, bool bInvertLeft, bool bInvertRight, bool bSwap)
+        {
+            const float LMult = bInvertLeft ? -1.0f : 1.0f;
+            const float RMult = bInvertRight ? -1.0f : 1.0f;
+
+            for (int32 i = 0; i < NumFrames; ++i)
+            {
+                const float LIn = InLeft[i];
+                const float RIn = InRight[i];
+
+                if (bSwap)
+                {
+                    OutLeft[i] = RIn * LMult;
+                    OutRight[i] = LIn * RMult;
+                }
+                else
+                {
+                    OutLeft[i] = LIn * LMult;
+                    OutRight[i] = RIn * RMult;
+                }
+            }
+        }
+
+        // Crossfade with the gains already worked out by GetCrossfadeGains
+        inline void ProcessStereoCrossfadeGains(
+            const float* InLeft1, const float* InRight1,
+            const float* InLeft2, const float* InRight2,
+            float* OutLeft, float* OutRight, int32 NumFrames, float InGain1, float InGain2)
+        {
+            for (int32 i = 0; i < NumFrames; ++i)
+            {
+                OutLeft[i] = InGain1 * InLeft1[i] + InGain2 * InLeft2[i];
+                OutRight[i] = InGain1 * InRight1[i] + InGain2 * InRight2[i];
+            }
+        }
+
+        inline void ProcessStereoCrossfade(
+            const float* InLeft1, const float* InRight1,
+            const float* InLeft2, const float* InRight2,
+            float* OutLeft, float* OutRight, int32 NumFrames, float InCrossfade)
+        {
+            float Gain1;
+            float Gain2;
+            GetCrossfadeGains(InCrossfade, Gain1, Gain2);
+
+            ProcessStereoCrossfadeGains(InLeft1, InRight1, InLeft2, InRight2, OutLeft, OutRight, NumFrames, Gain1, Gain2);
+        }
+
+        inline void ProcessStereoMatrix(const float* InLeft, const float* InRight, float* OutLeft, float* OutRight, int32 NumFrames, const FStereoMatrix& InMatrix)
+        {
+            for (int32 i = 0; i < NumFrames; ++i)
+            {
+                const float Left = InLeft[i];
+                const float Right = InRight[i];
+
+                OutLeft[i] = InMatrix.LL * Left + InMatrix.LR * Right;
+                OutRight[i] = InMatrix.RL * Left + InMatrix.RR * Right;
+            }
+        }
+
+        // Audio-rate variants: each frame's control value is the block-rate value plus that frame's modulation sample
+
+        inline void ProcessStereoBalanceModulated(const float* InLeft, const float* InRight, const float* InModulation, float* OutLeft, float* OutRight, int32 NumFrames, float InBalance)
+        {
+            for (int32 i = 0; i < NumFrames; ++i)
+            {
+                float LeftGain;
+                float RightGain;
+                GetBalanceGains(InBalance + InModulation[i], LeftGain, RightGain);
+
+                OutLeft[i] = InLeft[i] * LeftGain;
+                OutRight[i] = InRight[i] * RightGain;
+            }
+        }
+
+        inline void ProcessStereoWidthModulated(const float* InLeft, const float* InRight, const float* InModulation, float* OutLeft, float* OutRight, int32 NumFrames, float InWidth)
+        {
+            for (int32 i = 0; i < NumFrames; ++i)
+            {
+                const float WidthFactor = FMath::Clamp(InWidth + InModulation[i], 0.0f, 2.0f);
+
+                const float Left = InLeft[i];
+                const float Right = InRight[i];
+
+                const float Mid = 0.5f * (Left + Right);
+                const float Side = 0.5f * (Left - Right) * WidthFactor;
+
+                OutLeft[i] = Mid + Side;
+                OutRight[i] = Mid - Side;
+            }
+        }
+
+        inline void ProcessStereoCrossfadeModulated(
+            const float* InLeft1, const float* InRight1,
+            const float* InLeft2, const float* InRight2,
+            const float* InModulation,
+            float* OutLeft, float* OutRight, int32 NumFrames, float InCrossfade)
+        {
+            for (int32 i = 0; i < NumFrames; ++i)
+            {
+                float Gain1;
+                float Gain2;
+                GetCrossfadeGains(InCrossfade + InModulation[i], Gain1, Gain2);
+
+                OutLeft[i] = Gain1 * InLeft1[i] + Gain2 * InLeft2[i];
+                OutRight[i] = Gain1 * InRight1[i] + Gain2 * InRight2[i];
+            }
+        }
+    }
+
+    // Vector paths, four frames at a time using the engine's vector registers (SSE or NEON depending on the target).
+    // Loads and stores are unaligned, so any buffer offset is fine.
+    constexpr int32 StereoKernelVectorWidth = 4;
+
+    inline void ProcessStereoGain(const float* InLeft, const float* InRight, float* OutLeft, float* OutRight, int32 NumFrames, float InGain)
+    {
+        const int32 NumVectorFrames = NumFrames & ~(StereoKernelVectorWidth - 1);
+        const VectorRegister4Float Gain = VectorSetFloat1(InGain);
+
+        for (int32 i = 0; i < NumVectorFrames; i += StereoKernelVectorWidth)
+        {
+            const VectorRegister4Float Left = VectorLoad(InLeft + i);
+            const VectorRegister4Float Right = VectorLoad(InRight + i);
+
+            VectorStore(VectorMultiply(Left, Gain), OutLeft + i);
+            VectorStore(VectorMultiply(Right, Gain), OutRight + i);
+        }
+
+        Scalar::ProcessStereoGain(InLeft + NumVectorFrames, InRight + NumVectorFrames, OutLeft + NumVectorFrames, OutRight + NumVectorFrames, NumFrames - NumVectorFrames, InGain);
+    }
+
+    // Balance with the gains already worked out by GetBalanceGains, for callers that can keep them between blocks
+    inline void ProcessStereoBalanceGains(const float* InLeft, const float* InRight, float* OutLeft, float* OutRight, int32 NumFrames, float InLeftGain, float InRightGain)
+    {
+        const int32 NumVectorFrames = NumFrames & ~(StereoKernelVectorWidth - 1);
+        const VectorRegister4Float LeftGainVector = VectorSetFloat1(InLeftGain);
+        const VectorRegister4Float RightGainVector = VectorSetFloat1(InRightGain);
+
+        for (int32 i = 0; i < NumVectorFrames; i += StereoKernelVectorWidth)
+        {
+            const VectorRegister4Float Left = VectorLoad(InLeft + i);
+            const VectorRegister4Float Right = VectorLoad(InRight + i);
+
+            VectorStore(VectorMultiply(Left, LeftGainVector), OutLeft + i);
+            VectorStore(VectorMultiply(Right, RightGainVector), OutRight + i);
+        }
+
+        Scalar::ProcessStereoBalanceGains(InLeft + NumVectorFrames, InRight + NumVectorFrames, OutLeft + NumVectorFrames, OutRight + NumVectorFrames, NumFrames - NumVectorFrames, InLeftGain, InRightGain);
+    }
+
+    inline void ProcessStereoBalance(const float* InLeft, const float* InRight, float* OutLeft, float* OutRight, int32 NumFrames, float InBalance)
+    {
+        float LeftGain;
+        float RightGain;
+        GetBalanceGains(InBalance, LeftGain, RightGain);
+
+        ProcessStereoBalanceGains(InLeft, InRight, OutLeft, OutRight, NumFrames, LeftGain, RightGain);
+    }
+
+    // Mid-side width, 0.0 (mono) to 2.0 (200%)
+    inline void ProcessStereoWidth(const float* InLeft, const float* InRight, float* OutLeft, float* OutRight, int32 NumFrames, float InWidth)
+    {
+        const float WidthFactor = FMath::Clamp(InWidth, 0.0f, 2.0f);
+
+        const int32 NumVectorFrames = NumFrames & ~(StereoKernelVectorWidth - 1);
+        const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+        const VectorRegister4Float Width = VectorSetFloat1(WidthFactor);
+
+        for (int32 i = 0; i < NumVectorFrames; i += StereoKernelVectorWidth)
+        {
+            const VectorRegister4Float Left = VectorLoad(InLeft + i);
+            const VectorRegister4Float Right = VectorLoad(InRight + i);
+
+            // Same operation order as the scalar loop so results match exactly
+            const VectorRegister4Float Mid = VectorMultiply(Half, VectorAdd(Left, Right));
+            const VectorRegister4Float Side = VectorMultiply(VectorMultiply(Half, VectorSubtract(Left, Right)), Width);
+
+            VectorStore(VectorAdd(Mid, Side), OutLeft + i);
+            VectorStore(VectorSubtract(Mid, Side), OutRight + i);
+        }
+
+        Scalar::ProcessStereoWidth(InLeft + NumVectorFrames, InRight + NumVectorFrames, OutLeft + NumVectorFrames, OutRight + NumVectorFrames, NumFrames - NumVectorFrames, InWidth);
+    }
+
+    // One instantiation per flag combination, so each body is a plain copy, negate or swap with no tests inside the loop
+    template <bool bInvertLeft, bool bInvertRight, bool bSwap>
+    void ProcessStereoInverterFlags(const float* InLeft, const float* InRight, float* OutLeft, float* OutRight, int32 NumFrames)
+    {
+        if constexpr (!bInvertLeft && !bInvertRight && !bSwap)
+        {
+            // Identity: nothing to do in place, otherwise a copy
+            if (OutLeft != InLeft)
+            {
+                FMemory::Memcpy(OutLeft, InLeft, NumFrames * sizeof(float));
+            }
+            if (OutRight != InRight)
+            {
+                FMemory::Memcpy(OutRight, InRight, NumFrames * sizeof(float));
+            }
+            return;
+        }
+
+        const float* LeftSource = bSwap ? InRight : InLeft;
+        const float* RightSource = bSwap ? InLeft : InRight;
+
+        int32 i = 0;
+        for (; i + StereoKernelVectorWidth <= NumFrames; i += StereoKernelVectorWidth)
+        {
+            VectorRegister4Float Left = VectorLoad(LeftSource + i);
+            VectorRegister4Float Right = VectorLoad(RightSource + i);
+
+            if constexpr (bInvertLeft)
+            {
+                Left = VectorNegate(Left);
+            }
+            if constexpr (bInvertRight)
+            {
+                Right = VectorNegate(Right);
+            }
+
+            VectorStore(Left, OutLeft + i);
+            VectorStore(Right, OutRight + i);
+        }
+
+        for (; i < NumFrames; ++i)
+        {
+            const float Left = LeftSource[i];
+            const float Right = RightSource[i];
+
+            OutLeft[i] = bInvertLeft ? -Left : Left;
+            OutRight[i] = bInvertRight ? -Right : Right;
+        }
+    }
+
+    // Picks the instantiation for the flags once per block
+    inline void ProcessStereoInverter(const float* InLeft, const float* InRight, float* OutLeft, float* OutRight, int32 NumFrames, bool bInvertLeft, bool bInvertRight, bool bSwap)
+    {
+        using FInverterFunction = void (*)(const float*, const float*, float*, float*, int32);
+
+        // Indexed by InvertLeft | InvertRight << 1 | Swap << 2
+        static constexpr FInverterFunction Functions[8] =
+        {
+            &ProcessStereoInverterFlags<false, false, false>,
+            &ProcessStereoInverterFlags<true, false, false>,
+            &ProcessStereoInverterFlags<false, true, false>,
+            &ProcessStereoInverterFlags<true, true, false>,
+            &ProcessStereoInverterFlags<false, false, true>,
+            &ProcessStereoInverterFlags<true, false, true>,
+            &ProcessStereoInverterFlags<false, true, true>,
+            &ProcessStereoInverterFlags<true, true, true>,
+        };
+
+        const int32 Index = (bInvertLeft ? 1 : 0) | (bInvertRight ? 2 : 0) | (bSwap ? 4 : 0);
+        Functions[Index](InLeft, InRight, OutLeft, OutRight, NumFrames);
+    }
+
+    // Crossfade with the gains already worked out by GetCrossfadeGains, for callers that can keep them between blocks
+    inline void ProcessStereoCrossfadeGains(
+        const float* InLeft1, const float* InRight1,
+        const float* InLeft2, const float* InRight2,
+        float* OutLeft, float* OutRight, int32 NumFrames, float InGain1, float InGain2)
+    {
+        const int32 NumVectorFrames = NumFrames & ~(StereoKernelVectorWidth - 1);
+        const VectorRegister4Float Gain1Vector = VectorSetFloat1(InGain1);
+        const VectorRegister4Float Gain2Vector = VectorSetFloat1(InGain2);
+
+        for (int32 i = 0; i < NumVectorFrames; i += StereoKernelVectorWidth)
+        {
+            const VectorRegister4Float Left = VectorAdd(VectorMultiply(Gain1Vector, VectorLoad(InLeft1 + i)), VectorMultiply(Gain2Vector, VectorLoad(InLeft2 + i)));
+            const VectorRegister4Float Right = VectorAdd(VectorMultiply(Gain1Vector, VectorLoad(InRight1 + i)), VectorMultiply(Gain2Vector, VectorLoad(InRight2 + i)));
+
+            VectorStore(Left, OutLeft + i);
+            VectorStore(Right, OutRight + i);
+        }
+
+        Scalar::ProcessStereoCrossfadeGains(
+            InLeft1 + NumVectorFrames, InRight1 + NumVectorFrames,
+            InLeft2 + NumVectorFrames, InRight2 + NumVectorFrames,
+            OutLeft + NumVectorFrames, OutRight + NumVectorFrames, NumFrames - NumVectorFrames, InGain1, InGain2);
+    }
+
+    inline void ProcessStereoCrossfade(
+        const float* InLeft1, const float* InRight1,
+        const float* InLeft2, const float* InRight2,
+        float* OutLeft, float* OutRight, int32 NumFrames, float InCrossfade)
+    {
+        float Gain1;
+        float Gain2;
+        GetCrossfadeGains(InCrossfade, Gain1, Gain2);
+
+        ProcessStereoCrossfadeGains(InLeft1, InRight1, InLeft2, InRight2, OutLeft, OutRight, NumFrames, Gain1, Gain2);
+    }
+
+    inline void ProcessStereoMatrix(const float* InLeft, const float* InRight, float* OutLeft, float* OutRight, int32 NumFrames, const FStereoMatrix& InMatrix)
+    {
+        const int32 NumVectorFrames = NumFrames & ~(StereoKernelVectorWidth - 1);
+        const VectorRegister4Float LL = VectorSetFloat1(InMatrix.LL);
+        const VectorRegister4Float LR = VectorSetFloat1(InMatrix.LR);
+        const VectorRegister4Float RL = VectorSetFloat1(InMatrix.RL);
+        const VectorRegister4Float RR = VectorSetFloat1(InMatrix.RR);
+
+        for (int32 i = 0; i < NumVectorFrames; i += StereoKernelVectorWidth)
+        {
+            const VectorRegister4Float Left = VectorLoad(InLeft + i);
+            const VectorRegister4Float Right = VectorLoad(InRight + i);
+
+            VectorStore(VectorAdd(VectorMultiply(LL, Left), VectorMultiply(LR, Right)), OutLeft + i);
+            VectorStore(VectorAdd(VectorMultiply(RL, Left), VectorMultiply(RR, Right)), OutRight + i);
+        }
+
+        Scalar::ProcessStereoMatrix(InLeft + NumVectorFrames, InRight + NumVectorFrames, OutLeft + NumVectorFrames, OutRight + NumVectorFrames, NumFrames - NumVectorFrames, InMatrix);
+    }
+
+    namespace StereoKernelsPrivate
+    {
+        // Runs InFunc over whole vectors of frames. A partial last vector is staged through padded copies,
+        // so every frame goes through the same arithmetic whatever the block size.
+        template <int32 NumInputs, int32 NumOutputs, typename FuncType>
+        void ForEachFrameVector(const float* const (&InBuffers)[NumInputs], float* const (&OutBuffers)[NumOutputs], int32 NumFrames, FuncType&& InFunc)
+        {
+            VectorRegister4Float In[NumInputs];
+            VectorRegister4Float Out[NumOutputs];
+
+            const int32 NumVectorFrames = NumFrames & ~(StereoKernelVectorWidth - 1);
+
+            for (int32 i = 0; i < NumVectorFrames; i += StereoKernelVectorWidth)
+            {
+                for (int32 Input = 0; Input < NumInputs; ++Input)
+                {
+                    In[Input] = VectorLoad(InBuffers[Input] + i);
+                }
+
+                InFunc(In, Out);
+
+                for (int32 Output = 0; Output < NumOutputs; ++Output)
+                {
+                    VectorStore(Out[Output], OutBuffers[Output] + i);
+                }
+            }
+
+            const int32 NumRemaining = NumFrames - NumVectorFrames;
+            if (NumRemaining > 0)
+            {
+                alignas(16) float Staging[StereoKernelVectorWidth] = {};
+
+                for (int32 Input = 0; Input < NumInputs; ++Input)
+                {
+                    FMemory::Memcpy(Staging, InBuffers[Input] + NumVectorFrames, NumRemaining * sizeof(float));
+                    In[Input] = VectorLoadAligned(Staging);
+                }
+
+                InFunc(In, Out);
+
+                for (int32 Output = 0; Output < NumOutputs; ++Output)
+                {
+                    VectorStoreAligned(Out[Output], Staging);
+                    FMemory::Memcpy(OutBuffers[Output] + NumVectorFrames, Staging, NumRemaining * sizeof(float));
+                }
+            }
+        }
+    }
+
+    // Audio-rate variants: each frame's control value is the block-rate value plus that frame's modulation sample.
+    // Equal-power gains come from the engine's vector sin/cos approximation, four frames at a time.
+
+    inline void ProcessStereoBalanceModulated(const float* InLeft, const float* InRight, const float* InModulation, float* OutLeft, float* OutRight, int32 NumFrames, float InBalance)
+    {
+        const VectorRegister4Float Balance = VectorSetFloat1(InBalance);
+        const VectorRegister4Float MinBalance = VectorSetFloat1(-1.0f);
+        const VectorRegister4Float One = VectorSetFloat1(1.0f);
+        const VectorRegister4Float QuarterPi = VectorSetFloat1(PI / 4.0f);
+
+        const float* const InBuffers[3] = { InLeft, InRight, InModulation };
+        float* const OutBuffers[2] = { OutLeft, OutRight };
+
+        StereoKernelsPrivate::ForEachFrameVector(InBuffers, OutBuffers, NumFrames, [&](const VectorRegister4Float (&In)[3], VectorRegister4Float (&Out)[2])
+        {
+            const VectorRegister4Float Clamped = VectorMin(VectorMax(VectorAdd(Balance, In[2]), MinBalance), One);
+            const VectorRegister4Float Angle = VectorMultiply(VectorAdd(Clamped, One), QuarterPi);
+
+            VectorRegister4Float RightGain;
+            VectorRegister4Float LeftGain;
+            VectorSinCos(&RightGain, &LeftGain, &Angle);
+
+            Out[0] = VectorMultiply(In[0], LeftGain);
+            Out[1] = VectorMultiply(In[1], RightGain);
+        });
+    }
+
+    inline void ProcessStereoWidthModulated(const float* InLeft, const float* InRight, const float* InModulation, float* OutLeft, float* OutRight, int32 NumFrames, float InWidth)
+    {
+        const VectorRegister4Float Width = VectorSetFloat1(InWidth);
+        const VectorRegister4Float Zero = VectorSetFloat1(0.0f);
+        const VectorRegister4Float MaxWidth = VectorSetFloat1(2.0f);
+        const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+
+        const float* const InBuffers[3] = { InLeft, InRight, InModulation };
+        float* const OutBuffers[2] = { OutLeft, OutRight };
+
+        StereoKernelsPrivate::ForEachFrameVector(InBuffers, OutBuffers, NumFrames, [&](const VectorRegister4Float (&In)[3], VectorRegister4Float (&Out)[2])
+        {
+            const VectorRegister4Float WidthFactor = VectorMin(VectorMax(VectorAdd(Width, In[2]), Zero), MaxWidth);
+
+            const VectorRegister4Float Mid = VectorMultiply(Half, VectorAdd(In[0], In[1]));
+            const VectorRegister4Float Side = VectorMultiply(VectorMultiply(Half, VectorSubtract(In[0], In[1])), WidthFactor);
+
+            Out[0] = VectorAdd(Mid, Side);
+            Out[1] = VectorSubtract(Mid, Side);
+        });
+    }
+
+    inline void ProcessStereoCrossfadeModulated(
+        const float* InLeft1, const float* InRight1,
+        const float* InLeft2, const float* InRight2,
+        const float* InModulation,
+        float* OutLeft, float* OutRight, int32 NumFrames, float InCrossfade)
+    {
+        const VectorRegister4Float Crossfade = VectorSetFloat1(InCrossfade);
+        const VectorRegister4Float Zero = VectorSetFloat1(0.0f);
+        const VectorRegister4Float One = VectorSetFloat1(1.0f);
+        const VectorRegister4Float HalfPi = VectorSetFloat1(HALF_PI);
+
+        const float* const InBuffers[5] = { InLeft1, InRight1, InLeft2, InRight2, InModulation };
+        float* const OutBuffers[2] = { OutLeft, OutRight };
+
+        StereoKernelsPrivate::ForEachFrameVector(InBuffers, OutBuffers, NumFrames, [&](const VectorRegister4Float (&In)[5], VectorRegister4Float (&Out)[2])
+        {
+            const VectorRegister4Float Angle = VectorMultiply(VectorMin(VectorMax(VectorAdd(Crossfade, In[4]), Zero), One), HalfPi);
+
+            VectorRegister4Float Gain2;
+            VectorRegister4Float Gain1;
+            VectorSinCos(&Gain2, &Gain1, &Angle);
+
+            Out[0] = VectorAdd(VectorMultiply(Gain1, In[0]), VectorMultiply(Gain2, In[2]));
+            Out[1] = VectorAdd(VectorMultiply(Gain1, In[1]), VectorMultiply(Gain2, In[3]));
+        });
+    }
+}
@@ -0,0 +1,253 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/VectorRegister.h"
+#include <cmath>
+
+namespace MetasoundBranches
+{
+    // Equal division of the octave, as used by EDO
+    struct FEqualDivisionTuning
+    {
+        // Zero divisions are treated as one
+        static float GetFrequency(int32 InNote, float InReferenceFrequency, int32 InReferenceNote, int32 InDivisions)
+        {
+            const int32 Divisions = InDivisions == 0 ? 1 : InDivisions;
+            const float Exponent = static_cast<float>(InNote - InReferenceNote) / static_cast<float>(Divisions);
+            return InReferenceFrequency * powf(2.0f, Exponent);
+        }
+    };
+
+    // Twelve-note equal temperament around A4 = 440 Hz, with each pitch class detuned by some number of cents.
+    //
+    // The table holds the frequency of each pitch class in the lowest octave (MIDI notes 0 to 11), so any other
+    // note is a lookup and a power-of-two scale: no transcendental functions once the table is built.
+    class FTuningTable
+    {
+    public:
+        static constexpr int32 NumPitchClasses = 12;
+
+        // Splits a MIDI note into octave and pitch class, rounding down so negative notes keep a valid pitch class
+        static void SplitNote(int32 InNote, int32& OutOctave, int32& OutPitchClass)
+        {
+            OutPitchClass = ((InNote % NumPitchClasses) + NumPitchClasses) % NumPitchClasses;
+            OutOctave = (InNote - OutPitchClass) / NumPitchClasses;
+        }
+
+        // Frequency of a single note, worked out directly
+        static float GetFrequency(int32 InNote, float InCents)
+        {
+            const float AdjustedNote = InNote + InCents / 100.0f;
+            return 440.0f * powf(2.0f, (AdjustedNote - 69.0f) / 12.0f);
+        }
+
+        void SetCents(const float (&InCents)[NumPitchClasses])
+        {
+            for (int32 PitchClass = 0; PitchClass < NumPitchClasses; ++PitchClass)
+            {
+                Frequencies[PitchClass] = GetFrequency(PitchClass, InCents[PitchClass]);
+            }
+        }
+
+        float GetFrequency(int32 InNote) const
+        {
+            int32 Octave;
+            int32 PitchClass;
+            SplitNote(InNote, Octave, PitchClass);
+
+            return ldexpf(Frequencies[PitchClass], Octave);
+        }
+
+    private:
+        float Frequencies[NumPitchClasses] = {};
+    };
+
+    // Snaps a continuous pitch, in MIDI notes, to the nearest allowed note of a 12-note tuning.
+    //
+    // Each allowed pitch class sits at its note number plus its cents, so the degrees of one octave are sorted once
+    // into a table of positions with the decision boundaries halfway between neighbours, padded to a fixed size. A
+    // sample is folded into the octave and its degree is the number of boundaries at or below it: four vector compares
+    // and a bit count, with no search and no branches. The degree either side of the octave is kept in the table so that
+    // notes tuned across an octave edge still find their nearest neighbour.
+    //
+    // Hysteresis holds the current note until the input has moved some way past the halfway point to another one, so a
+    // pitch wobbling on a boundary doesn't chatter between the two.
+    class FTuningQuantizer
+    {
+    public:
+        static constexpr int32 NumPitchClasses = FTuningTable::NumPitchClasses;
+
+        // Bit n allows pitch class n
+        static constexpr int32 AllPitchClasses = (1 << NumPitchClasses) - 1;
+
+        // Input is held to this range, which covers anything audible, so the octave always fits an int32
+        static constexpr float MinPitch = -128.0f;
+        static constexpr float MaxPitch = 256.0f;
+
+        // Builds the degree table. An empty set of pitch classes allows all of them.
+        void SetTuning(const float (&InCents)[NumPitchClasses], int32 InAllowedPitchClasses)
+        {
+            struct FDegree
+            {
+                float Position;
+                int32 NoteOffset;
+            };
+
+            Table.SetCents(InCents);
+
+            AllowedPitchClasses = InAllowedPitchClasses & AllPitchClasses;
+            if (AllowedPitchClasses == 0)
+            {
+                AllowedPitchClasses = AllPitchClasses;
+            }
+
+            // Fold each degree into the octave, keeping track of which note it belongs to relative to that octave
+            FDegree Degrees[NumPitchClasses];
+            int32 NumDegrees = 0;
+
+            for (int32 PitchClass = 0; PitchClass < NumPitchClasses; ++PitchClass)
+            {
+                Offsets[PitchClass] = InCents[PitchClass] / 100.0f;
+
+                if (AllowedPitchClasses & (1 << PitchClass))
+                {
+                    const float Position = PitchClass + Offsets[PitchClass];
+                    const float Octave = floorf(Position / NumPitchClasses);
+                    Degrees[NumDegrees++] = { Position - Octave * NumPitchClasses, PitchClass - NumPitchClasses * static_cast<int32>(Octave) };
+                }
+            }
+
+            TArrayView<FDegree>(Degrees, NumDegrees).StableSort([](const FDegree& A, const FDegree& B)
+            {
+                return A.Position < B.Position;
+            });
+
+            // The highest degree of the octave below, every degree of this one, and the lowest of the octave above
+            Positions[0] = Degrees[NumDegrees - 1].Position - NumPitchClasses;
+            NoteOffsets[0] = Degrees[NumDegrees - 1].NoteOffset - NumPitchClasses;
+
+            for (int32 Degree = 0; Degree < NumDegrees; ++Degree)
+            {
+                Positions[Degree + 1] = Degrees[Degree].Position;
+                NoteOffsets[Degree + 1] = Degrees[Degree].NoteOffset;
+            }
+
+            Positions[NumDegrees + 1] = Degrees[0].Position + NumPitchClasses;
+            NoteOffsets[NumDegrees + 1] = Degrees[0].NoteOffset + NumPitchClasses;
+
+            // Boundaries past the last degree can never be reached
+            for (int32 Boundary = 0; Boundary < MaxBoundaries; ++Boundary)
+            {
+                Boundaries[Boundary] = Boundary <= NumDegrees
+                    ? 0.5f * (Positions[Boundary] + Positions[Boundary + 1])
+                    : TNumericLimits<float>::Max();
+            }
+
+            // Keep the current note where it still exists, at its new tuning; otherwise pick again on the next sample
+            if (bHasNote)
+            {
+                int32 Octave;
+                int32 PitchClass;
+                FTuningTable::SplitNote(CurrentNote, Octave, PitchClass);
+
+                if (AllowedPitchClasses & (1 << PitchClass))
+                {
+                    CurrentPosition = CurrentNote + Offsets[PitchClass];
+                    Frequency = Table.GetFrequency(CurrentNote);
+                }
+                else
+                {
+                    bHasNote = false;
+                }
+            }
+        }
+
+        // The next sample always picks a note and reports it as a change
+        void Reset()
+        {
+            bHasNote = false;
+            CurrentNote = 0;
+            CurrentPosition = 0.0f;
+            Frequency = 0.0f;
+        }
+
+        // Nearest allowed note to InPitch, and its tuned position in (fractional) MIDI notes
+        void Quantize(float InPitch, int32& OutNote, float& OutPosition) const
+        {
+            const float Octave = floorf(InPitch * (1.0f / NumPitchClasses));
+            const VectorRegister4Float Wrapped = VectorSetFloat1(InPitch - Octave * NumPitchClasses);
+
+            const int32 Mask =
+                VectorMaskBits(VectorCompareGE(Wrapped, VectorLoadAligned(Boundaries)))
+                | (VectorMaskBits(VectorCompareGE(Wrapped, VectorLoadAligned(Boundaries + 4))) << 4)
+                | (VectorMaskBits(VectorCompareGE(Wrapped, VectorLoadAligned(Boundaries + 8))) << 8)
+                | (VectorMaskBits(VectorCompareGE(Wrapped, VectorLoadAligned(Boundaries + 12))) << 12);
+
+            const int32 Degree = FMath::CountBits(static_cast<uint64>(Mask));
+
+            OutNote = NumPitchClasses * static_cast<int32>(Octave) + NoteOffsets[Degree];
+            OutPosition = Octave * NumPitchClasses + Positions[Degree];
+        }
+
+        // Writes the quantized note and its frequency for every sample, and calls OnChange(Frame) on each sample where
+        // the note changes. InHysteresis is how far past the halfway point to the next note, in semitones, the input
+        // has to go before the note follows it.
+        template <typename OnChangeType>
+        void ProcessBuffer(const float* InPitch, float* OutNote, float* OutFrequency, int32 NumSamples, float InHysteresis, OnChangeType&& OnChange)
+        {
+            // Moving past the halfway point by h brings the input 2h closer to the new note than to the current one
+            const float Threshold = 2.0f * FMath::Max(InHysteresis, 0.0f);
+
+            for (int32 i = 0; i < NumSamples; ++i)
+            {
+                // Max first, so a NaN lands on MinPitch
+                const float Pitch = FMath::Min(FMath::Max(InPitch[i], MinPitch), MaxPitch);
+
+                int32 Note;
+                float Position;
+                Quantize(Pitch, Note, Position);
+
+                const float Advantage = FMath::Abs(Pitch - CurrentPosition) - FMath::Abs(Pitch - Position);
+                if (!bHasNote || (Note != CurrentNote && Advantage > Threshold))
+                {
+                    CurrentNote = Note;
+                    CurrentPosition = Position;
+                    Frequency = Table.GetFrequency(Note);
+                    bHasNote = true;
+
+                    OnChange(i);
+                }
+
+                OutNote[i] = static_cast<float>(CurrentNote);
+                OutFrequency[i] = Frequency;
+            }
+        }
+
+        int32 GetAllowedPitchClasses() const
+        {
+            return AllowedPitchClasses;
+        }
+
+    private:
+        // One boundary between each pair of neighbouring degrees, for up to twelve degrees plus one either side
+        static constexpr int32 MaxBoundaries = 16;
+        static_assert(MaxBoundaries >= NumPitchClasses + 1, "Every degree of the octave needs a boundary either side");
+
+        alignas(16) float Boundaries[MaxBoundaries] = {};
+        float Positions[MaxBoundaries + 1] = {};
+        int32 NoteOffsets[MaxBoundaries + 1] = {};
+
+        // Cents of each pitch class, in semitones
+        float Offsets[NumPitchClasses] = {};
+
+        int32 AllowedPitchClasses = AllPitchClasses;
+        FTuningTable Table;
+
+        bool bHasNote = false;
+        int32 CurrentNote = 0;
+        float CurrentPosition = 0.0f;
+        float Frequency = 0.0f;
+    };
+}
@@ -0,0 +1,289 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/VectorRegister.h"
+#include "MetasoundBranches/Public/DSP/SlewKernel.h"
+#include "MetasoundBranches/Public/DSP/DustKernel.h"
+#include "MetasoundBranches/Public/DSP/EdgeKernel.h"
+
+// Many voices of one kernel processed together, for hosts that run the same node once per voice.
+//
+// State is held as one array per field (struct-of-arrays) and buffers are frame-major: sample f of voice v
+// lives at [f * GetStride() + v]. The stride is the voice count rounded up to the vector width, so every
+// frame starts on a whole vector. Padding voices are processed but their output is meaningless.
+//
+// Each batch produces the same output per voice as the matching single-voice kernel.
+namespace MetasoundBranches
+{
+    constexpr int32 VoiceBatchVectorWidth = 4;
+
+    inline int32 GetVoiceBatchStride(int32 InNumVoices)
+    {
+        return Align(FMath::Max(InNumVoices, 0), VoiceBatchVectorWidth);
+    }
+
+    // FSlewKernel across voices. Also covers Bool To Audio through ProcessConstantTargets.
+    class FSlewVoiceBatch
+    {
+    public:
+        void Init(int32 InNumVoices)
+        {
+            NumVoices = InNumVoices;
+            Stride = GetVoiceBatchStride(InNumVoices);
+
+            Values.SetNumZeroed(Stride);
+            RiseAlphas.SetNumZeroed(Stride);
+            FallAlphas.SetNumZeroed(Stride);
+        }
+
+        int32 GetNumVoices() const { return NumVoices; }
+        int32 GetStride() const { return Stride; }
+
+        void SetAlphas(int32 InVoice, float InRiseAlpha, float InFallAlpha)
+        {
+            RiseAlphas[InVoice] = InRiseAlpha;
+            FallAlphas[InVoice] = InFallAlpha;
+        }
+
+        void Reset(float InValue = 0.0f)
+        {
+            for (float& Value : Values)
+            {
+                Value = InValue;
+            }
+        }
+
+        float GetValue(int32 InVoice) const
+        {
+            return Values[InVoice];
+        }
+
+        // InSignal and OutSignal hold NumFrames * GetStride() samples and may point to the same buffer
+        void ProcessInterleaved(const float* InSignal, float* OutSignal, int32 NumFrames)
+        {
+            const VectorRegister4Float One = VectorOneFloat();
+            float* State = Values.GetData();
+
+            for (int32 v = 0; v < Stride; v += VoiceBatchVectorWidth)
+            {
+                const VectorRegister4Float Rise = VectorLoad(RiseAlphas.GetData() + v);
+                const VectorRegister4Float Fall = VectorLoad(FallAlphas.GetData() + v);
+                const VectorRegister4Float RiseTarget = VectorSubtract(One, Rise);
+                const VectorRegister4Float FallTarget = VectorSubtract(One, Fall);
+
+                VectorRegister4Float Previous = VectorLoad(State + v);
+
+                for (int32 f = 0; f < NumFrames; ++f)
+                {
+                    const int32 Index = f * Stride + v;
+                    const VectorRegister4Float Target = VectorLoad(InSignal + Index);
+                    Previous = ProcessVector(Previous, Target, Rise, Fall, RiseTarget, FallTarget);
+                    VectorStore(Previous, OutSignal + Index);
+                }
+
+                VectorStore(Previous, State + v);
+            }
+        }
+
+        // Slews every voice towards its own target, held for the whole buffer
+        void ProcessConstantTargets(const float* InTargets, float* OutSignal, int32 NumFrames)
+        {
+            const VectorRegister4Float One = VectorOneFloat();
+            float* State = Values.GetData();
+
+            for (int32 v = 0; v < Stride; v += VoiceBatchVectorWidth)
+            {
+                const VectorRegister4Float Rise = VectorLoad(RiseAlphas.GetData() + v);
+                const VectorRegister4Float Fall = VectorLoad(FallAlphas.GetData() + v);
+                const VectorRegister4Float RiseTarget = VectorSubtract(One, Rise);
+                const VectorRegister4Float FallTarget = VectorSubtract(One, Fall);
+                const VectorRegister4Float Target = VectorLoad(InTargets + v);
+
+                VectorRegister4Float Previous = VectorLoad(State + v);
+
+                for (int32 f = 0; f < NumFrames; ++f)
+                {
+                    Previous = ProcessVector(Previous, Target, Rise, Fall, RiseTarget, FallTarget);
+                    VectorStore(Previous, OutSignal + f * Stride + v);
+                }
+
+                VectorStore(Previous, State + v);
+            }
+        }
+
+    private:
+        // Same operation order as FSlewKernel::ProcessSample, so results match per voice
+        static VectorRegister4Float ProcessVector(
+            const VectorRegister4Float& Previous,
+            const VectorRegister4Float& Target,
+            const VectorRegister4Float& Rise,
+            const VectorRegister4Float& Fall,
+            const VectorRegister4Float& OneMinusRise,
+            const VectorRegister4Float& OneMinusFall)
+        {
+            const VectorRegister4Float Rising = VectorAdd(VectorMultiply(Rise, Previous), VectorMultiply(OneMinusRise, Target));
+            const VectorRegister4Float Falling = VectorAdd(VectorMultiply(Fall, Previous), VectorMultiply(OneMinusFall, Target));
+
+            // Equal (or NaN) targets pass straight through
+            const VectorRegister4Float Settled = VectorSelect(VectorCompareLT(Target, Previous), Falling, Target);
+            return VectorSelect(VectorCompareGT(Target, Previous), Rising, Settled);
+        }
+
+        int32 NumVoices = 0;
+        int32 Stride = 0;
+
+        TArray<float> Values;
+        TArray<float> RiseAlphas;
+        TArray<float> FallAlphas;
+    };
+
+    // FDustKernel across voices. Voice v is seeded with InBaseSeed + v.
+    class FDustVoiceBatch
+    {
+    public:
+        void Init(int32 InNumVoices, uint32 InBaseSeed)
+        {
+            NumVoices = InNumVoices;
+            Stride = GetVoiceBatchStride(InNumVoices);
+            BaseSeed = InBaseSeed;
+
+            Seeds.SetNumUninitialized(Stride);
+            Signs.SetNumUninitialized(Stride);
+            Reset();
+        }
+
+        int32 GetNumVoices() const { return NumVoices; }
+        int32 GetStride() const { return Stride; }
+
+        void Reset()
+        {
+            for (int32 v = 0; v < Stride; ++v)
+            {
+                Seeds[v] = BaseSeed + static_cast<uint32>(v);
+                Signs[v] = 1.0f;
+            }
+        }
+
+        // InDensity and OutSignal hold NumFrames * GetStride() samples, InDensityOffsets holds GetStride().
+        // The loop body has no branches so the compiler can vectorize it across voices.
+        // Returns the number of impulses written across all voices, padding included.
+        int32 ProcessInterleaved(const float* InDensity, const float* InDensityOffsets, bool bBiPolar, float* OutSignal, int32 NumFrames)
+        {
+            uint32* RESTRICT Seed = Seeds.GetData();
+            float* RESTRICT Sign = Signs.GetData();
+            const float FlipScale = bBiPolar ? -1.0f : 1.0f;
+            int32 NumImpulses = 0;
+
+            for (int32 f = 0; f < NumFrames; ++f)
+            {
+                const float* RESTRICT Density = InDensity + f * Stride;
+                float* RESTRICT Out = OutSignal + f * Stride;
+
+                for (int32 v = 0; v < Stride; ++v)
+                {
+                    const float Threshold = 1.0f - (FMath::Abs(Density[v]) + InDensityOffsets[v]) * FDustKernel::DensityScale;
+
+                    Seed[v] = FDustRandom::Next(Seed[v]);
+
+                    const bool bImpulse = FDustRandom::ToFraction(Seed[v]) > Threshold;
+                    const float Impulse = bImpulse ? 1.0f : 0.0f;
+
+                    // Unipolar output leaves the sign at +1
+                    Out[v] = Impulse * Sign[v];
+                    Sign[v] = bImpulse ? Sign[v] * FlipScale : Sign[v];
+                    NumImpulses += bImpulse ? 1 : 0;
+                }
+            }
+
+            return NumImpulses;
+        }
+
+    private:
+        int32 NumVoices = 0;
+        int32 Stride = 0;
+        uint32 BaseSeed = 0;
+
+        TArray<uint32> Seeds;
+        TArray<float> Signs;
+    };
+
+    // FEdgeKernel across voices, with a debounce length per voice.
+    // Edges are written as one flag per voice per frame rather than calling back per edge.
+    class FEdgeVoiceBatch
+    {
+    public:
+        void Init(int32 InNumVoices)
+        {
+            NumVoices = InNumVoices;
+            Stride = GetVoiceBatchStride(InNumVoices);
+
+            PreviousValues.SetNumZeroed(Stride);
+            IsRising.SetNumZeroed(Stride);
+            DebounceCounters.SetNumZeroed(Stride);
+            DebounceSamples.SetNumZeroed(Stride);
+        }
+
+        int32 GetNumVoices() const { return NumVoices; }
+        int32 GetStride() const { return Stride; }
+
+        void SetDebounceSamples(int32 InVoice, int32 InDebounceSamples)
+        {
+            DebounceSamples[InVoice] = InDebounceSamples;
+        }
+
+        // InPreviousValues holds GetStride() values, or null to start every voice from zero
+        void Reset(const float* InPreviousValues = nullptr)
+        {
+            for (int32 v = 0; v < Stride; ++v)
+            {
+                PreviousValues[v] = InPreviousValues ? InPreviousValues[v] : 0.0f;
+                IsRising[v] = 0;
+                DebounceCounters[v] = 0;
+            }
+        }
+
+        // InSignal, OutRise and OutFall hold NumFrames * GetStride() entries. A flag is 1 on the frame of an edge.
+        void ProcessInterleaved(const float* InSignal, uint8* OutRise, uint8* OutFall, int32 NumFrames)
+        {
+            float* RESTRICT Previous = PreviousValues.GetData();
+            uint8* RESTRICT Rising = IsRising.GetData();
+            int32* RESTRICT Counter = DebounceCounters.GetData();
+            const int32* RESTRICT Debounce = DebounceSamples.GetData();
+
+            for (int32 f = 0; f < NumFrames; ++f)
+            {
+                const float* RESTRICT Signal = InSignal + f * Stride;
+                uint8* RESTRICT Rise = OutRise + f * Stride;
+                uint8* RESTRICT Fall = OutFall + f * Stride;
+
+                for (int32 v = 0; v < Stride; ++v)
+                {
+                    const float Current = Signal[v];
+                    const int32 Remaining = FMath::Max(Counter[v] - 1, 0);
+                    const uint8 bReady = Remaining == 0 ? 1 : 0;
+
+                    const uint8 bRise = (Current > Previous[v]) & (Rising[v] ^ 1) & bReady;
+                    const uint8 bFall = (Current < Previous[v]) & Rising[v] & bReady;
+                    const uint8 bEdge = bRise | bFall;
+
+                    Rise[v] = bRise;
+                    Fall[v] = bFall;
+                    Rising[v] ^= bEdge;
+                    Counter[v] = bEdge ? Debounce[v] : Remaining;
+                    Previous[v] = Current;
+                }
+            }
+        }
+
+    private:
+        int32 NumVoices = 0;
+        int32 Stride = 0;
+
+        TArray<float> PreviousValues;
+        TArray<uint8> IsRising;
+        TArray<int32> DebounceCounters;
+        TArray<int32> DebounceSamples;
+    };
+}
@@ -0,0 +1,60 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MetasoundBranches/Public/DSP/EdgeKernel.h"
+
+namespace MetasoundBranches
+{
+    // Zero crossing detection with debounce, as used by Zero Crossing.
+    // A crossing in either direction is reported, but not within the debounce period of the last one.
+    class FZeroCrossingKernel
+    {
+    public:
+        // Same range and rounding as Edge
+        static int32 GetDebounceSamples(float InDebounceSeconds, float InSampleRate)
+        {
+            return FEdgeKernel::GetDebounceSamples(InDebounceSeconds, InSampleRate);
+        }
+
+        void Reset(float InPreviousValue = 0.0f)
+        {
+            PreviousSignalValue = InPreviousValue;
+            DebounceCounter = 0;
+        }
+
+        // Calls OnCrossing(Frame) for every crossing in the block
+        template <typename CrossingFuncType>
+        void ProcessBuffer(const float* InSignal, int32 NumFrames, int32 InDebounceSamples, CrossingFuncType&& OnCrossing)
+        {
+            for (int32 i = 0; i < NumFrames; ++i)
+            {
+                float CurrentSignal = InSignal[i];
+
+                if (DebounceCounter > 0)
+                {
+                    DebounceCounter--;
+                }
+
+                bool PreviousNonPositive = (PreviousSignalValue <= 0.0f);
+                bool CurrentPositive = (CurrentSignal > 0.0f);
+                bool PreviousNonNegative = (PreviousSignalValue >= 0.0f);
+                bool CurrentNegative = (CurrentSignal < 0.0f);
+
+                // Crossing from negative or zero to positive, or from positive or zero to negative
+                if (((PreviousNonPositive && CurrentPositive) || (PreviousNonNegative && CurrentNegative)) && DebounceCounter <= 0)
+                {
+                    OnCrossing(i);
+                    DebounceCounter = InDebounceSamples;
+                }
+
+                PreviousSignalValue = CurrentSignal;
+            }
+        }
+
+    private:
+        float PreviousSignalValue = 0.0f;
+        int32 DebounceCounter = 0;
+    };
+}
@@ -0,0 +1,44 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MetasoundNodeInterface.h"
+
+// Every node class in the plugin, so the harness module can create nodes and build their operators without a graph.
+namespace MetasoundBranches
+{
+    // One entry per node class. Entries are static objects that link themselves into a list during module load,
+    // in the same way as the node stats.
+    class METASOUNDBRANCHES_API FNodeListEntry
+    {
+    public:
+        using FCreateNode = TUniquePtr<Metasound::INode> (*)(const Metasound::FNodeInitData&);
+
+        FNodeListEntry(const TCHAR* InClassName, FCreateNode InCreateNode);
+
+        const TCHAR* GetClassName() const { return ClassName; }
+
+        TUniquePtr<Metasound::INode> CreateNode(const Metasound::FNodeInitData& InInitData) const
+        {
+            return CreateNodeFunction(InInitData);
+        }
+
+        const FNodeListEntry* GetNext() const { return Next; }
+
+        static const FNodeListEntry* GetHead() { return Head; }
+
+    private:
+        const TCHAR* ClassName;
+        FCreateNode CreateNodeFunction;
+
+        const FNodeListEntry* Next = nullptr;
+        static const FNodeListEntry* Head;
+    };
+}
+
+// Adds a node class to the list. Use once at namespace scope, next to METASOUND_REGISTER_NODE.
+#define METASOUND_BRANCHES_LIST_NODE(NodeClass) \
+    static const ::MetasoundBranches::FNodeListEntry GBranchesNodeListEntry_##NodeClass( \
+        TEXT(#NodeClass), \
+        [](const ::Metasound::FNodeInitData& InInitData) -> TUniquePtr<::Metasound::INode> { return MakeUnique<NodeClass>(InInitData); })
@@ -0,0 +1,31 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+using System.IO;
+using UnrealBuildTool;
+
+// Offline render, verification and benchmark commandlets over the Branches DSP kernels.
+// Editor only, so none of it (including the allocator hook in the spawn bench) ships in game or server builds.
+public class MetasoundBranchesHarness : ModuleRules
+{
+    public MetasoundBranchesHarness(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        // Headers are included by their path under Source, as in the runtime module
+        PrivateIncludePaths.Add(Path.GetFullPath(Path.Combine(ModuleDirectory, "..")));
+
+        PrivateDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core",
+                "CoreUObject",
+                "Engine",
+                "MetasoundBranches",
+                "MetasoundGraphCore",
+                "MetasoundFrontend",
+                "Projects",
+                "SignalProcessing"
+            }
+        );
+    }
+}
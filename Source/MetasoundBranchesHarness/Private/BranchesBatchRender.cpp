@@ -0,0 +1,249 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranchesHarness/Private/BranchesBatchRender.h"
+#include "MetasoundBranchesHarness/Private/BranchesRenderChain.h"
+#include "MetasoundBranchesHarness/Private/BranchesWaveFile.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+
+#include <atomic>
+
+namespace MetasoundBranches::Harness
+{
+    namespace BatchRenderPrivate
+    {
+        // Block storage owned by one worker and reused for every job it renders
+        class FBlockArena
+        {
+        public:
+            void Reserve(int32 InNumChannels, int32 InBlockSize)
+            {
+                if (Storage.Num() < InNumChannels * InBlockSize)
+                {
+                    Storage.SetNumZeroed(InNumChannels * InBlockSize);
+                }
+                Channels.Reserve(InNumChannels);
+            }
+
+            TArrayView<float* const> GetChannels(int32 InNumChannels, int32 InBlockSize)
+            {
+                Reserve(InNumChannels, InBlockSize);
+
+                Channels.Reset();
+                for (int32 Channel = 0; Channel < InNumChannels; ++Channel)
+                {
+                    Channels.Add(Storage.GetData() + Channel * InBlockSize);
+                }
+
+                return Channels;
+            }
+
+        private:
+            TArray<float> Storage;
+            TArray<float*> Channels;
+        };
+
+        // A worker's share of the jobs. The owner and any thieves claim from the front with the same counter,
+        // so each queue is largest first for whoever takes from it.
+        struct FWorkerQueue
+        {
+            TArray<int32> JobIndices;
+            std::atomic<int32> NextIndex { 0 };
+
+            int32 Claim()
+            {
+                const int32 Index = NextIndex.fetch_add(1, std::memory_order_relaxed);
+                return Index < JobIndices.Num() ? JobIndices[Index] : INDEX_NONE;
+            }
+        };
+
+        bool RenderJob(const FBatchRenderJob& InJob, FBlockArena& InArena, FBatchRenderJobResult& OutResult)
+        {
+            FWaveFileReader Reader;
+            if (!Reader.Open(InJob.InFilename, OutResult.Error))
+            {
+                return false;
+            }
+
+            OutResult.NumChannels = Reader.GetNumChannels();
+            OutResult.SampleRate = InJob.SampleRate > 0 ? InJob.SampleRate : Reader.GetSampleRate();
+
+            FRenderChain Chain;
+            if (!Chain.Init(InJob.ChainSpec, OutResult.NumChannels, static_cast<float>(OutResult.SampleRate), OutResult.Error))
+            {
+                return false;
+            }
+
+            FWaveFileWriter Writer;
+            if (!Writer.Open(InJob.OutFilename, OutResult.NumChannels, OutResult.SampleRate, OutResult.Error))
+            {
+                return false;
+            }
+
+            TArrayView<float* const> Channels = InArena.GetChannels(OutResult.NumChannels, InJob.BlockSize);
+
+            while (true)
+            {
+                const int32 NumFrames = Reader.ReadFrames(Channels, InJob.BlockSize);
+                if (NumFrames <= 0)
+                {
+                    break;
+                }
+
+                Chain.Process(Channels, NumFrames);
+
+                if (!Writer.WriteFrames(TArrayView<const float* const>(Channels.GetData(), Channels.Num()), NumFrames))
+                {
+                    OutResult.Error = FString::Printf(TEXT("Failed writing %s"), *InJob.OutFilename);
+                    return false;
+                }
+
+                OutResult.NumFrames += NumFrames;
+            }
+
+            if (!Writer.Close())
+            {
+                OutResult.Error = FString::Printf(TEXT("Failed closing %s"), *InJob.OutFilename);
+                return false;
+            }
+
+            return true;
+        }
+
+        void RunWorker(int32 InWorkerIndex, const TArray<FBatchRenderJob>& InJobs, TArray<TUniquePtr<FWorkerQueue>>& InQueues, double InStartTime, int32 InMaxBlockSize, FBatchRenderSummary& OutSummary)
+        {
+            FBatchRenderWorkerStats& Stats = OutSummary.Workers[InWorkerIndex];
+            const int32 NumWorkers = InQueues.Num();
+
+            // Stereo at the largest block size covers most jobs without growing
+            FBlockArena Arena;
+            Arena.Reserve(2, InMaxBlockSize);
+
+            while (true)
+            {
+                int32 JobIndex = InQueues[InWorkerIndex]->Claim();
+                bool bStolen = false;
+
+                for (int32 Offset = 1; JobIndex == INDEX_NONE && Offset < NumWorkers; ++Offset)
+                {
+                    JobIndex = InQueues[(InWorkerIndex + Offset) % NumWorkers]->Claim();
+                    bStolen = JobIndex != INDEX_NONE;
+                }
+
+                if (JobIndex == INDEX_NONE)
+                {
+                    return;
+                }
+
+                FBatchRenderJobResult& Result = OutSummary.Jobs[JobIndex];
+                const double JobStartTime = FPlatformTime::Seconds();
+
+                Result.WorkerIndex = InWorkerIndex;
+                Result.StartSeconds = JobStartTime - InStartTime;
+                Result.bSucceeded = RenderJob(InJobs[JobIndex], Arena, Result);
+                Result.RenderSeconds = FPlatformTime::Seconds() - JobStartTime;
+
+                Stats.NumJobs += 1;
+                Stats.NumStolen += bStolen ? 1 : 0;
+                Stats.BusySeconds += Result.RenderSeconds;
+            }
+        }
+    }
+
+    bool ParseBatchJobFile(const FString& InFilename, TArray<FBatchRenderJob>& OutJobs, FString& OutError)
+    {
+        TArray<FString> Lines;
+        if (!FFileHelper::LoadFileToStringArray(Lines, *InFilename))
+        {
+            OutError = TEXT("Could not read job file");
+            return false;
+        }
+
+        for (int32 LineIndex = 0; LineIndex < Lines.Num(); ++LineIndex)
+        {
+            const FString Line = Lines[LineIndex].TrimStartAndEnd();
+            if (Line.IsEmpty() || Line.StartsWith(TEXT("#")))
+            {
+                continue;
+            }
+
+            FBatchRenderJob Job;
+            Job.LineNumber = LineIndex + 1;
+
+            FParse::Value(*Line, TEXT("In="), Job.InFilename);
+            FParse::Value(*Line, TEXT("Out="), Job.OutFilename);
+            FParse::Value(*Line, TEXT("Chain="), Job.ChainSpec);
+            FParse::Value(*Line, TEXT("BlockSize="), Job.BlockSize);
+            FParse::Value(*Line, TEXT("SampleRate="), Job.SampleRate);
+
+            if (Job.InFilename.IsEmpty() || Job.OutFilename.IsEmpty() || Job.ChainSpec.IsEmpty() || Job.BlockSize <= 0)
+            {
+                OutError = FString::Printf(TEXT("Line %d needs -In, -Out, -Chain and a positive -BlockSize"), Job.LineNumber);
+                return false;
+            }
+
+            OutJobs.Add(MoveTemp(Job));
+        }
+
+        return true;
+    }
+
+    FBatchRenderSummary RunBatchRender(const TArray<FBatchRenderJob>& InJobs, int32 InNumWorkers)
+    {
+        using namespace BatchRenderPrivate;
+
+        const int32 NumWorkers = FMath::Clamp(InNumWorkers, 1, FMath::Max(InJobs.Num(), 1));
+
+        FBatchRenderSummary Summary;
+        Summary.Jobs.SetNum(InJobs.Num());
+        Summary.Workers.SetNum(NumWorkers);
+
+        // Largest input first, dealt round robin, so every queue starts with a similar amount of work
+        TArray<int64> InputSizes;
+        TArray<int32> Order;
+        int32 MaxBlockSize = 1;
+
+        for (int32 JobIndex = 0; JobIndex < InJobs.Num(); ++JobIndex)
+        {
+            InputSizes.Add(IFileManager::Get().FileSize(*InJobs[JobIndex].InFilename));
+            Order.Add(JobIndex);
+            MaxBlockSize = FMath::Max(MaxBlockSize, InJobs[JobIndex].BlockSize);
+        }
+
+        Order.StableSort([&InputSizes](int32 A, int32 B) { return InputSizes[A] > InputSizes[B]; });
+
+        TArray<TUniquePtr<FWorkerQueue>> Queues;
+        for (int32 Worker = 0; Worker < NumWorkers; ++Worker)
+        {
+            Queues.Add(MakeUnique<FWorkerQueue>());
+        }
+
+        for (int32 i = 0; i < Order.Num(); ++i)
+        {
+            Queues[i % NumWorkers]->JobIndices.Add(Order[i]);
+        }
+
+        const double StartTime = FPlatformTime::Seconds();
+
+        // The calling thread is worker 0
+        TArray<TFuture<void>> Futures;
+        for (int32 Worker = 1; Worker < NumWorkers; ++Worker)
+        {
+            Futures.Add(Async(EAsyncExecution::Thread, [Worker, &InJobs, &Queues, StartTime, MaxBlockSize, &Summary]()
+            {
+                RunWorker(Worker, InJobs, Queues, StartTime, MaxBlockSize, Summary);
+            }));
+        }
+
+        RunWorker(0, InJobs, Queues, StartTime, MaxBlockSize, Summary);
+
+        for (TFuture<void>& Future : Futures)
+        {
+            Future.Wait();
+        }
+
+        Summary.WallSeconds = FPlatformTime::Seconds() - StartTime;
+        return Summary;
+    }
+}
@@ -0,0 +1,64 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace MetasoundBranches::Harness
+{
+    // One independent render from a batch job file
+    struct FBatchRenderJob
+    {
+        FString InFilename;
+        FString OutFilename;
+        FString ChainSpec;
+        int32 BlockSize = 256;
+
+        // Zero uses the input file's rate
+        int32 SampleRate = 0;
+
+        // Line in the job file, for error messages
+        int32 LineNumber = 0;
+    };
+
+    struct FBatchRenderJobResult
+    {
+        bool bSucceeded = false;
+        FString Error;
+
+        int32 WorkerIndex = INDEX_NONE;
+        int32 NumChannels = 0;
+        int32 SampleRate = 0;
+        int64 NumFrames = 0;
+
+        // Time from the start of the batch until a worker picked the job up, and the time spent rendering it
+        double StartSeconds = 0.0;
+        double RenderSeconds = 0.0;
+    };
+
+    struct FBatchRenderWorkerStats
+    {
+        int32 NumJobs = 0;
+
+        // Jobs taken from another worker's queue
+        int32 NumStolen = 0;
+        double BusySeconds = 0.0;
+    };
+
+    struct FBatchRenderSummary
+    {
+        TArray<FBatchRenderJobResult> Jobs;
+        TArray<FBatchRenderWorkerStats> Workers;
+        double WallSeconds = 0.0;
+    };
+
+    // Reads a job file with one render per line, written with the same switches as a single render:
+    //   -In=<file.wav> -Out=<file.wav> -Chain=<spec> [-BlockSize=256] [-SampleRate=<hz>]
+    // Blank lines and lines starting with '#' are skipped.
+    bool ParseBatchJobFile(const FString& InFilename, TArray<FBatchRenderJob>& OutJobs, FString& OutError);
+
+    // Renders every job on InNumWorkers threads and returns when all have finished.
+    // Jobs are dealt out largest input first, one queue per worker; a worker that runs out steals from the others.
+    // Each worker renders through its own block storage, allocated once and grown only for wider jobs.
+    FBatchRenderSummary RunBatchRender(const TArray<FBatchRenderJob>& InJobs, int32 InNumWorkers);
+}
@@ -0,0 +1,401 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranchesHarness/Private/BranchesInstanceBench.h"
+#include "MetasoundBranches/Public/DSP/AllPassKernel.h"
+#include "MetasoundBranches/Public/DSP/DustKernel.h"
+#include "MetasoundBranches/Public/DSP/SlewKernel.h"
+#include "MetasoundBranches/Public/DSP/StereoKernels.h"
+
+namespace MetasoundBranches::Harness
+{
+    namespace InstanceBenchPrivate
+    {
+        // Blocks run before timing, so every buffer has been written once
+        constexpr int32 NumWarmUpBlocks = 2;
+
+        // Fewest blocks timed at any voice count
+        constexpr int32 MinBlocks = 8;
+
+        constexpr int32 DisperserStages = 16;
+
+        // One node in one voice. Like an operator it owns its state and its output buffers, each allocated on
+        // its own, and reads its inputs from the outputs of the node before it.
+        class FInstance
+        {
+        public:
+            virtual ~FInstance() = default;
+
+            virtual void Execute(int32 NumFrames) = 0;
+
+            // Mono outputs feed both inputs of a stereo node; a mono node reads the left of a stereo one
+            void BindInputs(const FInstance& InPrevious)
+            {
+                InputLeft = InPrevious.GetOutput(0);
+                InputRight = InPrevious.GetOutput(1);
+            }
+
+            const float* GetOutput(int32 InChannel) const
+            {
+                return Outputs[FMath::Min(InChannel, Outputs.Num() - 1)].GetData();
+            }
+
+            // Bytes this instance touches every block, apart from its input
+            int64 GetWorkingSetBytes() const
+            {
+                int64 Bytes = GetStateSize();
+                for (const TArray<float>& Output : Outputs)
+                {
+                    Bytes += Output.GetAllocatedSize();
+                }
+                return Bytes;
+            }
+
+        protected:
+            FInstance(int32 InNumOutputs, int32 InBlockSize)
+            {
+                Outputs.SetNum(InNumOutputs);
+                for (TArray<float>& Output : Outputs)
+                {
+                    Output.SetNumZeroed(InBlockSize);
+                }
+            }
+
+            virtual int64 GetStateSize() const = 0;
+
+            float* GetOutputData(int32 InChannel)
+            {
+                return Outputs[InChannel].GetData();
+            }
+
+            const float* InputLeft = nullptr;
+            const float* InputRight = nullptr;
+
+        private:
+            TArray<TArray<float>> Outputs;
+        };
+
+        // A voice's input, such as a wave player: stereo noise written once and read by the first node
+        class FSourceInstance : public FInstance
+        {
+        public:
+            FSourceInstance(int32 InBlockSize, FRandomStream& InStream)
+                : FInstance(2, InBlockSize)
+            {
+                for (int32 Channel = 0; Channel < 2; ++Channel)
+                {
+                    float* Output = GetOutputData(Channel);
+                    for (int32 i = 0; i < InBlockSize; ++i)
+                    {
+                        Output[i] = InStream.FRandRange(-1.0f, 1.0f);
+                    }
+                }
+            }
+
+            virtual void Execute(int32 NumFrames) override {}
+
+        protected:
+            virtual int64 GetStateSize() const override { return sizeof(*this); }
+        };
+
+        // Dust (Audio) with its density modulated by the input
+        class FDustInstance : public FInstance
+        {
+        public:
+            static constexpr float Density = 50.0f;
+
+            FDustInstance(int32 InBlockSize, FRandomStream& InStream)
+                : FInstance(1, InBlockSize)
+                , Kernel(InStream.GetUnsignedInt())
+            {
+            }
+
+            virtual void Execute(int32 NumFrames) override
+            {
+                Kernel.ProcessBuffer(InputLeft, Density, false, GetOutputData(0), NumFrames);
+            }
+
+        protected:
+            virtual int64 GetStateSize() const override { return sizeof(*this); }
+
+        private:
+            FDustKernel Kernel;
+        };
+
+        class FSlewInstance : public FInstance
+        {
+        public:
+            FSlewInstance(int32 InBlockSize, float InSampleRate, FRandomStream& InStream)
+                : FInstance(1, InBlockSize)
+                , RiseAlpha(FSlewKernel::GetAlpha(InStream.FRandRange(0.001f, 0.1f), InSampleRate))
+                , FallAlpha(FSlewKernel::GetAlpha(InStream.FRandRange(0.001f, 0.1f), InSampleRate))
+            {
+            }
+
+            virtual void Execute(int32 NumFrames) override
+            {
+                Kernel.ProcessBuffer(InputLeft, GetOutputData(0), NumFrames, RiseAlpha, FallAlpha);
+            }
+
+        protected:
+            virtual int64 GetStateSize() const override { return sizeof(*this); }
+
+        private:
+            FSlewKernel Kernel;
+            float RiseAlpha;
+            float FallAlpha;
+        };
+
+        class FDisperserInstance : public FInstance
+        {
+        public:
+            explicit FDisperserInstance(int32 InBlockSize)
+                : FInstance(1, InBlockSize)
+                , Kernel(DisperserStages)
+            {
+            }
+
+            virtual void Execute(int32 NumFrames) override
+            {
+                float* Output = GetOutputData(0);
+                FMemory::Memcpy(Output, InputLeft, NumFrames * sizeof(float));
+                Kernel.ProcessInPlace(Output, NumFrames, DisperserStages);
+            }
+
+        protected:
+            virtual int64 GetStateSize() const override { return sizeof(*this) + Kernel.GetAllocatedSize(); }
+
+        private:
+            FPhaseDisperserKernel Kernel;
+        };
+
+        class FStereoDisperserInstance : public FInstance
+        {
+        public:
+            explicit FStereoDisperserInstance(int32 InBlockSize)
+                : FInstance(2, InBlockSize)
+                , Kernel(2, DisperserStages)
+            {
+            }
+
+            virtual void Execute(int32 NumFrames) override
+            {
+                float* Channels[2] = { GetOutputData(0), GetOutputData(1) };
+                FMemory::Memcpy(Channels[0], InputLeft, NumFrames * sizeof(float));
+                FMemory::Memcpy(Channels[1], InputRight, NumFrames * sizeof(float));
+                Kernel.ProcessInPlace(Channels, NumFrames, DisperserStages);
+            }
+
+        protected:
+            virtual int64 GetStateSize() const override { return sizeof(*this) + Kernel.GetAllocatedSize(); }
+
+        private:
+            FMultichannelPhaseDisperserKernel Kernel;
+        };
+
+        // Stereo Gain, Balance and Width: one kernel call with a per-instance setting
+        template <void (*ProcessFunction)(const float*, const float*, float*, float*, int32, float)>
+        class TStereoInstance : public FInstance
+        {
+        public:
+            TStereoInstance(int32 InBlockSize, float InSetting)
+                : FInstance(2, InBlockSize)
+                , Setting(InSetting)
+            {
+            }
+
+            virtual void Execute(int32 NumFrames) override
+            {
+                ProcessFunction(InputLeft, InputRight, GetOutputData(0), GetOutputData(1), NumFrames, Setting);
+            }
+
+        protected:
+            virtual int64 GetStateSize() const override { return sizeof(*this); }
+
+        private:
+            float Setting;
+        };
+
+        TUniquePtr<FInstance> CreateInstance(const FString& InName, int32 InBlockSize, float InSampleRate, FRandomStream& InStream)
+        {
+            if (InName.Equals(TEXT("Dust"), ESearchCase::IgnoreCase))
+            {
+                return MakeUnique<FDustInstance>(InBlockSize, InStream);
+            }
+            if (InName.Equals(TEXT("Slew"), ESearchCase::IgnoreCase))
+            {
+                return MakeUnique<FSlewInstance>(InBlockSize, InSampleRate, InStream);
+            }
+            if (InName.Equals(TEXT("Disperser"), ESearchCase::IgnoreCase))
+            {
+                return MakeUnique<FDisperserInstance>(InBlockSize);
+            }
+            if (InName.Equals(TEXT("StereoDisperser"), ESearchCase::IgnoreCase))
+            {
+                return MakeUnique<FStereoDisperserInstance>(InBlockSize);
+            }
+            if (InName.Equals(TEXT("Gain"), ESearchCase::IgnoreCase))
+            {
+                return MakeUnique<TStereoInstance<&ProcessStereoGain>>(InBlockSize, InStream.FRandRange(0.5f, 1.0f));
+            }
+            if (InName.Equals(TEXT("Balance"), ESearchCase::IgnoreCase))
+            {
+                return MakeUnique<TStereoInstance<&ProcessStereoBalance>>(InBlockSize, InStream.FRandRange(-1.0f, 1.0f));
+            }
+            if (InName.Equals(TEXT("Width"), ESearchCase::IgnoreCase))
+            {
+                return MakeUnique<TStereoInstance<&ProcessStereoWidth>>(InBlockSize, InStream.FRandRange(0.0f, 2.0f));
+            }
+            return nullptr;
+        }
+
+        void RunVoiceCount(const FInstanceBenchSettings& InSettings, const TArray<FString>& InNodeNames, int32 InNumVoices, FPerfCounters* InCounters, FInstanceBenchResult& OutResult)
+        {
+            const int32 NodesPerVoice = InNodeNames.Num();
+            FRandomStream Stream(InNumVoices * 7919 + InSettings.BlockSize);
+
+            TArray<TUniquePtr<FInstance>> Sources;
+            TArray<TUniquePtr<FInstance>> Instances;
+
+            // Built voice by voice, so each voice's nodes sit near each other on the heap as they would when a
+            // sound spawns
+            for (int32 Voice = 0; Voice < InNumVoices; ++Voice)
+            {
+                const FInstance* Previous = Sources.Add_GetRef(MakeUnique<FSourceInstance>(InSettings.BlockSize, Stream)).Get();
+
+                for (const FString& NodeName : InNodeNames)
+                {
+                    TUniquePtr<FInstance> Instance = CreateInstance(NodeName, InSettings.BlockSize, InSettings.SampleRate, Stream);
+                    Instance->BindInputs(*Previous);
+                    Previous = Instances.Add_GetRef(MoveTemp(Instance)).Get();
+                }
+            }
+
+            TArray<FInstance*> ExecutionOrder;
+            ExecutionOrder.Reserve(Instances.Num());
+
+            if (InSettings.Order == EInstanceOrder::Voice)
+            {
+                for (const TUniquePtr<FInstance>& Instance : Instances)
+                {
+                    ExecutionOrder.Add(Instance.Get());
+                }
+            }
+            else
+            {
+                for (int32 Node = 0; Node < NodesPerVoice; ++Node)
+                {
+                    for (int32 Voice = 0; Voice < InNumVoices; ++Voice)
+                    {
+                        ExecutionOrder.Add(Instances[Voice * NodesPerVoice + Node].Get());
+                    }
+                }
+            }
+
+            OutResult.NumVoices = InNumVoices;
+            OutResult.NumInstances = Instances.Num();
+            OutResult.NumBlocks = static_cast<int32>(FMath::Clamp<int64>(InSettings.InstanceBlocks / FMath::Max(Instances.Num(), 1), MinBlocks, MAX_int32));
+
+            for (const TUniquePtr<FInstance>& Source : Sources)
+            {
+                OutResult.WorkingSetBytes += Source->GetWorkingSetBytes();
+            }
+            for (const TUniquePtr<FInstance>& Instance : Instances)
+            {
+                OutResult.WorkingSetBytes += Instance->GetWorkingSetBytes();
+            }
+
+            for (int32 Block = 0; Block < NumWarmUpBlocks; ++Block)
+            {
+                for (FInstance* Instance : ExecutionOrder)
+                {
+                    Instance->Execute(InSettings.BlockSize);
+                }
+            }
+
+            uint64 TotalCycles = 0;
+            uint64 MaxCycles = 0;
+
+            if (InCounters != nullptr)
+            {
+                InCounters->Mark();
+            }
+
+            for (int32 Block = 0; Block < OutResult.NumBlocks; ++Block)
+            {
+                const uint64 StartCycles = FPlatformTime::Cycles64();
+
+                for (FInstance* Instance : ExecutionOrder)
+                {
+                    Instance->Execute(InSettings.BlockSize);
+                }
+
+                const uint64 BlockCycles = FPlatformTime::Cycles64() - StartCycles;
+                TotalCycles += BlockCycles;
+                MaxCycles = FMath::Max(MaxCycles, BlockCycles);
+            }
+
+            if (InCounters != nullptr)
+            {
+                InCounters->Accumulate(OutResult.Counters);
+            }
+
+            const double TotalSeconds = FPlatformTime::ToSeconds64(TotalCycles);
+            const double InstanceSamples = static_cast<double>(OutResult.NumBlocks) * OutResult.NumInstances * InSettings.BlockSize;
+
+            OutResult.MeanBlockMicroseconds = TotalSeconds * 1.0e6 / OutResult.NumBlocks;
+            OutResult.MaxBlockMicroseconds = FPlatformTime::ToSeconds64(MaxCycles) * 1.0e6;
+            OutResult.NanosecondsPerInstanceSample = InstanceSamples > 0.0 ? TotalSeconds * 1.0e9 / InstanceSamples : 0.0;
+        }
+    }
+
+    bool RunInstanceBench(const FInstanceBenchSettings& InSettings, TArray<FInstanceBenchResult>& OutResults, FString& OutError)
+    {
+        using namespace InstanceBenchPrivate;
+
+        TArray<FString> NodeNames;
+        InSettings.Graph.ParseIntoArray(NodeNames, TEXT("+"));
+
+        if (NodeNames.IsEmpty())
+        {
+            OutError = TEXT("Empty graph");
+            return false;
+        }
+
+        // Check every name before building thousands of instances
+        FRandomStream Stream;
+        for (const FString& NodeName : NodeNames)
+        {
+            if (!CreateInstance(NodeName, 1, InSettings.SampleRate, Stream).IsValid())
+            {
+                OutError = FString::Printf(TEXT("Unknown node '%s'"), *NodeName);
+                return false;
+            }
+        }
+
+        FPerfCounters Counters;
+        if (InSettings.bPerfCounters && !Counters.Open(OutError))
+        {
+            return false;
+        }
+
+        for (int32 NumVoices : InSettings.VoiceCounts)
+        {
+            FInstanceBenchResult Result;
+            RunVoiceCount(InSettings, NodeNames, FMath::Max(NumVoices, 1), Counters.IsOpen() ? &Counters : nullptr, Result);
+            OutResults.Add(Result);
+        }
+
+        return true;
+    }
+
+    FString GetInstanceBenchUsage()
+    {
+        return TEXT(
+            "Nodes, joined with '+', each reading the one before:\n"
+            "  Dust              (mono, density modulated by the input)\n"
+            "  Slew              (mono)\n"
+            "  Disperser         (mono, 16 stages)\n"
+            "  StereoDisperser   (stereo, 16 stages)\n"
+            "  Gain, Balance, Width (stereo)");
+    }
+}
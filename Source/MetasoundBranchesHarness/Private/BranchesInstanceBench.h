@@ -0,0 +1,62 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MetasoundBranchesHarness/Private/BranchesPerfCounters.h"
+
+namespace MetasoundBranches::Harness
+{
+    enum class EInstanceOrder : uint8
+    {
+        // Each voice runs all of its nodes before the next voice starts, as separate MetaSound graphs do
+        Voice,
+
+        // Every voice's first node, then every voice's second node, and so on, as a batched host could
+        Node
+    };
+
+    struct FInstanceBenchSettings
+    {
+        // Nodes in one voice, joined with '+'. Each reads the output of the node before it.
+        FString Graph = TEXT("Dust+Slew+Width");
+
+        // Voice counts to sweep, smallest first
+        TArray<int32> VoiceCounts;
+
+        int32 BlockSize = 256;
+        float SampleRate = 48000.0f;
+
+        // Node executions timed at each voice count, so small counts run more blocks and every step takes a similar time
+        int64 InstanceBlocks = 200000;
+
+        EInstanceOrder Order = EInstanceOrder::Voice;
+        bool bPerfCounters = false;
+    };
+
+    struct FInstanceBenchResult
+    {
+        int32 NumVoices = 0;
+        int32 NumInstances = 0;
+        int32 NumBlocks = 0;
+
+        // Node state and output buffers of every instance, plus each voice's input
+        int64 WorkingSetBytes = 0;
+
+        // Time to run every instance once
+        double MeanBlockMicroseconds = 0.0;
+        double MaxBlockMicroseconds = 0.0;
+
+        double NanosecondsPerInstanceSample = 0.0;
+
+        // Counts over every timed block, if counters were requested
+        FPerfCounterValues Counters;
+    };
+
+    // Builds NumVoices copies of the graph for each voice count, with every node and output buffer allocated
+    // separately as a MetaSound graph does, and times whole blocks as the total working set outgrows the caches.
+    bool RunInstanceBench(const FInstanceBenchSettings& InSettings, TArray<FInstanceBenchResult>& OutResults, FString& OutError);
+
+    // Node names accepted in FInstanceBenchSettings::Graph
+    FString GetInstanceBenchUsage();
+}
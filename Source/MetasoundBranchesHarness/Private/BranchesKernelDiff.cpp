@@ -0,0 +1,760 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranchesHarness/Private/BranchesKernelDiff.h"
+#include "MetasoundBranches/Public/DSP/AllPassKernel.h"
+#include "MetasoundBranches/Public/DSP/EnvelopeFollowerKernel.h"
+#include "MetasoundBranches/Public/DSP/StereoKernels.h"
+#include "MetasoundBranches/Public/DSP/VoiceBatchKernels.h"
+#include "MetasoundBranches/Public/DSP/ZeroCrossingKernel.h"
+#include "Math/RandomStream.h"
+
+#include <limits>
+
+namespace MetasoundBranches::Harness
+{
+    namespace KernelDiffPrivate
+    {
+        constexpr int32 MaxFrames = 1031;
+        constexpr int32 MaxOffset = 3;
+        constexpr int32 MaxInputs = 5;
+        constexpr int32 NumParams = 6;
+
+        // Runs either the scalar reference or the vector path of one kernel
+        using FKernelFunction = TFunction<void(bool bReference, const float* const* InBuffers, float* const* OutBuffers, int32 NumFrames, const float* InParams)>;
+
+        struct FKernelCase
+        {
+            const TCHAR* Name;
+            int32 NumInputs;
+            FKernelFunction Run;
+
+            // The last input is an audio-rate control signal rather than audio
+            bool bLastInputIsModulation = false;
+
+            // Kernels built on approximations (such as the vector sin/cos) may differ from the reference by this much,
+            // relative to the reference value, in addition to the ULP allowance
+            float RelativeTolerance = 0.0f;
+        };
+
+        // Where a case that carries state splits its block in two, so the second call starts from the first one's state
+        int32 GetSplitFrame(float InParam, int32 NumFrames)
+        {
+            return FMath::Clamp(FMath::TruncToInt(FMath::Abs(InParam) * 0.25f * NumFrames), 0, NumFrames);
+        }
+
+        // Linear slew steps are powers of two and targets sit on a 1/4096 grid, so stepping one sample at a time and
+        // multiplying the step are both exact. The two paths must then agree on every sample and on the reached frame.
+        float GetLinearSlewStep(float InParam)
+        {
+            const int32 Shift = 1 + FMath::Abs(FMath::TruncToInt(InParam * 3.0f)) % 12;
+            return 1.0f / static_cast<float>(1 << Shift);
+        }
+
+        float GetLinearSlewTarget(float InValue)
+        {
+            // Infinities and NaN are kept: the clamp sends them to the edge of the step window on both paths
+            return FMath::IsFinite(InValue) ? FMath::Clamp(FMath::RoundToFloat(InValue * 4096.0f) / 4096.0f, -4.0f, 4.0f) : InValue;
+        }
+
+        TArray<FKernelCase> GetKernelCases()
+        {
+            TArray<FKernelCase> Cases;
+
+            Cases.Add({ TEXT("StereoGain"), 2, [](bool bReference, const float* const* In, float* const* Out, int32 NumFrames, const float* Params)
+            {
+                (bReference ? Scalar::ProcessStereoGain : ProcessStereoGain)(In[0], In[1], Out[0], Out[1], NumFrames, Params[0]);
+            }});
+
+            Cases.Add({ TEXT("StereoBalance"), 2, [](bool bReference, const float* const* In, float* const* Out, int32 NumFrames, const float* Params)
+            {
+                (bReference ? Scalar::ProcessStereoBalance : ProcessStereoBalance)(In[0], In[1], Out[0], Out[1], NumFrames, Params[0]);
+            }});
+
+            Cases.Add({ TEXT("StereoWidth"), 2, [](bool bReference, const float* const* In, float* const* Out, int32 NumFrames, const float* Params)
+            {
+                (bReference ? Scalar::ProcessStereoWidth : ProcessStereoWidth)(In[0], In[1], Out[0], Out[1], NumFrames, Params[0]);
+            }});
+
+            Cases.Add({ TEXT("StereoInverter"), 2, [](bool bReference, const float* const* In, float* const* Out, int32 NumFrames, const float* Params)
+            {
+                (bReference ? Scalar::ProcessStereoInverter : ProcessStereoInverter)(In[0], In[1], Out[0], Out[1], NumFrames, Params[0] > 0.0f, Params[1] > 0.0f, Params[2] > 0.0f);
+            }});
+
+            Cases.Add({ TEXT("StereoCrossfade"), 4, [](bool bReference, const float* const* In, float* const* Out, int32 NumFrames, const float* Params)
+            {
+                (bReference ? Scalar::ProcessStereoCrossfade : ProcessStereoCrossfade)(In[0], In[1], In[2], In[3], Out[0], Out[1], NumFrames, Params[0]);
+            }});
+
+            Cases.Add({ TEXT("StereoMatrix"), 2, [](bool bReference, const float* const* In, float* const* Out, int32 NumFrames, const float* Params)
+            {
+                const FStereoMatrix Matrix = GetStereoStripMatrix(Params[0] > 0.0f, Params[1] > 0.0f, Params[2] > 0.0f, Params[3], Params[4], Params[5]);
+                (bReference ? Scalar::ProcessStereoMatrix : ProcessStereoMatrix)(In[0], In[1], Out[0], Out[1], NumFrames, Matrix);
+            }});
+
+            // Vector sin/cos is an approximation, so the gains are allowed to differ slightly from FMath::Sin/Cos
+            constexpr float SinCosTolerance = 1.0e-6f;
+
+            Cases.Add({ TEXT("StereoBalanceModulated"), 3, [](bool bReference, const float* const* In, float* const* Out, int32 NumFrames, const float* Params)
+            {
+                (bReference ? Scalar::ProcessStereoBalanceModulated : ProcessStereoBalanceModulated)(In[0], In[1], In[2], Out[0], Out[1], NumFrames, Params[0]);
+            }, true, SinCosTolerance });
+
+            Cases.Add({ TEXT("StereoWidthModulated"), 3, [](bool bReference, const float* const* In, float* const* Out, int32 NumFrames, const float* Params)
+            {
+                (bReference ? Scalar::ProcessStereoWidthModulated : ProcessStereoWidthModulated)(In[0], In[1], In[2], Out[0], Out[1], NumFrames, Params[0]);
+            }, true });
+
+            Cases.Add({ TEXT("StereoCrossfadeModulated"), 5, [](bool bReference, const float* const* In, float* const* Out, int32 NumFrames, const float* Params)
+            {
+                (bReference ? Scalar::ProcessStereoCrossfadeModulated : ProcessStereoCrossfadeModulated)(In[0], In[1], In[2], In[3], In[4], Out[0], Out[1], NumFrames, Params[0]);
+            }, true, SinCosTolerance });
+
+            // Two channels through the shared multichannel cascade against one mono cascade each
+            Cases.Add({ TEXT("PhaseDisperser"), 2, [](bool bReference, const float* const* In, float* const* Out, int32 NumFrames, const float* Params)
+            {
+                const int32 NumStages = 1 + FMath::Abs(FMath::TruncToInt(Params[0] * 8.0f));
+
+                for (int32 Channel = 0; Channel < 2; ++Channel)
+                {
+                    if (In[Channel] != Out[Channel])
+                    {
+                        FMemory::Memcpy(Out[Channel], In[Channel], NumFrames * sizeof(float));
+                    }
+                }
+
+                if (bReference)
+                {
+                    for (int32 Channel = 0; Channel < 2; ++Channel)
+                    {
+                        FPhaseDisperserKernel Kernel(NumStages);
+                        Kernel.ProcessInPlace(Out[Channel], NumFrames, NumStages);
+                    }
+                }
+                else
+                {
+                    FMultichannelPhaseDisperserKernel Kernel(2, NumStages);
+                    Kernel.ProcessInPlace(TArrayView<float* const>(Out, 2), NumFrames, NumStages);
+                }
+            }});
+
+            // The fused follower against rectifying, then slewing, one sample at a time: peak on the first channel, RMS on the second
+            Cases.Add({ TEXT("EnvelopeFollower"), 2, [](bool bReference, const float* const* In, float* const* Out, int32 NumFrames, const float* Params)
+            {
+                const float AttackAlpha = FSlewKernel::GetAlpha(0.001f + FMath::Abs(Params[0]) * 0.01f, 48000.0f);
+                const float ReleaseAlpha = FSlewKernel::GetAlpha(0.001f + FMath::Abs(Params[1]) * 0.1f, 48000.0f);
+
+                if (bReference)
+                {
+                    FSlewKernel Peak;
+                    FSlewKernel Power;
+                    for (int32 i = 0; i < NumFrames; ++i)
+                    {
+                        Out[0][i] = Peak.ProcessSample(FMath::Abs(In[0][i]), AttackAlpha, ReleaseAlpha);
+                        Out[1][i] = FMath::Sqrt(Power.ProcessSample(In[1][i] * In[1][i], AttackAlpha, ReleaseAlpha));
+                    }
+                }
+                else
+                {
+                    FEnvelopeFollowerKernel Peak;
+                    FEnvelopeFollowerKernel Power;
+                    Power.SetMode(EEnvelopeFollowerMode::RMS);
+
+                    Peak.ProcessBuffer(In[0], Out[0], NumFrames, AttackAlpha, ReleaseAlpha);
+                    Power.ProcessBuffer(In[1], Out[1], NumFrames, AttackAlpha, ReleaseAlpha);
+                }
+            }});
+
+            // Windowed RMS against summing every window afresh, with the window length changed part way through so the
+            // history carried across the change is checked too. Inputs are clamped to +-4 with NaN and Inf zeroed: a running
+            // sum loses precision next to a huge sample and only recovers from Inf or NaN at its next re-sum.
+            Cases.Add({ TEXT("EnvelopeFollowerWindowed"), 2, [](bool bReference, const float* const* In, float* const* Out, int32 NumFrames, const float* Params)
+            {
+                constexpr int32 MaxWindowSamples = 256;
+
+                const float AttackAlpha = FSlewKernel::GetAlpha(0.001f + FMath::Abs(Params[0]) * 0.01f, 48000.0f);
+                const float ReleaseAlpha = FSlewKernel::GetAlpha(0.001f + FMath::Abs(Params[1]) * 0.1f, 48000.0f);
+                const int32 Split = GetSplitFrame(Params[2], NumFrames);
+
+                for (int32 Channel = 0; Channel < 2; ++Channel)
+                {
+                    const int32 FirstLength = 1 + FMath::Abs(FMath::TruncToInt(Params[3 + Channel] * 64.0f)) % MaxWindowSamples;
+                    const int32 SecondLength = 1 + FMath::Abs(FMath::TruncToInt(Params[5] * (Channel + 1) * 64.0f)) % MaxWindowSamples;
+
+                    TArray<float> Signal;
+                    Signal.SetNumZeroed(NumFrames);
+                    for (int32 i = 0; i < NumFrames; ++i)
+                    {
+                        Signal[i] = FMath::IsFinite(In[Channel][i]) ? FMath::Clamp(In[Channel][i], -4.0f, 4.0f) : 0.0f;
+                    }
+
+                    if (bReference)
+                    {
+                        FSlewKernel Smoother;
+                        for (int32 i = 0; i < NumFrames; ++i)
+                        {
+                            const int32 Length = (i < Split) ? FirstLength : SecondLength;
+
+                            double Sum = 0.0;
+                            for (int32 j = FMath::Max(i - Length + 1, 0); j <= i; ++j)
+                            {
+                                Sum += Signal[j] * Signal[j];
+                            }
+
+                            const float MeanSquare = static_cast<float>(FMath::Max(Sum, 0.0) / Length);
+                            Out[Channel][i] = Smoother.ProcessSample(FMath::Sqrt(MeanSquare), AttackAlpha, ReleaseAlpha);
+                        }
+                    }
+                    else
+                    {
+                        FEnvelopeFollowerKernel Kernel;
+                        Kernel.SetMode(EEnvelopeFollowerMode::WindowedRMS);
+                        Kernel.InitWindow(MaxWindowSamples);
+
+                        Kernel.SetWindowLength(FirstLength);
+                        Kernel.ProcessBuffer(Signal.GetData(), Out[Channel], Split, AttackAlpha, ReleaseAlpha);
+
+                        Kernel.SetWindowLength(SecondLength);
+                        Kernel.ProcessBuffer(Signal.GetData() + Split, Out[Channel] + Split, NumFrames - Split, AttackAlpha, ReleaseAlpha);
+                    }
+                }
+            }, false, 1.0e-6f });
+
+            // Decimated peak (first channel) and RMS (second) written out one sample at a time over the whole buffer, against
+            // the kernel over blocks of a different length, so groups straddle block boundaries. The output must not depend
+            // on where the blocks fall. NaN is zeroed, as the vector max passes it through in lane order.
+            Cases.Add({ TEXT("EnvelopeFollowerDecimated"), 2, [](bool bReference, const float* const* In, float* const* Out, int32 NumFrames, const float* Params)
+            {
+                const float AttackAlpha = FSlewKernel::GetAlpha(0.001f + FMath::Abs(Params[0]) * 0.01f, 48000.0f);
+                const float ReleaseAlpha = FSlewKernel::GetAlpha(0.001f + FMath::Abs(Params[1]) * 0.1f, 48000.0f);
+                const int32 Decimation = 2 + FMath::Abs(FMath::TruncToInt(Params[3] * 16.0f)) % 64;
+                const int32 BlockSize = FMath::Max(GetSplitFrame(Params[2], NumFrames), 1);
+
+                for (int32 Channel = 0; Channel < 2; ++Channel)
+                {
+                    const bool bRMS = Channel == 1;
+
+                    TArray<float> Signal;
+                    Signal.SetNumZeroed(NumFrames);
+                    for (int32 i = 0; i < NumFrames; ++i)
+                    {
+                        Signal[i] = FMath::IsNaN(In[Channel][i]) ? 0.0f : In[Channel][i];
+                    }
+
+                    if (bReference)
+                    {
+                        const float GroupAttackAlpha = FMath::Pow(AttackAlpha, static_cast<float>(Decimation));
+                        const float GroupReleaseAlpha = FMath::Pow(ReleaseAlpha, static_cast<float>(Decimation));
+
+                        FSlewKernel Smoother;
+                        float Peak = 0.0f;
+                        double SumOfSquares = 0.0;
+
+                        for (int32 i = 0; i < NumFrames; ++i)
+                        {
+                            Peak = FMath::Max(Peak, FMath::Abs(Signal[i]));
+                            SumOfSquares += static_cast<double>(Signal[i]) * Signal[i];
+
+                            if ((i + 1) % Decimation == 0)
+                            {
+                                Smoother.ProcessSample(bRMS ? static_cast<float>(SumOfSquares / Decimation) : Peak, GroupAttackAlpha, GroupReleaseAlpha);
+                                Peak = 0.0f;
+                                SumOfSquares = 0.0;
+                            }
+
+                            Out[Channel][i] = bRMS ? FMath::Sqrt(Smoother.GetValue()) : Smoother.GetValue();
+                        }
+                    }
+                    else
+                    {
+                        FEnvelopeFollowerKernel Kernel;
+                        Kernel.SetMode(bRMS ? EEnvelopeFollowerMode::RMS : EEnvelopeFollowerMode::Peak);
+
+                        for (int32 Start = 0; Start < NumFrames; Start += BlockSize)
+                        {
+                            const int32 BlockFrames = FMath::Min(BlockSize, NumFrames - Start);
+                            Kernel.ProcessBuffer(Signal.GetData() + Start, Out[Channel] + Start, BlockFrames, AttackAlpha, ReleaseAlpha, Decimation);
+                        }
+                    }
+                }
+            }});
+
+            // The per-sample kernel against the voice batch on the first channel, and against a target held over two blocks
+            // (as Slew (Float) runs) on the second
+            Cases.Add({ TEXT("Slew"), 2, [](bool bReference, const float* const* In, float* const* Out, int32 NumFrames, const float* Params)
+            {
+                const float RiseAlpha = FSlewKernel::GetAlpha(0.0001f + FMath::Abs(Params[0]) * 0.01f, 48000.0f);
+                const float FallAlpha = FSlewKernel::GetAlpha(0.0001f + FMath::Abs(Params[1]) * 0.01f, 48000.0f);
+                const int32 Split = GetSplitFrame(Params[2], NumFrames);
+                const float Target = (NumFrames > 0) ? In[1][0] : 0.0f;
+
+                if (bReference)
+                {
+                    FSlewKernel Signal;
+                    FSlewKernel Held;
+                    for (int32 i = 0; i < NumFrames; ++i)
+                    {
+                        Out[0][i] = Signal.ProcessSample(In[0][i], RiseAlpha, FallAlpha);
+                        Out[1][i] = Held.ProcessSample(Target, RiseAlpha, FallAlpha);
+                    }
+                }
+                else
+                {
+                    FSlewVoiceBatch Batch;
+                    Batch.Init(1);
+                    Batch.SetAlphas(0, RiseAlpha, FallAlpha);
+
+                    const int32 Stride = Batch.GetStride();
+                    TArray<float> Interleaved;
+                    Interleaved.SetNumZeroed(NumFrames * Stride);
+
+                    for (int32 i = 0; i < NumFrames; ++i)
+                    {
+                        Interleaved[i * Stride] = In[0][i];
+                    }
+
+                    Batch.ProcessInterleaved(Interleaved.GetData(), Interleaved.GetData(), NumFrames);
+
+                    for (int32 i = 0; i < NumFrames; ++i)
+                    {
+                        Out[0][i] = Interleaved[i * Stride];
+                    }
+
+                    FSlewKernel Held;
+                    Held.ProcessConstant(Target, Out[1], Split, RiseAlpha, FallAlpha);
+                    Held.ProcessConstant(Target, Out[1] + Split, NumFrames - Split, RiseAlpha, FallAlpha);
+                }
+            }});
+
+            // ProcessBuffer over a held target against ProcessConstant, over two blocks that either hold the target or
+            // change it. The first channel is the output, the second is 1 on each frame Reached fires. On the vector side
+            // Reached comes from AdvanceConstant, which keeps its own state and never sees the output.
+            Cases.Add({ TEXT("LinearSlew"), 2, [](bool bReference, const float* const* In, float* const* Out, int32 NumFrames, const float* Params)
+            {
+                const float RiseStep = GetLinearSlewStep(Params[0]);
+                const float FallStep = GetLinearSlewStep(Params[1]);
+                const int32 Split = GetSplitFrame(Params[2], NumFrames);
+
+                // Read before the outputs are written, as they may alias the inputs
+                const float FirstTarget = (NumFrames > 0) ? GetLinearSlewTarget(In[0][0]) : 0.0f;
+                const float SecondTarget = (NumFrames > 0 && Params[3] > 0.0f) ? GetLinearSlewTarget(In[1][0]) : FirstTarget;
+
+                const int32 BlockStarts[2] = { 0, Split };
+                const int32 BlockFrames[2] = { Split, NumFrames - Split };
+                const float Targets[2] = { FirstTarget, SecondTarget };
+
+                FMemory::Memzero(Out[1], NumFrames * sizeof(float));
+
+                FLinearSlewKernel Kernel;
+                FLinearSlewKernel Advance;
+                for (int32 Block = 0; Block < 2; ++Block)
+                {
+                    float* BlockOut = Out[0] + BlockStarts[Block];
+                    float* BlockReached = Out[1] + BlockStarts[Block];
+
+                    if (bReference)
+                    {
+                        for (int32 i = 0; i < BlockFrames[Block]; ++i)
+                        {
+                            BlockOut[i] = Targets[Block];
+                        }
+
+                        Kernel.ProcessBuffer(BlockOut, BlockOut, BlockFrames[Block], RiseStep, FallStep, [BlockReached](int32 Frame)
+                        {
+                            BlockReached[Frame] = 1.0f;
+                        });
+                    }
+                    else
+                    {
+                        Kernel.ProcessConstant(Targets[Block], BlockOut, BlockFrames[Block], RiseStep, FallStep);
+
+                        const int32 ReachedFrame = Advance.AdvanceConstant(Targets[Block], BlockFrames[Block], RiseStep, FallStep);
+                        if (ReachedFrame != INDEX_NONE)
+                        {
+                            BlockReached[ReachedFrame] = 1.0f;
+                        }
+                    }
+                }
+            }});
+
+            // One edge detector per channel against the voice batch running both, with a different debounce per channel.
+            // Rises are written as 1 and falls as -1.
+            Cases.Add({ TEXT("Edge"), 2, [](bool bReference, const float* const* In, float* const* Out, int32 NumFrames, const float* Params)
+            {
+                const int32 DebounceSamples[2] =
+                {
+                    FEdgeKernel::GetDebounceSamples(FMath::Abs(Params[0]) * 0.002f, 48000.0f),
+                    FEdgeKernel::GetDebounceSamples(FMath::Abs(Params[1]) * 0.002f, 48000.0f)
+                };
+
+                if (bReference)
+                {
+                    for (int32 Channel = 0; Channel < 2; ++Channel)
+                    {
+                        // Copied so the markers can be written over an aliased input
+                        const TArray<float> Signal(In[Channel], NumFrames);
+                        float* ChannelOut = Out[Channel];
+                        FMemory::Memzero(ChannelOut, NumFrames * sizeof(float));
+
+                        FEdgeKernel Kernel;
+                        Kernel.ProcessBuffer(Signal.GetData(), NumFrames, DebounceSamples[Channel],
+                            [ChannelOut](int32 Frame) { ChannelOut[Frame] = 1.0f; },
+                            [ChannelOut](int32 Frame) { ChannelOut[Frame] = -1.0f; });
+                    }
+                }
+                else
+                {
+                    FEdgeVoiceBatch Batch;
+                    Batch.Init(2);
+                    Batch.SetDebounceSamples(0, DebounceSamples[0]);
+                    Batch.SetDebounceSamples(1, DebounceSamples[1]);
+
+                    const int32 Stride = Batch.GetStride();
+                    TArray<float> Interleaved;
+                    TArray<uint8> Rise;
+                    TArray<uint8> Fall;
+                    Interleaved.SetNumZeroed(NumFrames * Stride);
+                    Rise.SetNumZeroed(NumFrames * Stride);
+                    Fall.SetNumZeroed(NumFrames * Stride);
+
+                    for (int32 i = 0; i < NumFrames; ++i)
+                    {
+                        Interleaved[i * Stride] = In[0][i];
+                        Interleaved[i * Stride + 1] = In[1][i];
+                    }
+
+                    Batch.ProcessInterleaved(Interleaved.GetData(), Rise.GetData(), Fall.GetData(), NumFrames);
+
+                    for (int32 i = 0; i < NumFrames; ++i)
+                    {
+                        for (int32 Channel = 0; Channel < 2; ++Channel)
+                        {
+                            const int32 Index = i * Stride + Channel;
+                            Out[Channel][i] = Rise[Index] ? 1.0f : (Fall[Index] ? -1.0f : 0.0f);
+                        }
+                    }
+                }
+            }});
+
+            // The crossing rule written out one sample at a time against the kernel over two blocks, one channel each
+            Cases.Add({ TEXT("ZeroCrossing"), 2, [](bool bReference, const float* const* In, float* const* Out, int32 NumFrames, const float* Params)
+            {
+                const int32 Split = GetSplitFrame(Params[2], NumFrames);
+
+                for (int32 Channel = 0; Channel < 2; ++Channel)
+                {
+                    const int32 DebounceSamples = FZeroCrossingKernel::GetDebounceSamples(FMath::Abs(Params[Channel]) * 0.002f, 48000.0f);
+
+                    // Copied so the markers can be written over an aliased input
+                    const TArray<float> Signal(In[Channel], NumFrames);
+                    float* ChannelOut = Out[Channel];
+                    FMemory::Memzero(ChannelOut, NumFrames * sizeof(float));
+
+                    if (bReference)
+                    {
+                        float Previous = 0.0f;
+                        int32 Counter = 0;
+
+                        for (int32 i = 0; i < NumFrames; ++i)
+                        {
+                            Counter = FMath::Max(Counter - 1, 0);
+
+                            const bool bUp = Previous <= 0.0f && Signal[i] > 0.0f;
+                            const bool bDown = Previous >= 0.0f && Signal[i] < 0.0f;
+
+                            if ((bUp || bDown) && Counter == 0)
+                            {
+                                ChannelOut[i] = 1.0f;
+                                Counter = DebounceSamples;
+                            }
+
+                            Previous = Signal[i];
+                        }
+                    }
+                    else
+                    {
+                        FZeroCrossingKernel Kernel;
+                        Kernel.ProcessBuffer(Signal.GetData(), Split, DebounceSamples, [ChannelOut](int32 Frame) { ChannelOut[Frame] = 1.0f; });
+
+                        float* SecondOut = ChannelOut + Split;
+                        Kernel.ProcessBuffer(Signal.GetData() + Split, NumFrames - Split, DebounceSamples, [SecondOut](int32 Frame) { SecondOut[Frame] = 1.0f; });
+                    }
+                }
+            }});
+
+            // The single-voice kernel writing whole blocks against the sparse writer on the first channel, and against the
+            // voice batch on the second. The sparse path reuses one block buffer, as an operator does, starting it with
+            // garbage that the first Clear must remove.
+            Cases.Add({ TEXT("Dust"), 2, [](bool bReference, const float* const* In, float* const* Out, int32 NumFrames, const float* Params)
+            {
+                const float DensityOffset = FMath::Abs(Params[0]) * 50.0f;
+                const bool bBiPolar = Params[1] > 0.0f;
+                const int32 BlockSize = FMath::Max(GetSplitFrame(Params[2], NumFrames), 1);
+                const uint32 Seed = static_cast<uint32>(FMath::Abs(Params[3]) * 65536.0f);
+
+                // Copied because the kernels clear their outputs before reading density
+                const TArray<float> Density[2] = { TArray<float>(In[0], NumFrames), TArray<float>(In[1], NumFrames) };
+
+                if (bReference)
+                {
+                    for (int32 Channel = 0; Channel < 2; ++Channel)
+                    {
+                        FDustKernel Kernel(Seed + Channel);
+                        Kernel.ProcessBuffer(Density[Channel].GetData(), DensityOffset, bBiPolar, Out[Channel], NumFrames);
+                    }
+                }
+                else
+                {
+                    FDustKernel Kernel(Seed);
+                    FSparseBufferWriter Writer;
+
+                    TArray<float> Block;
+                    Block.Init(std::numeric_limits<float>::quiet_NaN(), BlockSize);
+
+                    for (int32 Start = 0; Start < NumFrames; Start += BlockSize)
+                    {
+                        const int32 BlockFrames = FMath::Min(BlockSize, NumFrames - Start);
+                        Kernel.ProcessSparse(Density[0].GetData() + Start, DensityOffset, bBiPolar, Block.GetData(), BlockFrames, Writer);
+                        FMemory::Memcpy(Out[0] + Start, Block.GetData(), BlockFrames * sizeof(float));
+                    }
+
+                    FDustVoiceBatch Batch;
+                    Batch.Init(1, Seed + 1);
+
+                    const int32 Stride = Batch.GetStride();
+                    TArray<float> Offsets;
+                    TArray<float> InterleavedDensity;
+                    TArray<float> InterleavedOut;
+                    Offsets.Init(DensityOffset, Stride);
+                    InterleavedDensity.SetNumZeroed(NumFrames * Stride);
+                    InterleavedOut.SetNumZeroed(NumFrames * Stride);
+
+                    for (int32 i = 0; i < NumFrames; ++i)
+                    {
+                        InterleavedDensity[i * Stride] = Density[1][i];
+                    }
+
+                    Batch.ProcessInterleaved(InterleavedDensity.GetData(), Offsets.GetData(), bBiPolar, InterleavedOut.GetData(), NumFrames);
+
+                    for (int32 i = 0; i < NumFrames; ++i)
+                    {
+                        Out[1][i] = InterleavedOut[i * Stride];
+                    }
+                }
+            }});
+
+            return Cases;
+        }
+
+        float GetSpecialValue(FRandomStream& InRandom)
+        {
+            static const float SpecialValues[] =
+            {
+                0.0f, -0.0f, 1.0f, -1.0f,
+                TNumericLimits<float>::Max(), TNumericLimits<float>::Lowest(),
+                TNumericLimits<float>::Min(), -TNumericLimits<float>::Min(),
+                1.0e-40f, -1.0e-40f, // denormals
+                std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+                std::numeric_limits<float>::quiet_NaN()
+            };
+
+            return SpecialValues[InRandom.RandHelper(UE_ARRAY_COUNT(SpecialValues))];
+        }
+
+        void FillInput(FRandomStream& InRandom, float* OutBuffer, int32 NumFrames)
+        {
+            const int32 Pattern = InRandom.RandHelper(5);
+
+            for (int32 i = 0; i < NumFrames; ++i)
+            {
+                switch (Pattern)
+                {
+                    // Ordinary audio
+                    case 0:
+                        OutBuffer[i] = InRandom.FRandRange(-1.0f, 1.0f);
+                        break;
+
+                    // Values near the limits of the range, where rounding differences show first
+                    case 1:
+                        OutBuffer[i] = InRandom.FRandRange(-1.0f, 1.0f) * 1.0e37f;
+                        break;
+
+                    // Denormals only
+                    case 2:
+                        OutBuffer[i] = InRandom.FRandRange(-1.0f, 1.0f) * 1.0e-39f;
+                        break;
+
+                    // Audio with special values sprinkled in
+                    case 3:
+                        OutBuffer[i] = (InRandom.RandHelper(8) == 0) ? GetSpecialValue(InRandom) : InRandom.FRandRange(-1.0f, 1.0f);
+                        break;
+
+                    // Sign flips on every vector boundary
+                    default:
+                        OutBuffer[i] = ((i / StereoKernelVectorWidth) & 1) ? -0.5f : 0.5f;
+                        break;
+                }
+            }
+        }
+
+        // Control signals sweep past both ends of every range. NaN is left out: the reference clamp and the vector
+        // min/max treat it differently, and a NaN control value is not meaningful for either.
+        void FillModulation(FRandomStream& InRandom, float* OutBuffer, int32 NumFrames)
+        {
+            const bool bSmooth = InRandom.RandHelper(2) == 0;
+            const float Rate = InRandom.FRandRange(0.001f, 0.5f);
+
+            for (int32 i = 0; i < NumFrames; ++i)
+            {
+                OutBuffer[i] = bSmooth ? 3.0f * FMath::Sin(Rate * i) : InRandom.FRandRange(-3.0f, 3.0f);
+            }
+        }
+
+        float GetParam(FRandomStream& InRandom)
+        {
+            // Mostly in range, sometimes outside it or exactly on an edge to exercise clamping
+            switch (InRandom.RandHelper(4))
+            {
+                case 0:  return InRandom.FRandRange(-4.0f, 4.0f);
+                case 1:  return static_cast<float>(InRandom.RandRange(-1, 2));
+                default: return InRandom.FRandRange(-1.0f, 1.0f);
+            }
+        }
+    }
+
+    uint32 GetUlpDistance(float A, float B)
+    {
+        const bool bIsNaNA = FMath::IsNaN(A);
+        const bool bIsNaNB = FMath::IsNaN(B);
+
+        if (bIsNaNA || bIsNaNB)
+        {
+            return (bIsNaNA && bIsNaNB) ? 0 : MAX_uint32;
+        }
+
+        // Map the sign-magnitude bit patterns onto a single ordered integer line, with +0 and -0 both at zero
+        auto ToOrdered = [](float Value) -> int64
+        {
+            uint32 Bits;
+            FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+            const int64 Magnitude = Bits & 0x7FFFFFFF;
+            return (Bits & 0x80000000) ? -Magnitude : Magnitude;
+        };
+
+        const int64 Distance = FMath::Abs(ToOrdered(A) - ToOrdered(B));
+        return static_cast<uint32>(FMath::Min<int64>(Distance, MAX_uint32));
+    }
+
+    TArray<FKernelDiffResult> RunKernelDiff(int32 InSeed, int32 InNumIterations, uint32 InMaxAllowedUlp)
+    {
+        using namespace KernelDiffPrivate;
+
+        FRandomStream Random(InSeed);
+
+        // Extra room so buffers can start at an unaligned offset
+        const int32 BufferSize = MaxFrames + MaxOffset;
+
+        TArray<float> Inputs[MaxInputs];
+        TArray<float> ReferenceOutputs[2];
+        TArray<float> VectorOutputs[2];
+
+        for (TArray<float>& Buffer : Inputs)
+        {
+            Buffer.SetNumZeroed(BufferSize);
+        }
+        for (int32 i = 0; i < 2; ++i)
+        {
+            ReferenceOutputs[i].SetNumZeroed(BufferSize);
+            VectorOutputs[i].SetNumZeroed(BufferSize);
+        }
+
+        TArray<FKernelDiffResult> Results;
+
+        for (const FKernelCase& Case : GetKernelCases())
+        {
+            FKernelDiffResult& Result = Results.AddDefaulted_GetRef();
+            Result.KernelName = Case.Name;
+
+            for (int32 Iteration = 0; Iteration < InNumIterations; ++Iteration)
+            {
+                // Cover empty, shorter-than-a-vector and odd lengths as well as typical blocks
+                const int32 NumFrames = (Iteration % 4 == 0) ? Random.RandHelper(StereoKernelVectorWidth * 2) : Random.RandHelper(MaxFrames + 1);
+                const int32 Offset = Random.RandHelper(MaxOffset + 1);
+                const bool bInPlace = Random.RandHelper(4) == 0;
+
+                float Params[NumParams];
+                for (float& Param : Params)
+                {
+                    Param = GetParam(Random);
+                }
+
+                const float* InBuffers[MaxInputs] = {};
+                for (int32 Input = 0; Input < Case.NumInputs; ++Input)
+                {
+                    if (Case.bLastInputIsModulation && Input == Case.NumInputs - 1)
+                    {
+                        FillModulation(Random, Inputs[Input].GetData() + Offset, NumFrames);
+                    }
+                    else
+                    {
+                        FillInput(Random, Inputs[Input].GetData() + Offset, NumFrames);
+                    }
+                    InBuffers[Input] = Inputs[Input].GetData() + Offset;
+                }
+
+                float* ReferenceBuffers[2] = { ReferenceOutputs[0].GetData() + Offset, ReferenceOutputs[1].GetData() + Offset };
+                float* VectorBuffers[2] = { VectorOutputs[0].GetData() + Offset, VectorOutputs[1].GetData() + Offset };
+
+                if (bInPlace)
+                {
+                    // Process the first two inputs in place, the way operators do when outputs alias inputs
+                    const float* ReferenceIn[MaxInputs] = { ReferenceBuffers[0], ReferenceBuffers[1], InBuffers[2], InBuffers[3], InBuffers[4] };
+                    const float* VectorIn[MaxInputs] = { VectorBuffers[0], VectorBuffers[1], InBuffers[2], InBuffers[3], InBuffers[4] };
+
+                    for (int32 Channel = 0; Channel < 2; ++Channel)
+                    {
+                        FMemory::Memcpy(ReferenceBuffers[Channel], InBuffers[Channel], NumFrames * sizeof(float));
+                        FMemory::Memcpy(VectorBuffers[Channel], InBuffers[Channel], NumFrames * sizeof(float));
+                    }
+
+                    Case.Run(true, ReferenceIn, ReferenceBuffers, NumFrames, Params);
+                    Case.Run(false, VectorIn, VectorBuffers, NumFrames, Params);
+                }
+                else
+                {
+                    Case.Run(true, InBuffers, ReferenceBuffers, NumFrames, Params);
+                    Case.Run(false, InBuffers, VectorBuffers, NumFrames, Params);
+                }
+
+                for (int32 Channel = 0; Channel < 2; ++Channel)
+                {
+                    for (int32 i = 0; i < NumFrames; ++i)
+                    {
+                        const float Reference = ReferenceBuffers[Channel][i];
+                        const float Vector = VectorBuffers[Channel][i];
+                        const uint32 Ulp = GetUlpDistance(Reference, Vector);
+
+                        if (Ulp == MAX_uint32)
+                        {
+                            ++Result.NumNaNMismatches;
+                        }
+                        else if (Ulp > InMaxAllowedUlp && !(FMath::Abs(Reference - Vector) <= Case.RelativeTolerance * FMath::Max(1.0f, FMath::Abs(Reference))))
+                        {
+                            ++Result.NumMismatches;
+                        }
+
+                        if (Ulp > Result.MaxUlp)
+                        {
+                            Result.MaxUlp = Ulp;
+                            Result.WorstReference = Reference;
+                            Result.WorstVector = Vector;
+                        }
+                    }
+                }
+
+                Result.NumSamples += NumFrames * 2;
+            }
+        }
+
+        return Results;
+    }
+}
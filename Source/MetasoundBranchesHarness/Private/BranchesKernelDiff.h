@@ -0,0 +1,33 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace MetasoundBranches::Harness
+{
+    struct FKernelDiffResult
+    {
+        FString KernelName;
+        int64 NumSamples = 0;
+
+        // Largest distance in units in the last place between the vector path and the scalar reference
+        uint32 MaxUlp = 0;
+
+        // Samples over the allowed distance, and those where only one side was NaN
+        int64 NumMismatches = 0;
+        int64 NumNaNMismatches = 0;
+
+        // The pair of values that produced MaxUlp
+        float WorstReference = 0.0f;
+        float WorstVector = 0.0f;
+    };
+
+    // Distance between two floats in units in the last place. Two NaNs are equal, NaN against a number is MAX_uint32.
+    uint32 GetUlpDistance(float A, float B);
+
+    // Drives every kernel with a vector path through randomized and adversarial inputs
+    // (NaN, Inf, denormals, signed zeros, sign flips at vector boundaries, odd lengths and offsets, in-place buffers)
+    // and compares each output sample against the scalar reference.
+    TArray<FKernelDiffResult> RunKernelDiff(int32 InSeed, int32 InNumIterations, uint32 InMaxAllowedUlp);
+}
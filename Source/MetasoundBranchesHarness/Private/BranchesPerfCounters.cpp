@@ -0,0 +1,206 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranchesHarness/Private/BranchesPerfCounters.h"
+
+#if PLATFORM_LINUX
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+namespace MetasoundBranches::Harness
+{
+#if PLATFORM_LINUX
+    namespace PerfCountersPrivate
+    {
+        void GetEventConfig(EPerfCounter InCounter, uint32& OutType, uint64& OutConfig)
+        {
+            switch (InCounter)
+            {
+            case EPerfCounter::Cycles:
+                OutType = PERF_TYPE_HARDWARE;
+                OutConfig = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+
+            case EPerfCounter::Instructions:
+                OutType = PERF_TYPE_HARDWARE;
+                OutConfig = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+
+            case EPerfCounter::BranchMisses:
+                OutType = PERF_TYPE_HARDWARE;
+                OutConfig = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+
+            case EPerfCounter::L1DataMisses:
+                OutType = PERF_TYPE_HW_CACHE;
+                OutConfig = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                break;
+
+            case EPerfCounter::LastLevelCacheMisses:
+            default:
+                OutType = PERF_TYPE_HARDWARE;
+                OutConfig = PERF_COUNT_HW_CACHE_MISSES;
+                break;
+            }
+        }
+
+        int32 OpenEvent(EPerfCounter InCounter)
+        {
+            perf_event_attr Attributes;
+            FMemory::Memzero(Attributes);
+
+            GetEventConfig(InCounter, Attributes.type, Attributes.config);
+            Attributes.size = sizeof(Attributes);
+            Attributes.exclude_kernel = 1;
+            Attributes.exclude_hv = 1;
+            Attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            // This thread, any CPU, no group
+            return static_cast<int32>(syscall(SYS_perf_event_open, &Attributes, 0, -1, -1, 0));
+        }
+    }
+#endif
+
+    FPerfCounters::~FPerfCounters()
+    {
+        Close();
+    }
+
+    bool FPerfCounters::Open(FString& OutError)
+    {
+        Close();
+
+#if PLATFORM_LINUX
+        int32 LastErrno = 0;
+
+        for (int32 i = 0; i < FPerfCounterValues::NumCounters; ++i)
+        {
+            FileDescriptors[i] = PerfCountersPrivate::OpenEvent(static_cast<EPerfCounter>(i));
+            if (FileDescriptors[i] < 0)
+            {
+                LastErrno = errno;
+            }
+        }
+
+        if (!IsOpen())
+        {
+            OutError = (LastErrno == EACCES || LastErrno == EPERM)
+                ? TEXT("perf_event_open was refused; lower /proc/sys/kernel/perf_event_paranoid to 2 or below")
+                : FString::Printf(TEXT("perf_event_open failed (errno %d); the kernel or hypervisor may not expose hardware counters"), LastErrno);
+            return false;
+        }
+
+        Mark();
+        return true;
+#else
+        OutError = TEXT("Hardware counters are only available on Linux");
+        return false;
+#endif
+    }
+
+    void FPerfCounters::Close()
+    {
+        for (int32& FileDescriptor : FileDescriptors)
+        {
+#if PLATFORM_LINUX
+            if (FileDescriptor >= 0)
+            {
+                close(FileDescriptor);
+            }
+#endif
+            FileDescriptor = -1;
+        }
+    }
+
+    bool FPerfCounters::IsOpen() const
+    {
+        for (int32 FileDescriptor : FileDescriptors)
+        {
+            if (FileDescriptor >= 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool FPerfCounters::IsAvailable(EPerfCounter InCounter) const
+    {
+        return FileDescriptors[static_cast<int32>(InCounter)] >= 0;
+    }
+
+    void FPerfCounters::Accumulate(FPerfCounterValues& OutValues)
+    {
+        for (int32 i = 0; i < FPerfCounterValues::NumCounters; ++i)
+        {
+            if (FileDescriptors[i] >= 0)
+            {
+                // A scaled count can step back slightly between readings; treat that as nothing counted
+                const uint64 Value = ReadCounter(i);
+                OutValues.Values[i] += Value > LastValues[i] ? Value - LastValues[i] : 0;
+                LastValues[i] = Value;
+            }
+        }
+    }
+
+    void FPerfCounters::Mark()
+    {
+        for (int32 i = 0; i < FPerfCounterValues::NumCounters; ++i)
+        {
+            if (FileDescriptors[i] >= 0)
+            {
+                LastValues[i] = ReadCounter(i);
+            }
+        }
+    }
+
+    uint64 FPerfCounters::ReadCounter(int32 InIndex) const
+    {
+#if PLATFORM_LINUX
+        // Matches PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING
+        struct FReading
+        {
+            uint64 Value;
+            uint64 TimeEnabled;
+            uint64 TimeRunning;
+        };
+
+        FReading Reading;
+        if (read(FileDescriptors[InIndex], &Reading, sizeof(Reading)) != sizeof(Reading))
+        {
+            return LastValues[InIndex];
+        }
+
+        // Scale up a multiplexed counter by the share of time it was on the hardware
+        if (Reading.TimeRunning > 0 && Reading.TimeRunning < Reading.TimeEnabled)
+        {
+            return static_cast<uint64>(static_cast<double>(Reading.Value) * Reading.TimeEnabled / Reading.TimeRunning);
+        }
+
+        return Reading.Value;
+#else
+        return 0;
+#endif
+    }
+
+    const TCHAR* FPerfCounters::GetName(EPerfCounter InCounter)
+    {
+        switch (InCounter)
+        {
+        case EPerfCounter::Cycles:
+            return TEXT("Cycles");
+        case EPerfCounter::Instructions:
+            return TEXT("Instructions");
+        case EPerfCounter::BranchMisses:
+            return TEXT("BranchMisses");
+        case EPerfCounter::L1DataMisses:
+            return TEXT("L1DMisses");
+        case EPerfCounter::LastLevelCacheMisses:
+            return TEXT("LLCMisses");
+        default:
+            return TEXT("Unknown");
+        }
+    }
+}
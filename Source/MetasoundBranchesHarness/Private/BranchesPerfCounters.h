@@ -0,0 +1,74 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace MetasoundBranches::Harness
+{
+    enum class EPerfCounter : uint8
+    {
+        Cycles,
+        Instructions,
+        BranchMisses,
+        L1DataMisses,
+        LastLevelCacheMisses,
+
+        Num
+    };
+
+    struct FPerfCounterValues
+    {
+        static constexpr int32 NumCounters = static_cast<int32>(EPerfCounter::Num);
+
+        uint64 Values[NumCounters] = {};
+
+        uint64 operator[](EPerfCounter InCounter) const
+        {
+            return Values[static_cast<int32>(InCounter)];
+        }
+
+        // Instructions per cycle, or zero if cycles weren't counted
+        double GetInstructionsPerCycle() const
+        {
+            const uint64 Cycles = (*this)[EPerfCounter::Cycles];
+            return Cycles > 0 ? static_cast<double>((*this)[EPerfCounter::Instructions]) / Cycles : 0.0;
+        }
+    };
+
+    // Hardware performance counters for the calling thread, in user space only, read through perf_event_open.
+    //
+    // Linux only; elsewhere Open fails. Each counter is opened on its own so one the CPU or hypervisor doesn't
+    // expose doesn't lose the others. When there are more counters than hardware slots the kernel multiplexes
+    // them, and counts are scaled up from the time each one actually ran.
+    class FPerfCounters
+    {
+    public:
+        FPerfCounters() = default;
+        ~FPerfCounters();
+
+        FPerfCounters(const FPerfCounters&) = delete;
+        FPerfCounters& operator=(const FPerfCounters&) = delete;
+
+        // Starts counting on the calling thread. Returns false if no counter could be opened.
+        bool Open(FString& OutError);
+        void Close();
+
+        bool IsOpen() const;
+        bool IsAvailable(EPerfCounter InCounter) const;
+
+        // Adds the counts since the last call to OutValues. Unavailable counters stay as they were.
+        void Accumulate(FPerfCounterValues& OutValues);
+
+        // Takes a reading to diff against on the next Accumulate
+        void Mark();
+
+        static const TCHAR* GetName(EPerfCounter InCounter);
+
+    private:
+        uint64 ReadCounter(int32 InIndex) const;
+
+        int32 FileDescriptors[FPerfCounterValues::NumCounters] = { -1, -1, -1, -1, -1 };
+        uint64 LastValues[FPerfCounterValues::NumCounters] = {};
+    };
+}
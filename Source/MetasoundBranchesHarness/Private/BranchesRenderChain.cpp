@@ -0,0 +1,1082 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranchesHarness/Private/BranchesRenderChain.h"
+#include "MetasoundBranches/Public/DSP/AllPassConvolutionKernel.h"
+#include "MetasoundBranches/Public/DSP/AllPassKernel.h"
+#include "MetasoundBranches/Public/DSP/ClockDividerKernel.h"
+#include "MetasoundBranches/Public/DSP/DustKernel.h"
+#include "MetasoundBranches/Public/DSP/EdgeKernel.h"
+#include "MetasoundBranches/Public/DSP/EnvelopeFollowerKernel.h"
+#include "MetasoundBranches/Public/DSP/ShiftRegisterKernel.h"
+#include "MetasoundBranches/Public/DSP/SlewKernel.h"
+#include "MetasoundBranches/Public/DSP/StereoKernels.h"
+#include "MetasoundBranches/Public/DSP/TuningKernel.h"
+#include "MetasoundBranches/Public/DSP/ZeroCrossingKernel.h"
+
+namespace MetasoundBranches::Harness
+{
+    namespace RenderChainPrivate
+    {
+        using FParams = TMap<FString, float>;
+
+        class FSlewProcessor : public IRenderProcessor
+        {
+        public:
+            FSlewProcessor(int32 InNumChannels, float InSampleRate, float InRiseTime, float InFallTime, bool bInLinear)
+                : bLinear(bInLinear)
+            {
+                Kernels.SetNum(InNumChannels);
+                LinearKernels.SetNum(InNumChannels);
+                RiseAlpha = FSlewKernel::GetAlpha(InRiseTime, InSampleRate);
+                FallAlpha = FSlewKernel::GetAlpha(InFallTime, InSampleRate);
+                RiseStep = FLinearSlewKernel::GetStep(InRiseTime, InSampleRate);
+                FallStep = FLinearSlewKernel::GetStep(InFallTime, InSampleRate);
+            }
+
+            virtual const TCHAR* GetName() const override { return TEXT("Slew"); }
+
+            virtual void Reset() override
+            {
+                for (FSlewKernel& Kernel : Kernels)
+                {
+                    Kernel.Reset();
+                }
+                for (FLinearSlewKernel& Kernel : LinearKernels)
+                {
+                    Kernel.Reset();
+                }
+            }
+
+            virtual void Process(TArrayView<float* const> InOutChannels, int32 NumFrames) override
+            {
+                for (int32 Channel = 0; Channel < Kernels.Num(); ++Channel)
+                {
+                    if (bLinear)
+                    {
+                        LinearKernels[Channel].ProcessBuffer(InOutChannels[Channel], InOutChannels[Channel], NumFrames, RiseStep, FallStep, [](int32) {});
+                        continue;
+                    }
+
+                    Kernels[Channel].ProcessBuffer(InOutChannels[Channel], InOutChannels[Channel], NumFrames, RiseAlpha, FallAlpha);
+                }
+            }
+
+        private:
+            TArray<FSlewKernel> Kernels;
+            TArray<FLinearSlewKernel> LinearKernels;
+            float RiseAlpha = 0.0f;
+            float FallAlpha = 0.0f;
+            float RiseStep = 0.0f;
+            float FallStep = 0.0f;
+            bool bLinear = false;
+        };
+
+        // All channels share one multichannel cascade. Spread fans the channel coefficients out evenly
+        // either side of the default, as the stereo node does for two channels.
+        class FDisperserProcessor : public IRenderProcessor
+        {
+        public:
+            static constexpr float MaxFeedbackOffset = 0.1f;
+
+            FDisperserProcessor(int32 InNumChannels, int32 InNumStages, float InSpread)
+                : Kernel(InNumChannels, InNumStages)
+                , NumStages(InNumStages)
+            {
+                const float Offset = FMath::Clamp(InSpread, 0.0f, 1.0f) * MaxFeedbackOffset;
+
+                for (int32 Channel = 0; InNumChannels > 1 && Channel < InNumChannels; ++Channel)
+                {
+                    const float Position = 2.0f * Channel / (InNumChannels - 1) - 1.0f;
+                    Kernel.SetChannelFeedback(Channel, FPhaseDisperserKernel::Feedback + Position * Offset);
+                }
+            }
+
+            virtual const TCHAR* GetName() const override { return TEXT("Disperser"); }
+
+            virtual void Reset() override
+            {
+                Kernel.Reset();
+            }
+
+            virtual void Process(TArrayView<float* const> InOutChannels, int32 NumFrames) override
+            {
+                Kernel.ProcessInPlace(InOutChannels, NumFrames, NumStages);
+            }
+
+        private:
+            FMultichannelPhaseDisperserKernel Kernel;
+            int32 NumStages = 1;
+        };
+
+        // The Disperser cascade run as a partitioned convolution, one filter per channel, for comparing against the
+        // cascade's output and speed at high stage counts
+        class FConvolutionDisperserProcessor : public IRenderProcessor
+        {
+        public:
+            bool Init(int32 InNumChannels, int32 InNumStages)
+            {
+                Kernels.SetNum(InNumChannels);
+                for (FPhaseDisperserConvolutionKernel& Kernel : Kernels)
+                {
+                    if (!Kernel.Init(InNumStages))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            virtual const TCHAR* GetName() const override { return TEXT("DisperserFFT"); }
+
+            virtual void Reset() override
+            {
+                for (FPhaseDisperserConvolutionKernel& Kernel : Kernels)
+                {
+                    Kernel.Reset();
+                }
+            }
+
+            virtual void Process(TArrayView<float* const> InOutChannels, int32 NumFrames) override
+            {
+                for (int32 Channel = 0; Channel < Kernels.Num(); ++Channel)
+                {
+                    Kernels[Channel].Process(InOutChannels[Channel], InOutChannels[Channel], NumFrames);
+                }
+            }
+
+        private:
+            TArray<FPhaseDisperserConvolutionKernel> Kernels;
+        };
+
+        // Stateless stereo stages share the same shape, only the kernel call differs
+        template <typename FuncType>
+        class TStereoProcessor : public IRenderProcessor
+        {
+        public:
+            TStereoProcessor(const TCHAR* InName, FuncType&& InFunc)
+                : Name(InName)
+                , Func(MoveTemp(InFunc))
+            {
+            }
+
+            virtual const TCHAR* GetName() const override { return Name; }
+            virtual void Reset() override {}
+
+            virtual void Process(TArrayView<float* const> InOutChannels, int32 NumFrames) override
+            {
+                Func(InOutChannels[0], InOutChannels[1], NumFrames);
+            }
+
+        private:
+            const TCHAR* Name;
+            FuncType Func;
+        };
+
+        template <typename FuncType>
+        TUniquePtr<IRenderProcessor> MakeStereoProcessor(const TCHAR* InName, FuncType&& InFunc)
+        {
+            return MakeUnique<TStereoProcessor<FuncType>>(InName, MoveTemp(InFunc));
+        }
+
+        // Per-sample stages with no state share the same shape, only the mapping differs
+        template <typename FuncType>
+        class TSampleProcessor : public IRenderProcessor
+        {
+        public:
+            TSampleProcessor(const TCHAR* InName, FuncType&& InFunc)
+                : Name(InName)
+                , Func(MoveTemp(InFunc))
+            {
+            }
+
+            virtual const TCHAR* GetName() const override { return Name; }
+            virtual void Reset() override {}
+
+            virtual void Process(TArrayView<float* const> InOutChannels, int32 NumFrames) override
+            {
+                for (float* Data : InOutChannels)
+                {
+                    for (int32 i = 0; i < NumFrames; ++i)
+                    {
+                        Data[i] = Func(Data[i]);
+                    }
+                }
+            }
+
+        private:
+            const TCHAR* Name;
+            FuncType Func;
+        };
+
+        template <typename FuncType>
+        TUniquePtr<IRenderProcessor> MakeSampleProcessor(const TCHAR* InName, FuncType&& InFunc)
+        {
+            return MakeUnique<TSampleProcessor<FuncType>>(InName, MoveTemp(InFunc));
+        }
+
+        // Stands in for a trigger input: ticks every period from the first frame after a reset, counting across
+        // blocks, so a stage driven by it renders the same at any block size
+        class FRenderClock
+        {
+        public:
+            static int32 GetPeriodFrames(float InPeriodSeconds, float InSampleRate)
+            {
+                return FMath::Max(FMath::RoundToInt(InPeriodSeconds * InSampleRate), 1);
+            }
+
+            explicit FRenderClock(int32 InPeriodFrames)
+                : PeriodFrames(FMath::Max(InPeriodFrames, 1))
+            {
+            }
+
+            void Reset()
+            {
+                FramesUntilTick = 0;
+            }
+
+            // Replaces OutFrames with the frames that tick in the next block
+            void Advance(int32 NumFrames, TArray<int32>& OutFrames)
+            {
+                OutFrames.Reset();
+
+                int32 Frame = FramesUntilTick;
+                for (; Frame < NumFrames; Frame += PeriodFrames)
+                {
+                    OutFrames.Add(Frame);
+                }
+
+                FramesUntilTick = Frame - NumFrames;
+            }
+
+        private:
+            int32 PeriodFrames = 1;
+            int32 FramesUntilTick = 0;
+        };
+
+        // Every channel is replaced by one output of a divider clocked by the render clock, as impulses.
+        // An optional second clock resets the count.
+        class FClockDividerProcessor : public IRenderProcessor
+        {
+        public:
+            FClockDividerProcessor(int32 InPeriodFrames, int32 InResetPeriodFrames, int32 InOutput)
+                : Clock(InPeriodFrames)
+                , ResetClock(InResetPeriodFrames)
+                , OutputMask(1u << (FMath::Clamp(InOutput, 1, FClockDividerKernel::NumOutputs) - 1))
+                , bHasReset(InResetPeriodFrames > 0)
+            {
+            }
+
+            virtual const TCHAR* GetName() const override { return TEXT("ClockDivider"); }
+
+            virtual void Reset() override
+            {
+                Divider.Reset();
+                Clock.Reset();
+                ResetClock.Reset();
+            }
+
+            virtual void Process(TArrayView<float* const> InOutChannels, int32 NumFrames) override
+            {
+                Clock.Advance(NumFrames, TriggerFrames);
+                ResetFrames.Reset();
+                if (bHasReset)
+                {
+                    ResetClock.Advance(NumFrames, ResetFrames);
+                }
+
+                float* Output = InOutChannels[0];
+                FMemory::Memzero(Output, NumFrames * sizeof(float));
+
+                Divider.ProcessTriggers(
+                    TriggerFrames.Num(), [this](int32 Index) { return TriggerFrames[Index]; },
+                    ResetFrames.Num(), [this](int32 Index) { return ResetFrames[Index]; },
+                    [this, Output](int32 Frame, uint32 Mask)
+                    {
+                        if (Mask & OutputMask)
+                        {
+                            Output[Frame] = 1.0f;
+                        }
+                    });
+
+                for (int32 Channel = 1; Channel < InOutChannels.Num(); ++Channel)
+                {
+                    FMemory::Memcpy(InOutChannels[Channel], Output, NumFrames * sizeof(float));
+                }
+            }
+
+        private:
+            FClockDividerKernel Divider;
+            FRenderClock Clock;
+            FRenderClock ResetClock;
+            TArray<int32> TriggerFrames;
+            TArray<int32> ResetFrames;
+            uint32 OutputMask = 1;
+            bool bHasReset = false;
+        };
+
+        // Each channel shifts its own value in on every clock tick and is replaced by one stage, held between ticks
+        class FShiftRegisterProcessor : public IRenderProcessor
+        {
+        public:
+            FShiftRegisterProcessor(int32 InNumChannels, int32 InPeriodFrames, int32 InStage)
+                : Clock(InPeriodFrames)
+                , StageIndex(FMath::Clamp(InStage, 1, FShiftRegisterKernel::NumStages) - 1)
+            {
+                Registers.SetNum(InNumChannels);
+            }
+
+            virtual const TCHAR* GetName() const override { return TEXT("ShiftRegister"); }
+
+            virtual void Reset() override
+            {
+                for (FShiftRegisterKernel& Register : Registers)
+                {
+                    Register.Reset();
+                }
+                Clock.Reset();
+            }
+
+            virtual void Process(TArrayView<float* const> InOutChannels, int32 NumFrames) override
+            {
+                Clock.Advance(NumFrames, TickFrames);
+
+                for (int32 Channel = 0; Channel < Registers.Num(); ++Channel)
+                {
+                    float* Data = InOutChannels[Channel];
+                    FShiftRegisterKernel& Register = Registers[Channel];
+
+                    // The value at each tick is read before the hold up to it overwrites anything past it
+                    int32 Frame = 0;
+                    for (const int32 TickFrame : TickFrames)
+                    {
+                        Hold(Data + Frame, TickFrame - Frame, Register.GetStage(StageIndex));
+                        Register.Shift(Data[TickFrame]);
+                        Frame = TickFrame;
+                    }
+                    Hold(Data + Frame, NumFrames - Frame, Register.GetStage(StageIndex));
+                }
+            }
+
+        private:
+            static void Hold(float* OutData, int32 NumFrames, float InValue)
+            {
+                for (int32 i = 0; i < NumFrames; ++i)
+                {
+                    OutData[i] = InValue;
+                }
+            }
+
+            TArray<FShiftRegisterKernel> Registers;
+            FRenderClock Clock;
+            TArray<int32> TickFrames;
+            int32 StageIndex = 0;
+        };
+
+        // Every channel is replaced by an impulse on each clock tick, alternating in sign when bipolar, as Impulse
+        // writes them
+        class FImpulseProcessor : public IRenderProcessor
+        {
+        public:
+            FImpulseProcessor(int32 InPeriodFrames, bool bInBiPolar)
+                : Clock(InPeriodFrames)
+                , bBiPolar(bInBiPolar)
+            {
+            }
+
+            virtual const TCHAR* GetName() const override { return TEXT("Impulse"); }
+
+            virtual void Reset() override
+            {
+                Clock.Reset();
+                bSignalIsPositive = true;
+            }
+
+            virtual void Process(TArrayView<float* const> InOutChannels, int32 NumFrames) override
+            {
+                Clock.Advance(NumFrames, TickFrames);
+
+                float* Output = InOutChannels[0];
+                FMemory::Memzero(Output, NumFrames * sizeof(float));
+
+                for (const int32 TickFrame : TickFrames)
+                {
+                    Output[TickFrame] = bSignalIsPositive ? 1.0f : -1.0f;
+                    bSignalIsPositive = !bBiPolar || !bSignalIsPositive;
+                }
+
+                for (int32 Channel = 1; Channel < InOutChannels.Num(); ++Channel)
+                {
+                    FMemory::Memcpy(InOutChannels[Channel], Output, NumFrames * sizeof(float));
+                }
+            }
+
+        private:
+            FRenderClock Clock;
+            TArray<int32> TickFrames;
+            bool bBiPolar = false;
+            bool bSignalIsPositive = true;
+        };
+
+        // Each channel drives the density of its own generator and is replaced by its impulses. Channels are
+        // seeded one apart so they don't fire together.
+        class FDustProcessor : public IRenderProcessor
+        {
+        public:
+            FDustProcessor(int32 InNumChannels, float InDensityOffset, bool bInBiPolar, uint32 InSeed)
+                : DensityOffset(InDensityOffset)
+                , bBiPolar(bInBiPolar)
+            {
+                for (int32 Channel = 0; Channel < InNumChannels; ++Channel)
+                {
+                    Kernels.Emplace(InSeed + Channel);
+                }
+            }
+
+            virtual const TCHAR* GetName() const override { return TEXT("Dust"); }
+
+            virtual void Reset() override
+            {
+                for (FDustKernel& Kernel : Kernels)
+                {
+                    Kernel.Reset();
+                }
+            }
+
+            virtual void Process(TArrayView<float* const> InOutChannels, int32 NumFrames) override
+            {
+                // The kernel clears its output before reading the density, so the density is copied out first
+                Density.SetNumUninitialized(NumFrames, EAllowShrinking::No);
+
+                for (int32 Channel = 0; Channel < Kernels.Num(); ++Channel)
+                {
+                    FMemory::Memcpy(Density.GetData(), InOutChannels[Channel], NumFrames * sizeof(float));
+                    Kernels[Channel].ProcessBuffer(Density.GetData(), DensityOffset, bBiPolar, InOutChannels[Channel], NumFrames);
+                }
+            }
+
+        private:
+            TArray<FDustKernel> Kernels;
+            TArray<float> Density;
+            float DensityOffset = 0.0f;
+            bool bBiPolar = false;
+        };
+
+        // Each channel is replaced by +1 at every rise and -1 at every fall, zero elsewhere
+        class FEdgeProcessor : public IRenderProcessor
+        {
+        public:
+            FEdgeProcessor(int32 InNumChannels, int32 InDebounceSamples)
+                : DebounceSamples(InDebounceSamples)
+            {
+                Kernels.SetNum(InNumChannels);
+            }
+
+            virtual const TCHAR* GetName() const override { return TEXT("Edge"); }
+
+            virtual void Reset() override
+            {
+                for (FEdgeKernel& Kernel : Kernels)
+                {
+                    Kernel.Reset();
+                }
+            }
+
+            virtual void Process(TArrayView<float* const> InOutChannels, int32 NumFrames) override
+            {
+                Signal.SetNumUninitialized(NumFrames, EAllowShrinking::No);
+
+                for (int32 Channel = 0; Channel < Kernels.Num(); ++Channel)
+                {
+                    float* Output = InOutChannels[Channel];
+                    FMemory::Memcpy(Signal.GetData(), Output, NumFrames * sizeof(float));
+                    FMemory::Memzero(Output, NumFrames * sizeof(float));
+
+                    Kernels[Channel].ProcessBuffer(Signal.GetData(), NumFrames, DebounceSamples,
+                        [Output](int32 Frame) { Output[Frame] = 1.0f; },
+                        [Output](int32 Frame) { Output[Frame] = -1.0f; });
+                }
+            }
+
+        private:
+            TArray<FEdgeKernel> Kernels;
+            TArray<float> Signal;
+            int32 DebounceSamples = 0;
+        };
+
+        // Each channel is replaced by an impulse at every zero crossing
+        class FZeroCrossingProcessor : public IRenderProcessor
+        {
+        public:
+            FZeroCrossingProcessor(int32 InNumChannels, int32 InDebounceSamples)
+                : DebounceSamples(InDebounceSamples)
+            {
+                Kernels.SetNum(InNumChannels);
+            }
+
+            virtual const TCHAR* GetName() const override { return TEXT("ZeroCrossing"); }
+
+            virtual void Reset() override
+            {
+                for (FZeroCrossingKernel& Kernel : Kernels)
+                {
+                    Kernel.Reset();
+                }
+            }
+
+            virtual void Process(TArrayView<float* const> InOutChannels, int32 NumFrames) override
+            {
+                Signal.SetNumUninitialized(NumFrames, EAllowShrinking::No);
+
+                for (int32 Channel = 0; Channel < Kernels.Num(); ++Channel)
+                {
+                    float* Output = InOutChannels[Channel];
+                    FMemory::Memcpy(Signal.GetData(), Output, NumFrames * sizeof(float));
+                    FMemory::Memzero(Output, NumFrames * sizeof(float));
+
+                    Kernels[Channel].ProcessBuffer(Signal.GetData(), NumFrames, DebounceSamples,
+                        [Output](int32 Frame) { Output[Frame] = 1.0f; });
+                }
+            }
+
+        private:
+            TArray<FZeroCrossingKernel> Kernels;
+            TArray<float> Signal;
+            int32 DebounceSamples = 0;
+        };
+
+        // Each channel is read as a bool (true above zero) and replaced by the slewed 0/1 that Bool To Audio
+        // writes. The node sees one value per block; here every run of equal values is one ProcessConstant call,
+        // which is what the node does for a bool that changes on those frames.
+        class FBoolToAudioProcessor : public IRenderProcessor
+        {
+        public:
+            FBoolToAudioProcessor(int32 InNumChannels, float InSampleRate, float InRiseTime, float InFallTime)
+            {
+                Kernels.SetNum(InNumChannels);
+                RiseAlpha = FSlewKernel::GetAlpha(InRiseTime, InSampleRate);
+                FallAlpha = FSlewKernel::GetAlpha(InFallTime, InSampleRate);
+            }
+
+            virtual const TCHAR* GetName() const override { return TEXT("BoolToAudio"); }
+
+            virtual void Reset() override
+            {
+                for (FSlewKernel& Kernel : Kernels)
+                {
+                    Kernel.Reset();
+                }
+            }
+
+            virtual void Process(TArrayView<float* const> InOutChannels, int32 NumFrames) override
+            {
+                for (int32 Channel = 0; Channel < Kernels.Num(); ++Channel)
+                {
+                    float* Data = InOutChannels[Channel];
+
+                    int32 Start = 0;
+                    while (Start < NumFrames)
+                    {
+                        const bool bValue = Data[Start] > 0.0f;
+
+                        int32 End = Start + 1;
+                        while (End < NumFrames && (Data[End] > 0.0f) == bValue)
+                        {
+                            ++End;
+                        }
+
+                        Kernels[Channel].ProcessConstant(bValue ? 1.0f : 0.0f, Data + Start, End - Start, RiseAlpha, FallAlpha);
+                        Start = End;
+                    }
+                }
+            }
+
+        private:
+            TArray<FSlewKernel> Kernels;
+            float RiseAlpha = 0.0f;
+            float FallAlpha = 0.0f;
+        };
+
+        class FEnvelopeProcessor : public IRenderProcessor
+        {
+        public:
+            FEnvelopeProcessor(int32 InNumChannels, float InSampleRate, float InAttackTime, float InReleaseTime, int32 InMode, float InWindowSeconds, int32 InDecimation)
+                : Decimation(FMath::Max(InDecimation, 1))
+            {
+                Kernels.SetNum(InNumChannels);
+                for (FEnvelopeFollowerKernel& Kernel : Kernels)
+                {
+                    Kernel.SetMode(FEnvelopeFollowerKernel::GetMode(InMode));
+                    Kernel.InitWindow(FEnvelopeFollowerKernel::GetMaxWindowSamples(InSampleRate));
+                    Kernel.SetWindowLength(FMath::RoundToInt(FMath::Clamp(InWindowSeconds, 0.0f, FEnvelopeFollowerKernel::MaxWindowSeconds) * InSampleRate));
+                }
+
+                AttackAlpha = FSlewKernel::GetAlpha(InAttackTime, InSampleRate);
+                ReleaseAlpha = FSlewKernel::GetAlpha(InReleaseTime, InSampleRate);
+            }
+
+            virtual const TCHAR* GetName() const override { return TEXT("Envelope"); }
+
+            virtual void Reset() override
+            {
+                for (FEnvelopeFollowerKernel& Kernel : Kernels)
+                {
+                    Kernel.Reset();
+                }
+            }
+
+            virtual void Process(TArrayView<float* const> InOutChannels, int32 NumFrames) override
+            {
+                for (int32 Channel = 0; Channel < Kernels.Num(); ++Channel)
+                {
+                    Kernels[Channel].ProcessBuffer(InOutChannels[Channel], InOutChannels[Channel], NumFrames, AttackAlpha, ReleaseAlpha, Decimation);
+                }
+            }
+
+        private:
+            TArray<FEnvelopeFollowerKernel> Kernels;
+            float AttackAlpha = 0.0f;
+            float ReleaseAlpha = 0.0f;
+            int32 Decimation = 1;
+        };
+
+        // Each channel, mapped to a pitch in notes, is replaced by the quantized note or its frequency
+        class FQuantizeProcessor : public IRenderProcessor
+        {
+        public:
+            FQuantizeProcessor(int32 InNumChannels, const float (&InCents)[FTuningTable::NumPitchClasses], int32 InScale, float InHysteresis, float InBase, float InRange, bool bInOutputFrequency)
+                : Hysteresis(InHysteresis)
+                , Base(InBase)
+                , Range(InRange)
+                , bOutputFrequency(bInOutputFrequency)
+            {
+                Kernels.SetNum(InNumChannels);
+                for (FTuningQuantizer& Kernel : Kernels)
+                {
+                    Kernel.SetTuning(InCents, InScale);
+                }
+            }
+
+            virtual const TCHAR* GetName() const override { return TEXT("Quantize"); }
+
+            virtual void Reset() override
+            {
+                for (FTuningQuantizer& Kernel : Kernels)
+                {
+                    Kernel.Reset();
+                }
+            }
+
+            virtual void Process(TArrayView<float* const> InOutChannels, int32 NumFrames) override
+            {
+                Pitch.SetNumUninitialized(NumFrames, EAllowShrinking::No);
+                Unused.SetNumUninitialized(NumFrames, EAllowShrinking::No);
+
+                for (int32 Channel = 0; Channel < Kernels.Num(); ++Channel)
+                {
+                    float* Data = InOutChannels[Channel];
+                    for (int32 i = 0; i < NumFrames; ++i)
+                    {
+                        Pitch[i] = Base + Range * Data[i];
+                    }
+
+                    float* OutNote = bOutputFrequency ? Unused.GetData() : Data;
+                    float* OutFrequency = bOutputFrequency ? Data : Unused.GetData();
+                    Kernels[Channel].ProcessBuffer(Pitch.GetData(), OutNote, OutFrequency, NumFrames, Hysteresis, [](int32) {});
+                }
+            }
+
+        private:
+            TArray<FTuningQuantizer> Kernels;
+            TArray<float> Pitch;
+            TArray<float> Unused;
+            float Hysteresis = 0.0f;
+            float Base = 0.0f;
+            float Range = 0.0f;
+            bool bOutputFrequency = false;
+        };
+
+        bool ParseParams(const TArray<FString>& InTokens, FParams& OutParams, FString& OutError)
+        {
+            for (int32 i = 1; i < InTokens.Num(); ++i)
+            {
+                FString Key;
+                FString Value;
+                if (!InTokens[i].Split(TEXT("="), &Key, &Value) || !Value.IsNumeric())
+                {
+                    OutError = FString::Printf(TEXT("Malformed parameter '%s' for %s"), *InTokens[i], *InTokens[0]);
+                    return false;
+                }
+                OutParams.Add(Key, FCString::Atof(*Value));
+            }
+            return true;
+        }
+
+        bool CheckParams(const FString& InStage, const FParams& InParams, std::initializer_list<const TCHAR*> InAllowed, FString& OutError)
+        {
+            for (const TPair<FString, float>& Param : InParams)
+            {
+                bool bAllowed = false;
+                for (const TCHAR* Allowed : InAllowed)
+                {
+                    bAllowed |= (Param.Key == Allowed);
+                }
+
+                if (!bAllowed)
+                {
+                    OutError = FString::Printf(TEXT("Unknown parameter '%s' for %s"), *Param.Key, *InStage);
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        float GetParam(const FParams& InParams, const TCHAR* InKey, float InDefault)
+        {
+            // FString keys compare case-insensitively
+            const float* Value = InParams.Find(InKey);
+            return Value ? *Value : InDefault;
+        }
+    }
+
+    bool FRenderChain::Init(const FString& InSpec, int32 InNumChannels, float InSampleRate, FString& OutError)
+    {
+        using namespace RenderChainPrivate;
+
+        Processors.Reset();
+        ProcessorCycles.Reset();
+
+        TArray<FString> Stages;
+        InSpec.ParseIntoArray(Stages, TEXT("+"));
+
+        if (Stages.IsEmpty())
+        {
+            OutError = TEXT("Empty chain");
+            return false;
+        }
+
+        for (const FString& Stage : Stages)
+        {
+            TArray<FString> Tokens;
+            Stage.ParseIntoArray(Tokens, TEXT(":"));
+
+            FParams Params;
+            if (!ParseParams(Tokens, Params, OutError))
+            {
+                return false;
+            }
+
+            const FString& Type = Tokens[0];
+            const bool bIsStereoStage = Type == TEXT("Gain") || Type == TEXT("Balance") || Type == TEXT("Width") || Type == TEXT("Invert") || Type == TEXT("Strip");
+
+            if (bIsStereoStage && InNumChannels != 2)
+            {
+                OutError = FString::Printf(TEXT("%s needs a stereo input (got %d channels)"), *Type, InNumChannels);
+                return false;
+            }
+
+            TUniquePtr<IRenderProcessor> Processor;
+
+            if (Type.Equals(TEXT("Slew"), ESearchCase::IgnoreCase))
+            {
+                if (CheckParams(Type, Params, { TEXT("Rise"), TEXT("Fall"), TEXT("Linear") }, OutError))
+                {
+                    Processor = MakeUnique<FSlewProcessor>(InNumChannels, InSampleRate,
+                        GetParam(Params, TEXT("Rise"), 0.1f), GetParam(Params, TEXT("Fall"), 0.1f), GetParam(Params, TEXT("Linear"), 0.0f) != 0.0f);
+                }
+            }
+            else if (Type.Equals(TEXT("Disperser"), ESearchCase::IgnoreCase))
+            {
+                if (CheckParams(Type, Params, { TEXT("Stages"), TEXT("Spread") }, OutError))
+                {
+                    Processor = MakeUnique<FDisperserProcessor>(InNumChannels, FMath::RoundToInt(GetParam(Params, TEXT("Stages"), 8.0f)), GetParam(Params, TEXT("Spread"), 0.0f));
+                }
+            }
+            else if (Type.Equals(TEXT("DisperserFFT"), ESearchCase::IgnoreCase))
+            {
+                if (CheckParams(Type, Params, { TEXT("Stages") }, OutError))
+                {
+                    TUniquePtr<FConvolutionDisperserProcessor> Convolution = MakeUnique<FConvolutionDisperserProcessor>();
+                    if (Convolution->Init(InNumChannels, FMath::RoundToInt(GetParam(Params, TEXT("Stages"), 8.0f))))
+                    {
+                        Processor = MoveTemp(Convolution);
+                    }
+                    else
+                    {
+                        OutError = TEXT("No FFT of the size DisperserFFT needs is available on this platform");
+                    }
+                }
+            }
+            else if (Type.Equals(TEXT("Gain"), ESearchCase::IgnoreCase))
+            {
+                if (CheckParams(Type, Params, { TEXT("Gain") }, OutError))
+                {
+                    const float Gain = GetParam(Params, TEXT("Gain"), 1.0f);
+                    Processor = MakeStereoProcessor(TEXT("Gain"), [Gain](float* Left, float* Right, int32 NumFrames)
+                    {
+                        ProcessStereoGain(Left, Right, Left, Right, NumFrames, Gain);
+                    });
+                }
+            }
+            else if (Type.Equals(TEXT("Balance"), ESearchCase::IgnoreCase))
+            {
+                if (CheckParams(Type, Params, { TEXT("Balance") }, OutError))
+                {
+                    const float Balance = GetParam(Params, TEXT("Balance"), 0.0f);
+                    Processor = MakeStereoProcessor(TEXT("Balance"), [Balance](float* Left, float* Right, int32 NumFrames)
+                    {
+                        ProcessStereoBalance(Left, Right, Left, Right, NumFrames, Balance);
+                    });
+                }
+            }
+            else if (Type.Equals(TEXT("Width"), ESearchCase::IgnoreCase))
+            {
+                if (CheckParams(Type, Params, { TEXT("Width") }, OutError))
+                {
+                    const float Width = GetParam(Params, TEXT("Width"), 1.0f);
+                    Processor = MakeStereoProcessor(TEXT("Width"), [Width](float* Left, float* Right, int32 NumFrames)
+                    {
+                        ProcessStereoWidth(Left, Right, Left, Right, NumFrames, Width);
+                    });
+                }
+            }
+            else if (Type.Equals(TEXT("Invert"), ESearchCase::IgnoreCase))
+            {
+                if (CheckParams(Type, Params, { TEXT("L"), TEXT("R"), TEXT("Swap") }, OutError))
+                {
+                    const bool bInvertLeft = GetParam(Params, TEXT("L"), 0.0f) != 0.0f;
+                    const bool bInvertRight = GetParam(Params, TEXT("R"), 0.0f) != 0.0f;
+                    const bool bSwap = GetParam(Params, TEXT("Swap"), 0.0f) != 0.0f;
+                    Processor = MakeStereoProcessor(TEXT("Invert"), [bInvertLeft, bInvertRight, bSwap](float* Left, float* Right, int32 NumFrames)
+                    {
+                        ProcessStereoInverter(Left, Right, Left, Right, NumFrames, bInvertLeft, bInvertRight, bSwap);
+                    });
+                }
+            }
+            else if (Type.Equals(TEXT("Strip"), ESearchCase::IgnoreCase))
+            {
+                if (CheckParams(Type, Params, { TEXT("L"), TEXT("R"), TEXT("Swap"), TEXT("Width"), TEXT("Balance"), TEXT("Gain") }, OutError))
+                {
+                    const FStereoMatrix Matrix = GetStereoStripMatrix(
+                        GetParam(Params, TEXT("L"), 0.0f) != 0.0f,
+                        GetParam(Params, TEXT("R"), 0.0f) != 0.0f,
+                        GetParam(Params, TEXT("Swap"), 0.0f) != 0.0f,
+                        GetParam(Params, TEXT("Width"), 1.0f),
+                        GetParam(Params, TEXT("Balance"), 0.0f),
+                        GetParam(Params, TEXT("Gain"), 1.0f));
+
+                    Processor = MakeStereoProcessor(TEXT("Strip"), [Matrix](float* Left, float* Right, int32 NumFrames)
+                    {
+                        ProcessStereoMatrix(Left, Right, Left, Right, NumFrames, Matrix);
+                    });
+                }
+            }
+            else if (Type.Equals(TEXT("ClockDivider"), ESearchCase::IgnoreCase))
+            {
+                if (CheckParams(Type, Params, { TEXT("Period"), TEXT("Reset"), TEXT("Output") }, OutError))
+                {
+                    const float ResetPeriod = GetParam(Params, TEXT("Reset"), 0.0f);
+                    Processor = MakeUnique<FClockDividerProcessor>(
+                        FRenderClock::GetPeriodFrames(GetParam(Params, TEXT("Period"), 0.1f), InSampleRate),
+                        ResetPeriod > 0.0f ? FRenderClock::GetPeriodFrames(ResetPeriod, InSampleRate) : 0,
+                        FMath::RoundToInt(GetParam(Params, TEXT("Output"), 1.0f)));
+                }
+            }
+            else if (Type.Equals(TEXT("ShiftRegister"), ESearchCase::IgnoreCase))
+            {
+                if (CheckParams(Type, Params, { TEXT("Period"), TEXT("Stage") }, OutError))
+                {
+                    Processor = MakeUnique<FShiftRegisterProcessor>(InNumChannels,
+                        FRenderClock::GetPeriodFrames(GetParam(Params, TEXT("Period"), 0.1f), InSampleRate), FMath::RoundToInt(GetParam(Params, TEXT("Stage"), 1.0f)));
+                }
+            }
+            else if (Type.Equals(TEXT("Impulse"), ESearchCase::IgnoreCase))
+            {
+                if (CheckParams(Type, Params, { TEXT("Period"), TEXT("BiPolar") }, OutError))
+                {
+                    Processor = MakeUnique<FImpulseProcessor>(
+                        FRenderClock::GetPeriodFrames(GetParam(Params, TEXT("Period"), 0.1f), InSampleRate), GetParam(Params, TEXT("BiPolar"), 0.0f) != 0.0f);
+                }
+            }
+            else if (Type.Equals(TEXT("Dust"), ESearchCase::IgnoreCase))
+            {
+                if (CheckParams(Type, Params, { TEXT("Density"), TEXT("BiPolar"), TEXT("Seed") }, OutError))
+                {
+                    Processor = MakeUnique<FDustProcessor>(InNumChannels, GetParam(Params, TEXT("Density"), 10.0f),
+                        GetParam(Params, TEXT("BiPolar"), 0.0f) != 0.0f, static_cast<uint32>(GetParam(Params, TEXT("Seed"), 0.0f)));
+                }
+            }
+            else if (Type.Equals(TEXT("Edge"), ESearchCase::IgnoreCase))
+            {
+                if (CheckParams(Type, Params, { TEXT("Debounce") }, OutError))
+                {
+                    Processor = MakeUnique<FEdgeProcessor>(InNumChannels, FEdgeKernel::GetDebounceSamples(GetParam(Params, TEXT("Debounce"), 0.01f), InSampleRate));
+                }
+            }
+            else if (Type.Equals(TEXT("ZeroCrossing"), ESearchCase::IgnoreCase))
+            {
+                if (CheckParams(Type, Params, { TEXT("Debounce") }, OutError))
+                {
+                    Processor = MakeUnique<FZeroCrossingProcessor>(InNumChannels, FZeroCrossingKernel::GetDebounceSamples(GetParam(Params, TEXT("Debounce"), 0.01f), InSampleRate));
+                }
+            }
+            else if (Type.Equals(TEXT("BoolToAudio"), ESearchCase::IgnoreCase))
+            {
+                if (CheckParams(Type, Params, { TEXT("Rise"), TEXT("Fall") }, OutError))
+                {
+                    Processor = MakeUnique<FBoolToAudioProcessor>(InNumChannels, InSampleRate, GetParam(Params, TEXT("Rise"), 0.01f), GetParam(Params, TEXT("Fall"), 0.01f));
+                }
+            }
+            else if (Type.Equals(TEXT("Envelope"), ESearchCase::IgnoreCase))
+            {
+                if (CheckParams(Type, Params, { TEXT("Attack"), TEXT("Release"), TEXT("Mode"), TEXT("Window"), TEXT("Decimation") }, OutError))
+                {
+                    Processor = MakeUnique<FEnvelopeProcessor>(InNumChannels, InSampleRate, GetParam(Params, TEXT("Attack"), 0.01f), GetParam(Params, TEXT("Release"), 0.1f),
+                        FMath::RoundToInt(GetParam(Params, TEXT("Mode"), 0.0f)), GetParam(Params, TEXT("Window"), 0.05f),
+                        FMath::RoundToInt(GetParam(Params, TEXT("Decimation"), 1.0f)));
+                }
+            }
+            else if (Type.Equals(TEXT("EDO"), ESearchCase::IgnoreCase))
+            {
+                if (CheckParams(Type, Params, { TEXT("Base"), TEXT("Range"), TEXT("Divisions"), TEXT("Reference"), TEXT("ReferenceNote") }, OutError))
+                {
+                    const float Base = GetParam(Params, TEXT("Base"), 60.0f);
+                    const float Range = GetParam(Params, TEXT("Range"), 12.0f);
+                    const int32 Divisions = FMath::RoundToInt(GetParam(Params, TEXT("Divisions"), 12.0f));
+                    const float Reference = GetParam(Params, TEXT("Reference"), 440.0f);
+                    const int32 ReferenceNote = FMath::RoundToInt(GetParam(Params, TEXT("ReferenceNote"), 69.0f));
+
+                    Processor = MakeSampleProcessor(TEXT("EDO"), [Base, Range, Divisions, Reference, ReferenceNote](float InValue)
+                    {
+                        return FEqualDivisionTuning::GetFrequency(FMath::RoundToInt(Base + Range * InValue), Reference, ReferenceNote, Divisions);
+                    });
+                }
+            }
+            else if (Type.Equals(TEXT("Tuning"), ESearchCase::IgnoreCase) || Type.Equals(TEXT("Quantize"), ESearchCase::IgnoreCase))
+            {
+                const bool bQuantize = Type.Equals(TEXT("Quantize"), ESearchCase::IgnoreCase);
+
+                if (CheckParams(Type, Params, { TEXT("Base"), TEXT("Range"), TEXT("Scale"), TEXT("Hysteresis"), TEXT("Frequency"),
+                    TEXT("Cents0"), TEXT("Cents1"), TEXT("Cents2"), TEXT("Cents3"), TEXT("Cents4"), TEXT("Cents5"),
+                    TEXT("Cents6"), TEXT("Cents7"), TEXT("Cents8"), TEXT("Cents9"), TEXT("Cents10"), TEXT("Cents11") }, OutError))
+                {
+                    const float Base = GetParam(Params, TEXT("Base"), 60.0f);
+                    const float Range = GetParam(Params, TEXT("Range"), 12.0f);
+
+                    float Cents[FTuningTable::NumPitchClasses];
+                    for (int32 PitchClass = 0; PitchClass < FTuningTable::NumPitchClasses; ++PitchClass)
+                    {
+                        Cents[PitchClass] = GetParam(Params, *FString::Printf(TEXT("Cents%d"), PitchClass), 0.0f);
+                    }
+
+                    if (bQuantize)
+                    {
+                        Processor = MakeUnique<FQuantizeProcessor>(InNumChannels, Cents, FMath::RoundToInt(GetParam(Params, TEXT("Scale"), 0.0f)),
+                            GetParam(Params, TEXT("Hysteresis"), 0.1f), Base, Range, GetParam(Params, TEXT("Frequency"), 0.0f) != 0.0f);
+                    }
+                    else if (Params.Contains(TEXT("Scale")) || Params.Contains(TEXT("Hysteresis")) || Params.Contains(TEXT("Frequency")))
+                    {
+                        OutError = TEXT("Scale, Hysteresis and Frequency only apply to Quantize");
+                    }
+                    else
+                    {
+                        FTuningTable Table;
+                        Table.SetCents(Cents);
+
+                        Processor = MakeSampleProcessor(TEXT("Tuning"), [Table, Base, Range](float InValue)
+                        {
+                            return Table.GetFrequency(FMath::RoundToInt(Base + Range * InValue));
+                        });
+                    }
+                }
+            }
+            else
+            {
+                OutError = FString::Printf(TEXT("Unknown stage '%s'"), *Type);
+            }
+
+            if (!Processor.IsValid())
+            {
+                return false;
+            }
+
+            Processors.Add(MoveTemp(Processor));
+        }
+
+        ProcessorCycles.SetNumZeroed(Processors.Num());
+        ProcessorCounters.SetNumZeroed(Processors.Num());
+        return true;
+    }
+
+    void FRenderChain::Reset()
+    {
+        for (TUniquePtr<IRenderProcessor>& Processor : Processors)
+        {
+            Processor->Reset();
+        }
+
+        for (uint64& Cycles : ProcessorCycles)
+        {
+            Cycles = 0;
+        }
+
+        for (FPerfCounterValues& Counters : ProcessorCounters)
+        {
+            Counters = FPerfCounterValues();
+        }
+    }
+
+    void FRenderChain::Process(TArrayView<float* const> InOutChannels, int32 NumFrames)
+    {
+        if (PerfCounters != nullptr)
+        {
+            // The reads are system calls, so they sit outside the timed section; their user-space side is
+            // a few instructions per stage and block
+            for (int32 i = 0; i < Processors.Num(); ++i)
+            {
+                PerfCounters->Mark();
+
+                const uint64 StartCycles = FPlatformTime::Cycles64();
+                Processors[i]->Process(InOutChannels, NumFrames);
+                ProcessorCycles[i] += FPlatformTime::Cycles64() - StartCycles;
+
+                PerfCounters->Accumulate(ProcessorCounters[i]);
+            }
+            return;
+        }
+
+        for (int32 i = 0; i < Processors.Num(); ++i)
+        {
+            const uint64 StartCycles = FPlatformTime::Cycles64();
+            Processors[i]->Process(InOutChannels, NumFrames);
+            ProcessorCycles[i] += FPlatformTime::Cycles64() - StartCycles;
+        }
+    }
+
+    FString FRenderChain::GetUsage()
+    {
+        return TEXT(
+            "Stages, joined with '+':\n"
+            "  Slew:Rise=<seconds>:Fall=<seconds>:Linear=<0|1>\n"
+            "  Disperser:Stages=<1-128>:Spread=<0..1>\n"
+            "  DisperserFFT:Stages=<1-128>      (Disperser as a partitioned convolution, Spread 0)\n"
+            "  Gain:Gain=<linear>               (stereo)\n"
+            "  Balance:Balance=<-1..1>          (stereo)\n"
+            "  Width:Width=<0..2>               (stereo)\n"
+            "  Invert:L=<0|1>:R=<0|1>:Swap=<0|1> (stereo)\n"
+            "  Strip:L=<0|1>:R=<0|1>:Swap=<0|1>:Width=<0..2>:Balance=<-1..1>:Gain=<linear> (stereo)\n"
+            "Trigger stages run on an internal clock of Period seconds in place of a trigger input:\n"
+            "  ClockDivider:Period=<seconds>:Reset=<seconds, 0 for none>:Output=<1-8>  (impulses on that output)\n"
+            "  ShiftRegister:Period=<seconds>:Stage=<1-8>  (shifts the channel in on each tick, holds that stage)\n"
+            "  Impulse:Period=<seconds>:BiPolar=<0|1>\n"
+            "Detector stages replace the channel with impulses, or with +1/-1 for Edge's rises and falls:\n"
+            "  Dust:Density=<offset>:BiPolar=<0|1>:Seed=<n>  (the channel modulates the density)\n"
+            "  Edge:Debounce=<seconds>\n"
+            "  ZeroCrossing:Debounce=<seconds>\n"
+            "  BoolToAudio:Rise=<seconds>:Fall=<seconds>  (true while the channel is above zero)\n"
+            "  Envelope:Attack=<seconds>:Release=<seconds>:Mode=<0 peak|1 RMS|2 windowed RMS>:Window=<seconds>:Decimation=<samples>\n"
+            "Pitch stages read the channel as the note Base + Range * sample and write a frequency:\n"
+            "  EDO:Base=<note>:Range=<notes>:Divisions=<n>:Reference=<hz>:ReferenceNote=<note>\n"
+            "  Tuning:Base=<note>:Range=<notes>:Cents0..Cents11=<cents>\n"
+            "  Quantize:Base=<note>:Range=<notes>:Cents0..Cents11=<cents>:Scale=<pitch class bits>:Hysteresis=<semitones>:Frequency=<0 note|1 hz>");
+    }
+}
@@ -0,0 +1,53 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MetasoundBranchesHarness/Private/BranchesPerfCounters.h"
+
+namespace MetasoundBranches::Harness
+{
+    // One stage of an offline render chain, wrapping a Branches DSP kernel
+    class IRenderProcessor
+    {
+    public:
+        virtual ~IRenderProcessor() = default;
+
+        virtual const TCHAR* GetName() const = 0;
+        virtual void Reset() = 0;
+
+        // Processes one block in place, one buffer per channel
+        virtual void Process(TArrayView<float* const> InOutChannels, int32 NumFrames) = 0;
+    };
+
+    // A list of processors built from a spec such as "Slew:Rise=0.01:Fall=0.2+Disperser:Stages=16+Width:Width=1.5".
+    // Stages are separated by '+', parameters by ':'. Unknown stages or parameters are reported as errors.
+    class FRenderChain
+    {
+    public:
+        bool Init(const FString& InSpec, int32 InNumChannels, float InSampleRate, FString& OutError);
+
+        void Reset();
+        void Process(TArrayView<float* const> InOutChannels, int32 NumFrames);
+
+        int32 Num() const { return Processors.Num(); }
+        const TCHAR* GetProcessorName(int32 Index) const { return Processors[Index]->GetName(); }
+
+        // Accumulated processing time of one stage since the last Reset, in seconds
+        double GetProcessorSeconds(int32 Index) const { return FPlatformTime::ToSeconds64(ProcessorCycles[Index]); }
+
+        // Reads hardware counters around each stage from now on. Pass nullptr to stop; the counters must outlive the chain.
+        void SetPerfCounters(FPerfCounters* InCounters) { PerfCounters = InCounters; }
+
+        // Accumulated hardware counts of one stage since the last Reset, if counters are set
+        const FPerfCounterValues& GetProcessorCounters(int32 Index) const { return ProcessorCounters[Index]; }
+
+        static FString GetUsage();
+
+    private:
+        TArray<TUniquePtr<IRenderProcessor>> Processors;
+        TArray<uint64> ProcessorCycles;
+        TArray<FPerfCounterValues> ProcessorCounters;
+        FPerfCounters* PerfCounters = nullptr;
+    };
+}
@@ -0,0 +1,315 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranchesHarness/Private/BranchesSpawnBench.h"
+#include "MetasoundBranches/Public/MetasoundBranchesNodeList.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/FileHelper.h"
+#include "MetasoundBuilderInterface.h"
+#include "MetasoundEnvironment.h"
+#include "MetasoundNodeInterface.h"
+#include "MetasoundOperatorInterface.h"
+#include "MetasoundOperatorSettings.h"
+#include "MetasoundVertexData.h"
+
+#include <atomic>
+
+namespace MetasoundBranches::Harness
+{
+    namespace SpawnBenchPrivate
+    {
+        // Forwards everything to the allocator it replaces, counting allocations made on one thread while enabled.
+        // Installed as GMalloc only for the duration of the bench; blocks allocated through it are freed by the
+        // same underlying allocator either way.
+        class FCountingMalloc final : public FMalloc
+        {
+        public:
+            void Install()
+            {
+                Inner = GMalloc;
+                GMalloc = this;
+            }
+
+            void Uninstall()
+            {
+                GMalloc = Inner;
+            }
+
+            void BeginCounting()
+            {
+                CountingThreadId = FPlatformTLS::GetCurrentThreadId();
+                NumAllocations = 0;
+                AllocatedBytes = 0;
+                bCounting.store(true, std::memory_order_release);
+            }
+
+            void EndCounting()
+            {
+                bCounting.store(false, std::memory_order_release);
+            }
+
+            int32 GetNumAllocations() const { return NumAllocations; }
+            int64 GetAllocatedBytes() const { return AllocatedBytes; }
+
+            virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+            {
+                CountAllocation(Count);
+                return Inner->Malloc(Count, Alignment);
+            }
+
+            virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+            {
+                CountAllocation(Count);
+                return Inner->TryMalloc(Count, Alignment);
+            }
+
+            virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+            {
+                // Shrinking to nothing is a free; anything else may move the block
+                if (Count > 0)
+                {
+                    CountAllocation(Count);
+                }
+                return Inner->Realloc(Original, Count, Alignment);
+            }
+
+            virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+            {
+                if (Count > 0)
+                {
+                    CountAllocation(Count);
+                }
+                return Inner->TryRealloc(Original, Count, Alignment);
+            }
+
+            virtual void Free(void* Original) override
+            {
+                Inner->Free(Original);
+            }
+
+            virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+            {
+                return Inner->QuantizeSize(Count, Alignment);
+            }
+
+            virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+            {
+                return Inner->GetAllocationSize(Original, SizeOut);
+            }
+
+            virtual void Trim(bool bTrimThreadCaches) override
+            {
+                Inner->Trim(bTrimThreadCaches);
+            }
+
+            virtual void SetupTLSCachesOnCurrentThread() override
+            {
+                Inner->SetupTLSCachesOnCurrentThread();
+            }
+
+            virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+            {
+                Inner->ClearAndDisableTLSCachesOnCurrentThread();
+            }
+
+            virtual bool IsInternallyThreadSafe() const override
+            {
+                return Inner->IsInternallyThreadSafe();
+            }
+
+            virtual const TCHAR* GetDescriptiveName() override
+            {
+                return Inner->GetDescriptiveName();
+            }
+
+        private:
+            void CountAllocation(SIZE_T InCount)
+            {
+                if (bCounting.load(std::memory_order_acquire) && FPlatformTLS::GetCurrentThreadId() == CountingThreadId)
+                {
+                    ++NumAllocations;
+                    AllocatedBytes += static_cast<int64>(InCount);
+                }
+            }
+
+            FMalloc* Inner = nullptr;
+
+            std::atomic<bool> bCounting{ false };
+            uint32 CountingThreadId = 0;
+
+            // Only touched by the counting thread
+            int32 NumAllocations = 0;
+            int64 AllocatedBytes = 0;
+        };
+
+        // Static so that a late call through a stale GMalloc pointer still lands somewhere valid
+        FCountingMalloc& GetCountingMalloc()
+        {
+            static FCountingMalloc CountingMalloc;
+            return CountingMalloc;
+        }
+
+        FSpawnBenchResult BenchNode(const FNodeListEntry& InEntry, const FSpawnBenchSettings& InSettings, FCountingMalloc& InMalloc)
+        {
+            using namespace Metasound;
+
+            const FNodeInitData InitData{ FVertexName(InEntry.GetClassName()), FGuid::NewGuid() };
+            TUniquePtr<INode> Node = InEntry.CreateNode(InitData);
+
+            FSpawnBenchResult Result;
+            Result.NodeName = Node->GetMetadata().DisplayName.ToString();
+
+            const FOperatorSettings OperatorSettings(InSettings.SampleRate, InSettings.SampleRate / InSettings.BlockSize);
+            const FMetasoundEnvironment Environment;
+            const FVertexInterface& Interface = Node->GetVertexInterface();
+            FOperatorFactorySharedRef Factory = Node->GetDefaultOperatorFactory();
+
+            uint64 CreateCycles = 0;
+            uint64 DestroyCycles = 0;
+            int64 TotalAllocations = 0;
+            int64 TotalBytes = 0;
+
+            // One build up front so first-use statics (node metadata, vertex interfaces) aren't counted
+            for (int32 Iteration = -1; Iteration < InSettings.NumIterations; ++Iteration)
+            {
+                // The vertex data belongs to the graph, not the node, so it is set up outside the measured scope
+                FInputVertexInterfaceData InputData(Interface.GetInputInterface());
+                FOutputVertexInterfaceData OutputData(Interface.GetOutputInterface());
+                FBuildResults BuildResults;
+                const FBuildOperatorParams BuildParams{ *Node, OperatorSettings, InputData, Environment };
+
+                InMalloc.BeginCounting();
+                const uint64 CreateStart = FPlatformTime::Cycles64();
+
+                TUniquePtr<IOperator> Operator = Factory->CreateOperator(BuildParams, BuildResults);
+                if (Operator.IsValid())
+                {
+                    Operator->BindInputs(InputData);
+                    Operator->BindOutputs(OutputData);
+                }
+
+                const uint64 CreateEnd = FPlatformTime::Cycles64();
+                InMalloc.EndCounting();
+
+                // Release the graph's references first, so destroying the operator frees what it owns
+                InputData = FInputVertexInterfaceData();
+                OutputData = FOutputVertexInterfaceData();
+
+                const uint64 DestroyStart = FPlatformTime::Cycles64();
+                Operator.Reset();
+                const uint64 DestroyEnd = FPlatformTime::Cycles64();
+
+                if (Iteration < 0)
+                {
+                    continue;
+                }
+
+                CreateCycles += CreateEnd - CreateStart;
+                DestroyCycles += DestroyEnd - DestroyStart;
+                TotalAllocations += InMalloc.GetNumAllocations();
+                TotalBytes += InMalloc.GetAllocatedBytes();
+                Result.MaxAllocations = FMath::Max(Result.MaxAllocations, InMalloc.GetNumAllocations());
+            }
+
+            const int32 NumIterations = FMath::Max(InSettings.NumIterations, 1);
+            Result.CreateMicroseconds = FPlatformTime::ToMilliseconds64(CreateCycles) * 1000.0 / NumIterations;
+            Result.DestroyMicroseconds = FPlatformTime::ToMilliseconds64(DestroyCycles) * 1000.0 / NumIterations;
+            Result.NumAllocations = static_cast<int32>(TotalAllocations / NumIterations);
+            Result.AllocatedBytes = TotalBytes / NumIterations;
+
+            return Result;
+        }
+    }
+
+    TArray<FSpawnBenchResult> RunSpawnBench(const FSpawnBenchSettings& InSettings)
+    {
+        using namespace SpawnBenchPrivate;
+
+        TArray<const FNodeListEntry*> Entries;
+        for (const FNodeListEntry* Entry = FNodeListEntry::GetHead(); Entry != nullptr; Entry = Entry->GetNext())
+        {
+            if (InSettings.NodeFilter.IsEmpty() || FString(Entry->GetClassName()).Contains(InSettings.NodeFilter))
+            {
+                Entries.Add(Entry);
+            }
+        }
+
+        // The list is in reverse load order; sort so reports line up between runs
+        Entries.Sort([](const FNodeListEntry& A, const FNodeListEntry& B)
+        {
+            return FCString::Stricmp(A.GetClassName(), B.GetClassName()) < 0;
+        });
+
+        FCountingMalloc& CountingMalloc = GetCountingMalloc();
+        CountingMalloc.Install();
+
+        TArray<FSpawnBenchResult> Results;
+        for (const FNodeListEntry* Entry : Entries)
+        {
+            Results.Add(BenchNode(*Entry, InSettings, CountingMalloc));
+        }
+
+        CountingMalloc.Uninstall();
+
+        return Results;
+    }
+
+    FString SpawnBenchResultsToCsv(const TArray<FSpawnBenchResult>& InResults)
+    {
+        FString Csv = TEXT("Node,CreateUs,DestroyUs,Allocations,MaxAllocations,AllocatedBytes\n");
+
+        for (const FSpawnBenchResult& Result : InResults)
+        {
+            Csv += FString::Printf(TEXT("%s,%.3f,%.3f,%d,%d,%lld\n"),
+                *Result.NodeName,
+                Result.CreateMicroseconds,
+                Result.DestroyMicroseconds,
+                Result.NumAllocations,
+                Result.MaxAllocations,
+                Result.AllocatedBytes);
+        }
+
+        return Csv;
+    }
+
+    bool LoadSpawnBenchCsv(const FString& InFilename, TArray<FSpawnBenchResult>& OutResults, FString& OutError)
+    {
+        TArray<FString> Lines;
+        if (!FFileHelper::LoadFileToStringArray(Lines, *InFilename))
+        {
+            OutError = TEXT("Could not read baseline file");
+            return false;
+        }
+
+        // Skip the header
+        for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+        {
+            const FString Line = Lines[LineIndex].TrimStartAndEnd();
+            if (Line.IsEmpty())
+            {
+                continue;
+            }
+
+            TArray<FString> Fields;
+            Line.ParseIntoArray(Fields, TEXT(","), false);
+
+            if (Fields.Num() != 6)
+            {
+                OutError = FString::Printf(TEXT("Line %d has %d fields, expected 6"), LineIndex + 1, Fields.Num());
+                return false;
+            }
+
+            FSpawnBenchResult Result;
+            Result.NodeName = Fields[0];
+            Result.CreateMicroseconds = FCString::Atod(*Fields[1]);
+            Result.DestroyMicroseconds = FCString::Atod(*Fields[2]);
+            Result.NumAllocations = FCString::Atoi(*Fields[3]);
+            Result.MaxAllocations = FCString::Atoi(*Fields[4]);
+            Result.AllocatedBytes = FCString::Atoi64(*Fields[5]);
+
+            OutResults.Add(MoveTemp(Result));
+        }
+
+        return true;
+    }
+}
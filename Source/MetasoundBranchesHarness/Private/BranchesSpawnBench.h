@@ -0,0 +1,44 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace MetasoundBranches::Harness
+{
+    struct FSpawnBenchSettings
+    {
+        // Case-insensitive substring of the node class name; empty runs every node
+        FString NodeFilter;
+
+        int32 NumIterations = 1000;
+        float SampleRate = 48000.0f;
+        int32 BlockSize = 256;
+    };
+
+    struct FSpawnBenchResult
+    {
+        FString NodeName;
+
+        // Mean time to build one operator (CreateOperator and binding its vertices), and to destroy it
+        double CreateMicroseconds = 0.0;
+        double DestroyMicroseconds = 0.0;
+
+        // Heap allocations and requested bytes per build, counted on the bench thread only
+        int32 NumAllocations = 0;
+        int64 AllocatedBytes = 0;
+
+        // Largest allocation count seen, in case a build allocates more than once per instance on some iterations
+        int32 MaxAllocations = 0;
+    };
+
+    // Builds and destroys the operator of every listed node (see MetasoundBranchesNodeList.h) with unconnected
+    // inputs, as a graph does when a sound spawns, timing each build and counting its heap allocations.
+    TArray<FSpawnBenchResult> RunSpawnBench(const FSpawnBenchSettings& InSettings);
+
+    // Results as CSV, one line per node, for tracking across releases
+    FString SpawnBenchResultsToCsv(const TArray<FSpawnBenchResult>& InResults);
+
+    // Reads results written by SpawnBenchResultsToCsv. Returns false if the file can't be read or parsed.
+    bool LoadSpawnBenchCsv(const FString& InFilename, TArray<FSpawnBenchResult>& OutResults, FString& OutError);
+}
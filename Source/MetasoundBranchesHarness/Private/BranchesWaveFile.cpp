@@ -0,0 +1,318 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranchesHarness/Private/BranchesWaveFile.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+
+namespace MetasoundBranches::Harness
+{
+    namespace WaveFilePrivate
+    {
+        constexpr uint16 FormatPCM = 1;
+        constexpr uint16 FormatFloat = 3;
+        constexpr uint16 FormatExtensible = 0xFFFE;
+
+        // RF64 keeps 64-bit sizes in a ds64 chunk and marks the 32-bit fields with this value
+        constexpr uint32 SizeInDs64 = 0xFFFFFFFF;
+
+        // RIFF, WAVE, a ds64-sized chunk, fmt and the data chunk header
+        constexpr int32 Ds64Size = 28;
+        constexpr int32 WriterHeaderSize = 12 + (8 + Ds64Size) + (8 + 16) + 8;
+
+        // WAV files are little-endian, as are all supported platforms
+        template <typename T>
+        T ReadValue(const uint8* InData)
+        {
+            T Value;
+            FMemory::Memcpy(&Value, InData, sizeof(T));
+            return Value;
+        }
+
+        bool ChunkIdEquals(const uint8* InData, const char* InId)
+        {
+            return FMemory::Memcmp(InData, InId, 4) == 0;
+        }
+    }
+
+    bool FWaveFileReader::Open(const FString& InFilename, FString& OutError)
+    {
+        IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+        MappedFile.Reset(PlatformFile.OpenMapped(*InFilename));
+        if (MappedFile.IsValid())
+        {
+            MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+        }
+
+        const uint8* FileData = nullptr;
+        int64 FileSize = 0;
+
+        if (MappedRegion.IsValid())
+        {
+            FileData = MappedRegion->GetMappedPtr();
+            FileSize = MappedRegion->GetMappedSize();
+        }
+        else
+        {
+            // Memory mapping is not available everywhere, so fall back to loading the file
+            MappedFile.Reset();
+            if (!FFileHelper::LoadFileToArray(FallbackData, *InFilename))
+            {
+                OutError = FString::Printf(TEXT("Could not open %s"), *InFilename);
+                return false;
+            }
+
+            FileData = FallbackData.GetData();
+            FileSize = FallbackData.Num();
+        }
+
+        ReadFrame = 0;
+        return ParseHeader(FileData, FileSize, OutError);
+    }
+
+    bool FWaveFileReader::ParseHeader(const uint8* InData, int64 InSize, FString& OutError)
+    {
+        using namespace WaveFilePrivate;
+
+        const bool bIsRF64 = InSize >= 12 && ChunkIdEquals(InData, "RF64");
+        if (InSize < 12 || (!bIsRF64 && !ChunkIdEquals(InData, "RIFF")) || !ChunkIdEquals(InData + 8, "WAVE"))
+        {
+            OutError = TEXT("Not a RIFF/WAVE file");
+            return false;
+        }
+
+        uint16 FormatTag = 0;
+        int32 BitsPerSample = 0;
+        const uint8* DataChunk = nullptr;
+        int64 DataChunkSize = 0;
+        int64 Ds64DataSize = -1;
+
+        int64 Offset = 12;
+        while (Offset + 8 <= InSize)
+        {
+            const uint8* Chunk = InData + Offset;
+            int64 ChunkSize = ReadValue<uint32>(Chunk + 4);
+
+            // The ds64 chunk comes first in an RF64 file and holds the real size of the data chunk
+            if (bIsRF64 && ChunkIdEquals(Chunk, "data") && ChunkSize == SizeInDs64 && Ds64DataSize >= 0)
+            {
+                ChunkSize = Ds64DataSize;
+            }
+
+            const int64 ChunkAvailable = FMath::Min(ChunkSize, InSize - (Offset + 8));
+
+            if (bIsRF64 && ChunkIdEquals(Chunk, "ds64") && ChunkAvailable >= 16)
+            {
+                Ds64DataSize = static_cast<int64>(ReadValue<uint64>(Chunk + 16));
+            }
+            else if (ChunkIdEquals(Chunk, "fmt ") && ChunkAvailable >= 16)
+            {
+                FormatTag = ReadValue<uint16>(Chunk + 8);
+                NumChannels = ReadValue<uint16>(Chunk + 10);
+                SampleRate = ReadValue<uint32>(Chunk + 12);
+                BitsPerSample = ReadValue<uint16>(Chunk + 22);
+
+                // The real format of an extensible file is the first two bytes of its sub-format GUID
+                if (FormatTag == FormatExtensible && ChunkAvailable >= 26)
+                {
+                    FormatTag = ReadValue<uint16>(Chunk + 32);
+                }
+            }
+            else if (ChunkIdEquals(Chunk, "data"))
+            {
+                DataChunk = Chunk + 8;
+                DataChunkSize = ChunkAvailable;
+            }
+
+            // Chunks are padded to an even number of bytes
+            Offset += 8 + ChunkSize + (ChunkSize & 1);
+        }
+
+        if (DataChunk == nullptr || NumChannels <= 0 || SampleRate <= 0)
+        {
+            OutError = TEXT("Missing fmt or data chunk");
+            return false;
+        }
+
+        bIsFloat = (FormatTag == FormatFloat);
+        BytesPerSample = BitsPerSample / 8;
+
+        const bool bSupportedPCM = (FormatTag == FormatPCM) && (BitsPerSample == 16 || BitsPerSample == 24 || BitsPerSample == 32);
+        const bool bSupportedFloat = bIsFloat && (BitsPerSample == 32);
+
+        if (!bSupportedPCM && !bSupportedFloat)
+        {
+            OutError = FString::Printf(TEXT("Unsupported sample format (tag %d, %d bits)"), FormatTag, BitsPerSample);
+            return false;
+        }
+
+        SampleData = DataChunk;
+        NumFrames = DataChunkSize / (BytesPerSample * NumChannels);
+        return true;
+    }
+
+    int32 FWaveFileReader::ReadFrames(TArrayView<float* const> OutChannels, int32 InNumFrames)
+    {
+        using namespace WaveFilePrivate;
+
+        check(OutChannels.Num() == NumChannels);
+
+        const int32 FramesToRead = static_cast<int32>(FMath::Min<int64>(InNumFrames, NumFrames - ReadFrame));
+        const int32 FrameStride = BytesPerSample * NumChannels;
+        const uint8* FrameData = SampleData + ReadFrame * FrameStride;
+
+        for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+        {
+            float* OutData = OutChannels[Channel];
+            const uint8* InData = FrameData + Channel * BytesPerSample;
+
+            if (bIsFloat)
+            {
+                for (int32 i = 0; i < FramesToRead; ++i, InData += FrameStride)
+                {
+                    OutData[i] = ReadValue<float>(InData);
+                }
+            }
+            else if (BytesPerSample == 2)
+            {
+                for (int32 i = 0; i < FramesToRead; ++i, InData += FrameStride)
+                {
+                    OutData[i] = ReadValue<int16>(InData) / 32768.0f;
+                }
+            }
+            else if (BytesPerSample == 3)
+            {
+                for (int32 i = 0; i < FramesToRead; ++i, InData += FrameStride)
+                {
+                    // Place the 24 bits at the top of an int32 to keep the sign
+                    const int32 Sample = (InData[0] << 8) | (InData[1] << 16) | (InData[2] << 24);
+                    OutData[i] = Sample / 2147483648.0f;
+                }
+            }
+            else
+            {
+                for (int32 i = 0; i < FramesToRead; ++i, InData += FrameStride)
+                {
+                    OutData[i] = ReadValue<int32>(InData) / 2147483648.0f;
+                }
+            }
+        }
+
+        ReadFrame += FramesToRead;
+        return FramesToRead;
+    }
+
+    FWaveFileWriter::~FWaveFileWriter()
+    {
+        Close();
+    }
+
+    bool FWaveFileWriter::Open(const FString& InFilename, int32 InNumChannels, int32 InSampleRate, FString& OutError)
+    {
+        FileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*InFilename));
+        if (!FileHandle.IsValid())
+        {
+            OutError = FString::Printf(TEXT("Could not open %s for writing"), *InFilename);
+            return false;
+        }
+
+        NumChannels = InNumChannels;
+        SampleRate = InSampleRate;
+        NumDataBytes = 0;
+
+        // Sizes are patched in Close once they are known
+        if (!WriteHeader())
+        {
+            FileHandle.Reset();
+            OutError = FString::Printf(TEXT("Could not write the header of %s"), *InFilename);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool FWaveFileWriter::WriteFrames(TArrayView<const float* const> InChannels, int32 InNumFrames)
+    {
+        check(InChannels.Num() == NumChannels);
+
+        InterleavedBuffer.SetNumUninitialized(InNumFrames * NumChannels, EAllowShrinking::No);
+        float* OutData = InterleavedBuffer.GetData();
+
+        for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+        {
+            const float* InData = InChannels[Channel];
+            for (int32 i = 0; i < InNumFrames; ++i)
+            {
+                OutData[i * NumChannels + Channel] = InData[i];
+            }
+        }
+
+        const int64 NumBytes = InterleavedBuffer.Num() * sizeof(float);
+        NumDataBytes += NumBytes;
+
+        return FileHandle->Write(reinterpret_cast<const uint8*>(OutData), NumBytes);
+    }
+
+    bool FWaveFileWriter::Close()
+    {
+        if (!FileHandle.IsValid())
+        {
+            return false;
+        }
+
+        const bool bSeeked = FileHandle->Seek(0);
+        const bool bWroteHeader = bSeeked && WriteHeader();
+        FileHandle.Reset();
+        return bWroteHeader;
+    }
+
+    bool FWaveFileWriter::WriteHeader()
+    {
+        using namespace WaveFilePrivate;
+
+        // Past 4 GB the 32-bit sizes can't hold the file, so it becomes RF64 and the space reserved for the ds64
+        // chunk is filled in. Smaller files stay plain RIFF and the space is left as a JUNK chunk.
+        const int64 RiffSize64 = (WriterHeaderSize - 8) + NumDataBytes;
+        const bool bIsRF64 = RiffSize64 > MAX_uint32;
+
+        const uint32 RiffSize = bIsRF64 ? SizeInDs64 : static_cast<uint32>(RiffSize64);
+        const uint32 DataSize = bIsRF64 ? SizeInDs64 : static_cast<uint32>(NumDataBytes);
+        const uint32 ReservedSize = Ds64Size;
+        const uint16 FormatTag = FormatFloat;
+        const uint16 Channels = static_cast<uint16>(NumChannels);
+        const uint32 Rate = static_cast<uint32>(SampleRate);
+        const uint16 BlockAlign = static_cast<uint16>(NumChannels * sizeof(float));
+        const uint32 ByteRate = Rate * BlockAlign;
+        const uint16 BitsPerSample = 32;
+        const uint32 FormatSize = 16;
+
+        uint8 Header[WriterHeaderSize] = {};
+        FMemory::Memcpy(Header + 0, bIsRF64 ? "RF64" : "RIFF", 4);
+        FMemory::Memcpy(Header + 4, &RiffSize, 4);
+        FMemory::Memcpy(Header + 8, "WAVE", 4);
+        FMemory::Memcpy(Header + 12, bIsRF64 ? "ds64" : "JUNK", 4);
+        FMemory::Memcpy(Header + 16, &ReservedSize, 4);
+
+        if (bIsRF64)
+        {
+            // RIFF size, data size and sample count, followed by an empty table of other chunk sizes
+            const uint64 SampleCount = NumDataBytes / BlockAlign;
+            FMemory::Memcpy(Header + 20, &RiffSize64, 8);
+            FMemory::Memcpy(Header + 28, &NumDataBytes, 8);
+            FMemory::Memcpy(Header + 36, &SampleCount, 8);
+        }
+
+        FMemory::Memcpy(Header + 48, "fmt ", 4);
+        FMemory::Memcpy(Header + 52, &FormatSize, 4);
+        FMemory::Memcpy(Header + 56, &FormatTag, 2);
+        FMemory::Memcpy(Header + 58, &Channels, 2);
+        FMemory::Memcpy(Header + 60, &Rate, 4);
+        FMemory::Memcpy(Header + 64, &ByteRate, 4);
+        FMemory::Memcpy(Header + 68, &BlockAlign, 2);
+        FMemory::Memcpy(Header + 70, &BitsPerSample, 2);
+        FMemory::Memcpy(Header + 72, "data", 4);
+        FMemory::Memcpy(Header + 76, &DataSize, 4);
+
+        return FileHandle->Write(Header, sizeof(Header));
+    }
+}
@@ -0,0 +1,70 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+
+namespace MetasoundBranches::Harness
+{
+    // Streams frames from a PCM (16/24/32-bit) or 32-bit float WAV or RF64 file.
+    // The file is memory-mapped where the platform supports it, so only the pages being read are resident.
+    class FWaveFileReader
+    {
+    public:
+        bool Open(const FString& InFilename, FString& OutError);
+
+        int32 GetNumChannels() const { return NumChannels; }
+        int32 GetSampleRate() const { return SampleRate; }
+        int64 GetNumFrames() const { return NumFrames; }
+        bool IsMapped() const { return MappedRegion.IsValid(); }
+
+        // Rewinds to the first frame
+        void Rewind() { ReadFrame = 0; }
+
+        // Deinterleaves up to InNumFrames frames into one buffer per channel. Returns the number of frames read.
+        int32 ReadFrames(TArrayView<float* const> OutChannels, int32 InNumFrames);
+
+    private:
+        bool ParseHeader(const uint8* InData, int64 InSize, FString& OutError);
+
+        TUniquePtr<IMappedFileHandle> MappedFile;
+        TUniquePtr<IMappedFileRegion> MappedRegion;
+        TArray<uint8> FallbackData;
+
+        const uint8* SampleData = nullptr;
+        int64 NumFrames = 0;
+        int64 ReadFrame = 0;
+
+        int32 NumChannels = 0;
+        int32 SampleRate = 0;
+        int32 BytesPerSample = 0;
+        bool bIsFloat = false;
+    };
+
+    // Writes 32-bit float WAV files block by block, patching the header sizes on Close.
+    // Files whose sizes don't fit the 32-bit RIFF fields are written as RF64.
+    class FWaveFileWriter
+    {
+    public:
+        ~FWaveFileWriter();
+
+        bool Open(const FString& InFilename, int32 InNumChannels, int32 InSampleRate, FString& OutError);
+        bool WriteFrames(TArrayView<const float* const> InChannels, int32 InNumFrames);
+
+        // Patches the header and closes the file. Returns false if the header couldn't be written, in which case
+        // the file is incomplete.
+        bool Close();
+
+    private:
+        bool WriteHeader();
+
+        TUniquePtr<IFileHandle> FileHandle;
+        TArray<float> InterleavedBuffer;
+
+        int64 NumDataBytes = 0;
+        int32 NumChannels = 0;
+        int32 SampleRate = 0;
+    };
+}
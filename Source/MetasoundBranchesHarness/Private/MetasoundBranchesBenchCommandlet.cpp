@@ -0,0 +1,655 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranchesHarness/Private/MetasoundBranchesBenchCommandlet.h"
+#include "MetasoundBranchesHarness/Private/MetasoundBranchesHarness.h"
+#include "MetasoundBranches/Public/DSP/StereoKernels.h"
+#include "MetasoundBranches/Public/DSP/VoiceBatchKernels.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(MetasoundBranchesBenchCommandlet)
+
+namespace MetasoundBranches::Harness::BenchCommandletPrivate
+{
+    constexpr float BenchSampleRate = 48000.0f;
+
+    // Blocks of input generated up front and cycled through while timing
+    constexpr int32 NumInputBlocks = 16;
+
+    struct FBenchSettings
+    {
+        int32 NumVoices = 64;
+        int32 BlockSize = 256;
+        int32 NumBlocks = 2000;
+        float Tolerance = 1.0e-6f;
+    };
+
+    struct FBenchResult
+    {
+        double ScalarSeconds = 0.0;
+        double BatchSeconds = 0.0;
+        float MaxError = 0.0f;
+        int64 NumMismatches = 0;
+    };
+
+    // Inputs and outputs for both layouts. Scalar buffers are voice-major, one contiguous block per voice,
+    // batch buffers are frame-major with the batch stride.
+    class FVoiceBench
+    {
+    public:
+        FVoiceBench(const FBenchSettings& InSettings)
+            : NumVoices(InSettings.NumVoices)
+            , Stride(GetVoiceBatchStride(InSettings.NumVoices))
+            , BlockSize(InSettings.BlockSize)
+            , Stream(InSettings.NumVoices * 7919 + InSettings.BlockSize)
+        {
+            ScalarOutput.SetNumZeroed(NumVoices * BlockSize);
+            BatchOutput.SetNumZeroed(Stride * BlockSize);
+        }
+
+        // Largest difference between the last block written by each path
+        void CompareOutputs(float InTolerance, FBenchResult& OutResult) const
+        {
+            for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+            {
+                for (int32 Frame = 0; Frame < BlockSize; ++Frame)
+                {
+                    const float Expected = ScalarOutput[Voice * BlockSize + Frame];
+                    const float Actual = BatchOutput[Frame * Stride + Voice];
+                    const float Error = FMath::Abs(Expected - Actual);
+
+                    OutResult.MaxError = FMath::Max(OutResult.MaxError, Error);
+                    OutResult.NumMismatches += (Error <= InTolerance) ? 0 : 1;
+                }
+            }
+        }
+
+    protected:
+        // Fills both layouts with the same stepped signal: random levels held for random lengths per voice
+        void MakeSteppedInputs(float InMin, float InMax, int32 InMaxHold)
+        {
+            ScalarInput.SetNumZeroed(NumInputBlocks * NumVoices * BlockSize);
+            BatchInput.SetNumZeroed(NumInputBlocks * Stride * BlockSize);
+
+            for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+            {
+                float Level = 0.0f;
+                int32 Hold = 0;
+
+                for (int32 Block = 0; Block < NumInputBlocks; ++Block)
+                {
+                    for (int32 Frame = 0; Frame < BlockSize; ++Frame)
+                    {
+                        if (--Hold <= 0)
+                        {
+                            Level = Stream.FRandRange(InMin, InMax);
+                            Hold = Stream.RandRange(1, InMaxHold);
+                        }
+
+                        ScalarInput[(Block * NumVoices + Voice) * BlockSize + Frame] = Level;
+                        BatchInput[(Block * BlockSize + Frame) * Stride + Voice] = Level;
+                    }
+                }
+            }
+        }
+
+        const float* GetScalarInput(int32 InBlock, int32 InVoice) const
+        {
+            return ScalarInput.GetData() + ((InBlock % NumInputBlocks) * NumVoices + InVoice) * BlockSize;
+        }
+
+        const float* GetBatchInput(int32 InBlock) const
+        {
+            return BatchInput.GetData() + (InBlock % NumInputBlocks) * Stride * BlockSize;
+        }
+
+        int32 NumVoices;
+        int32 Stride;
+        int32 BlockSize;
+        FRandomStream Stream;
+
+        TArray<float> ScalarInput;
+        TArray<float> BatchInput;
+        TArray<float> ScalarOutput;
+        TArray<float> BatchOutput;
+    };
+
+    class FSlewBench : public FVoiceBench
+    {
+    public:
+        FSlewBench(const FBenchSettings& InSettings)
+            : FVoiceBench(InSettings)
+        {
+            MakeSteppedInputs(-1.0f, 1.0f, BlockSize);
+
+            Kernels.SetNum(NumVoices);
+            RiseAlphas.SetNum(NumVoices);
+            FallAlphas.SetNum(NumVoices);
+            Batch.Init(NumVoices);
+
+            for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+            {
+                RiseAlphas[Voice] = FSlewKernel::GetAlpha(Stream.FRandRange(0.001f, 0.1f), BenchSampleRate);
+                FallAlphas[Voice] = FSlewKernel::GetAlpha(Stream.FRandRange(0.001f, 0.1f), BenchSampleRate);
+                Batch.SetAlphas(Voice, RiseAlphas[Voice], FallAlphas[Voice]);
+            }
+        }
+
+        void Reset()
+        {
+            for (FSlewKernel& Kernel : Kernels)
+            {
+                Kernel.Reset();
+            }
+            Batch.Reset();
+        }
+
+        void RunScalar(int32 InBlock)
+        {
+            for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+            {
+                Kernels[Voice].ProcessBuffer(GetScalarInput(InBlock, Voice), ScalarOutput.GetData() + Voice * BlockSize, BlockSize, RiseAlphas[Voice], FallAlphas[Voice]);
+            }
+        }
+
+        void RunBatch(int32 InBlock)
+        {
+            Batch.ProcessInterleaved(GetBatchInput(InBlock), BatchOutput.GetData(), BlockSize);
+        }
+
+    private:
+        TArray<FSlewKernel> Kernels;
+        TArray<float> RiseAlphas;
+        TArray<float> FallAlphas;
+        FSlewVoiceBatch Batch;
+    };
+
+    // Bool To Audio: each voice slews towards 0 or 1, chosen per block
+    class FBoolToAudioBench : public FVoiceBench
+    {
+    public:
+        FBoolToAudioBench(const FBenchSettings& InSettings)
+            : FVoiceBench(InSettings)
+        {
+            Targets.SetNumZeroed(NumInputBlocks * Stride);
+            for (int32 Block = 0; Block < NumInputBlocks; ++Block)
+            {
+                for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+                {
+                    Targets[Block * Stride + Voice] = Stream.FRand() > 0.5f ? 1.0f : 0.0f;
+                }
+            }
+
+            Kernels.SetNum(NumVoices);
+            RiseAlphas.SetNum(NumVoices);
+            FallAlphas.SetNum(NumVoices);
+            Batch.Init(NumVoices);
+
+            for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+            {
+                RiseAlphas[Voice] = FSlewKernel::GetAlpha(Stream.FRandRange(0.001f, 0.05f), BenchSampleRate);
+                FallAlphas[Voice] = FSlewKernel::GetAlpha(Stream.FRandRange(0.001f, 0.05f), BenchSampleRate);
+                Batch.SetAlphas(Voice, RiseAlphas[Voice], FallAlphas[Voice]);
+            }
+        }
+
+        void Reset()
+        {
+            for (FSlewKernel& Kernel : Kernels)
+            {
+                Kernel.Reset();
+            }
+            Batch.Reset();
+        }
+
+        void RunScalar(int32 InBlock)
+        {
+            const float* BlockTargets = Targets.GetData() + (InBlock % NumInputBlocks) * Stride;
+
+            for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+            {
+                Kernels[Voice].ProcessConstant(BlockTargets[Voice], ScalarOutput.GetData() + Voice * BlockSize, BlockSize, RiseAlphas[Voice], FallAlphas[Voice]);
+            }
+        }
+
+        void RunBatch(int32 InBlock)
+        {
+            Batch.ProcessConstantTargets(Targets.GetData() + (InBlock % NumInputBlocks) * Stride, BatchOutput.GetData(), BlockSize);
+        }
+
+    private:
+        TArray<float> Targets;
+        TArray<FSlewKernel> Kernels;
+        TArray<float> RiseAlphas;
+        TArray<float> FallAlphas;
+        FSlewVoiceBatch Batch;
+    };
+
+    class FDustBench : public FVoiceBench
+    {
+    public:
+        static constexpr uint32 BaseSeed = 12345U;
+
+        FDustBench(const FBenchSettings& InSettings)
+            : FVoiceBench(InSettings)
+        {
+            MakeSteppedInputs(-20.0f, 20.0f, BlockSize);
+
+            Offsets.SetNumZeroed(Stride);
+            for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+            {
+                Kernels.Emplace(BaseSeed + static_cast<uint32>(Voice));
+                Offsets[Voice] = Stream.FRandRange(0.0f, 10.0f);
+            }
+
+            Batch.Init(NumVoices, BaseSeed);
+        }
+
+        void Reset()
+        {
+            for (FDustKernel& Kernel : Kernels)
+            {
+                Kernel.Reset();
+            }
+            Batch.Reset();
+        }
+
+        void RunScalar(int32 InBlock)
+        {
+            for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+            {
+                Kernels[Voice].ProcessBuffer(GetScalarInput(InBlock, Voice), Offsets[Voice], true, ScalarOutput.GetData() + Voice * BlockSize, BlockSize);
+            }
+        }
+
+        void RunBatch(int32 InBlock)
+        {
+            Batch.ProcessInterleaved(GetBatchInput(InBlock), Offsets.GetData(), true, BatchOutput.GetData(), BlockSize);
+        }
+
+    private:
+        TArray<FDustKernel> Kernels;
+        TArray<float> Offsets;
+        FDustVoiceBatch Batch;
+    };
+
+    // Edge flags are widened to floats in the output buffers so they can be compared like the others
+    class FEdgeBench : public FVoiceBench
+    {
+    public:
+        FEdgeBench(const FBenchSettings& InSettings)
+            : FVoiceBench(InSettings)
+        {
+            MakeSteppedInputs(-1.0f, 1.0f, 64);
+
+            Kernels.SetNum(NumVoices);
+            DebounceSamples.SetNum(NumVoices);
+            Batch.Init(NumVoices);
+
+            for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+            {
+                DebounceSamples[Voice] = FEdgeKernel::GetDebounceSamples(Stream.FRandRange(0.001f, 0.002f), BenchSampleRate);
+                Batch.SetDebounceSamples(Voice, DebounceSamples[Voice]);
+            }
+
+            RiseFlags.SetNumZeroed(Stride * BlockSize);
+            FallFlags.SetNumZeroed(Stride * BlockSize);
+        }
+
+        void Reset()
+        {
+            for (FEdgeKernel& Kernel : Kernels)
+            {
+                Kernel.Reset();
+            }
+            Batch.Reset();
+        }
+
+        void RunScalar(int32 InBlock)
+        {
+            for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+            {
+                float* Output = ScalarOutput.GetData() + Voice * BlockSize;
+                FMemory::Memzero(Output, BlockSize * sizeof(float));
+
+                Kernels[Voice].ProcessBuffer(GetScalarInput(InBlock, Voice), BlockSize, DebounceSamples[Voice],
+                    [Output](int32 Frame) { Output[Frame] = 1.0f; },
+                    [Output](int32 Frame) { Output[Frame] = -1.0f; });
+            }
+        }
+
+        void RunBatch(int32 InBlock)
+        {
+            Batch.ProcessInterleaved(GetBatchInput(InBlock), RiseFlags.GetData(), FallFlags.GetData(), BlockSize);
+
+            for (int32 i = 0; i < BatchOutput.Num(); ++i)
+            {
+                BatchOutput[i] = static_cast<float>(RiseFlags[i]) - static_cast<float>(FallFlags[i]);
+            }
+        }
+
+    private:
+        TArray<FEdgeKernel> Kernels;
+        TArray<int32> DebounceSamples;
+        TArray<uint8> RiseFlags;
+        TArray<uint8> FallFlags;
+        FEdgeVoiceBatch Batch;
+    };
+
+    // Flag-specialized kernels against the runtime-flag loops they replaced. Each voice is an independent
+    // instance over voice-major buffers; there is no batching here.
+    class FFlagBench
+    {
+    public:
+        FFlagBench(const FBenchSettings& InSettings)
+            : NumVoices(InSettings.NumVoices)
+            , BlockSize(InSettings.BlockSize)
+            , Stream(InSettings.NumVoices * 104729 + InSettings.BlockSize)
+        {
+            RuntimeOutput.SetNumZeroed(NumVoices * BlockSize * 2);
+            SpecializedOutput.SetNumZeroed(NumVoices * BlockSize * 2);
+        }
+
+        void CompareOutputs(float InTolerance, FBenchResult& OutResult) const
+        {
+            for (int32 i = 0; i < RuntimeOutput.Num(); ++i)
+            {
+                const float Error = FMath::Abs(RuntimeOutput[i] - SpecializedOutput[i]);
+
+                OutResult.MaxError = FMath::Max(OutResult.MaxError, Error);
+                OutResult.NumMismatches += (Error <= InTolerance) ? 0 : 1;
+            }
+        }
+
+    protected:
+        // Hides a flag from the optimizer so the runtime loop keeps its tests
+        static bool GetRuntimeFlag(bool bInFlag)
+        {
+            volatile bool bFlag = bInFlag;
+            return bFlag;
+        }
+
+        void MakeNoiseInputs(float InMin, float InMax)
+        {
+            Input.SetNumUninitialized(NumInputBlocks * NumVoices * BlockSize * 2);
+            for (float& Sample : Input)
+            {
+                Sample = Stream.FRandRange(InMin, InMax);
+            }
+        }
+
+        // Two channels per voice: left then right
+        const float* GetInput(int32 InBlock, int32 InVoice, int32 InChannel) const
+        {
+            return Input.GetData() + ((((InBlock % NumInputBlocks) * NumVoices + InVoice) * 2 + InChannel) * BlockSize);
+        }
+
+        float* GetOutput(TArray<float>& InOutput, int32 InVoice, int32 InChannel)
+        {
+            return InOutput.GetData() + (InVoice * 2 + InChannel) * BlockSize;
+        }
+
+        int32 NumVoices;
+        int32 BlockSize;
+        FRandomStream Stream;
+
+        TArray<float> Input;
+        TArray<float> RuntimeOutput;
+        TArray<float> SpecializedOutput;
+    };
+
+    // Stereo Inverter for one combination of Invert L, Invert R and Swap. The runtime loop tests the flags per sample.
+    template <bool bInvertLeft, bool bInvertRight, bool bSwap>
+    class FInverterFlagBench : public FFlagBench
+    {
+    public:
+        FInverterFlagBench(const FBenchSettings& InSettings)
+            : FFlagBench(InSettings)
+        {
+            MakeNoiseInputs(-1.0f, 1.0f);
+        }
+
+        void Reset()
+        {
+        }
+
+        void RunScalar(int32 InBlock)
+        {
+            for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+            {
+                Scalar::ProcessStereoInverter(GetInput(InBlock, Voice, 0), GetInput(InBlock, Voice, 1),
+                    GetOutput(RuntimeOutput, Voice, 0), GetOutput(RuntimeOutput, Voice, 1), BlockSize,
+                    GetRuntimeFlag(bInvertLeft), GetRuntimeFlag(bInvertRight), GetRuntimeFlag(bSwap));
+            }
+        }
+
+        void RunBatch(int32 InBlock)
+        {
+            for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+            {
+                ProcessStereoInverter(GetInput(InBlock, Voice, 0), GetInput(InBlock, Voice, 1),
+                    GetOutput(SpecializedOutput, Voice, 0), GetOutput(SpecializedOutput, Voice, 1), BlockSize, bInvertLeft, bInvertRight, bSwap);
+            }
+        }
+    };
+
+    // Dust (Audio) for one polarity. The runtime loop is the one the node used before it was specialized:
+    // every sample written and polarity tested per impulse.
+    template <bool bBiPolar>
+    class FDustFlagBench : public FFlagBench
+    {
+    public:
+        static constexpr uint32 BaseSeed = 12345U;
+
+        FDustFlagBench(const FBenchSettings& InSettings)
+            : FFlagBench(InSettings)
+        {
+            MakeNoiseInputs(-20.0f, 20.0f);
+
+            for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+            {
+                Kernels.Emplace(BaseSeed + static_cast<uint32>(Voice));
+            }
+            Seeds.SetNumZeroed(NumVoices);
+            Positive.SetNumZeroed(NumVoices);
+        }
+
+        void Reset()
+        {
+            for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+            {
+                Kernels[Voice].Reset();
+                Seeds[Voice] = BaseSeed + static_cast<uint32>(Voice);
+                Positive[Voice] = true;
+            }
+        }
+
+        void RunScalar(int32 InBlock)
+        {
+            const bool bRuntimeBiPolar = GetRuntimeFlag(bBiPolar);
+
+            for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+            {
+                const float* Density = GetInput(InBlock, Voice, 0);
+                float* Output = GetOutput(RuntimeOutput, Voice, 0);
+                uint32 Seed = Seeds[Voice];
+
+                for (int32 i = 0; i < BlockSize; ++i)
+                {
+                    const float Threshold = 1.0f - FMath::Abs(Density[i]) * FDustKernel::DensityScale;
+                    Seed = FDustRandom::Next(Seed);
+
+                    if (FDustRandom::ToFraction(Seed) > Threshold)
+                    {
+                        if (bRuntimeBiPolar)
+                        {
+                            Output[i] = Positive[Voice] ? 1.0f : -1.0f;
+                            Positive[Voice] = !Positive[Voice];
+                        }
+                        else
+                        {
+                            Output[i] = 1.0f;
+                        }
+                    }
+                    else
+                    {
+                        Output[i] = 0.0f;
+                    }
+                }
+
+                Seeds[Voice] = Seed;
+            }
+        }
+
+        void RunBatch(int32 InBlock)
+        {
+            for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+            {
+                Kernels[Voice].ProcessBuffer(GetInput(InBlock, Voice, 0), 0.0f, bBiPolar, GetOutput(SpecializedOutput, Voice, 0), BlockSize);
+            }
+        }
+
+    private:
+        TArray<FDustKernel> Kernels;
+        TArray<uint32> Seeds;
+        TArray<bool> Positive;
+    };
+
+    template <typename BenchType>
+    FBenchResult RunBench(const FBenchSettings& InSettings)
+    {
+        BenchType Bench(InSettings);
+        FBenchResult Result;
+
+        // Check the paths agree block by block before timing either
+        Bench.Reset();
+        for (int32 Block = 0; Block < NumInputBlocks; ++Block)
+        {
+            Bench.RunScalar(Block);
+            Bench.RunBatch(Block);
+            Bench.CompareOutputs(InSettings.Tolerance, Result);
+        }
+
+        Bench.Reset();
+        uint64 StartCycles = FPlatformTime::Cycles64();
+        for (int32 Block = 0; Block < InSettings.NumBlocks; ++Block)
+        {
+            Bench.RunScalar(Block);
+        }
+        Result.ScalarSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+        Bench.Reset();
+        StartCycles = FPlatformTime::Cycles64();
+        for (int32 Block = 0; Block < InSettings.NumBlocks; ++Block)
+        {
+            Bench.RunBatch(Block);
+        }
+        Result.BatchSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+        return Result;
+    }
+}
+
+UMetasoundBranchesBenchCommandlet::UMetasoundBranchesBenchCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UMetasoundBranchesBenchCommandlet::Main(const FString& Params)
+{
+    using namespace MetasoundBranches::Harness::BenchCommandletPrivate;
+
+    FBenchSettings Settings;
+    FString KernelName = TEXT("All");
+
+    FParse::Value(*Params, TEXT("Kernel="), KernelName);
+    FParse::Value(*Params, TEXT("Voices="), Settings.NumVoices);
+    FParse::Value(*Params, TEXT("BlockSize="), Settings.BlockSize);
+    FParse::Value(*Params, TEXT("Blocks="), Settings.NumBlocks);
+    FParse::Value(*Params, TEXT("Tolerance="), Settings.Tolerance);
+
+    Settings.NumVoices = FMath::Max(Settings.NumVoices, 1);
+    Settings.BlockSize = FMath::Max(Settings.BlockSize, 1);
+    Settings.NumBlocks = FMath::Max(Settings.NumBlocks, 1);
+
+    struct FBenchEntry
+    {
+        const TCHAR* Name;
+        FBenchResult (*Run)(const FBenchSettings&);
+    };
+
+    const FBenchEntry Entries[] =
+    {
+        { TEXT("Slew"), &RunBench<FSlewBench> },
+        { TEXT("BoolToAudio"), &RunBench<FBoolToAudioBench> },
+        { TEXT("Dust"), &RunBench<FDustBench> },
+        { TEXT("Edge"), &RunBench<FEdgeBench> },
+    };
+
+    // Flag specializations: the scalar column is the runtime-flag loop, the batch column the specialized kernel
+    const FBenchEntry FlagEntries[] =
+    {
+        { TEXT("Inverter-None"), &RunBench<FInverterFlagBench<false, false, false>> },
+        { TEXT("Inverter-L"), &RunBench<FInverterFlagBench<true, false, false>> },
+        { TEXT("Inverter-R"), &RunBench<FInverterFlagBench<false, true, false>> },
+        { TEXT("Inverter-LR"), &RunBench<FInverterFlagBench<true, true, false>> },
+        { TEXT("Inverter-S"), &RunBench<FInverterFlagBench<false, false, true>> },
+        { TEXT("Inverter-LS"), &RunBench<FInverterFlagBench<true, false, true>> },
+        { TEXT("Inverter-RS"), &RunBench<FInverterFlagBench<false, true, true>> },
+        { TEXT("Inverter-LRS"), &RunBench<FInverterFlagBench<true, true, true>> },
+        { TEXT("Dust-Uni"), &RunBench<FDustFlagBench<false>> },
+        { TEXT("Dust-Bi"), &RunBench<FDustFlagBench<true>> },
+    };
+
+    const bool bRunAll = KernelName.Equals(TEXT("All"), ESearchCase::IgnoreCase);
+    const bool bRunFlags = bRunAll || KernelName.Equals(TEXT("Flags"), ESearchCase::IgnoreCase);
+    const double VoiceSamples = static_cast<double>(Settings.NumVoices) * Settings.BlockSize * Settings.NumBlocks;
+
+    int32 NumRun = 0;
+    int32 NumFailed = 0;
+
+    UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("%d voices, %d frames per block, %d blocks"), Settings.NumVoices, Settings.BlockSize, Settings.NumBlocks);
+    auto RunEntries = [&](TArrayView<const FBenchEntry> InEntries, bool bInRunGroup, const TCHAR* InBaselineName, const TCHAR* InOptimizedName)
+    {
+        bool bPrintedHeader = false;
+
+        for (const FBenchEntry& Entry : InEntries)
+        {
+            if (!bInRunGroup && !KernelName.Equals(Entry.Name, ESearchCase::IgnoreCase))
+            {
+                continue;
+            }
+
+            if (!bPrintedHeader)
+            {
+                UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("%-14s %14s %14s %8s %12s %10s"), TEXT("Kernel"), InBaselineName, InOptimizedName, TEXT("Speedup"), TEXT("MaxError"), TEXT("Mismatch"));
+                bPrintedHeader = true;
+            }
+
+            const FBenchResult Result = Entry.Run(Settings);
+            const bool bFailed = Result.NumMismatches > 0;
+
+            ++NumRun;
+            NumFailed += bFailed ? 1 : 0;
+
+            UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("%-14s %14.3f %14.3f %7.2fx %12g %10lld%s"),
+                Entry.Name,
+                Result.ScalarSeconds * 1.0e9 / VoiceSamples,
+                Result.BatchSeconds * 1.0e9 / VoiceSamples,
+                Result.BatchSeconds > 0.0 ? Result.ScalarSeconds / Result.BatchSeconds : 0.0,
+                Result.MaxError, Result.NumMismatches, bFailed ? TEXT("  FAILED") : TEXT(""));
+        }
+    };
+
+    RunEntries(Entries, bRunAll, TEXT("Scalar ns/vs"), TEXT("Batch ns/vs"));
+    RunEntries(FlagEntries, bRunFlags, TEXT("Runtime ns/vs"), TEXT("Special ns/vs"));
+
+    if (NumRun == 0)
+    {
+        UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("Unknown kernel '%s', expected All, Flags, Slew, BoolToAudio, Dust, Edge or one of the flag cases"), *KernelName);
+        return 1;
+    }
+
+    return NumFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,27 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MetasoundBranchesBenchCommandlet.generated.h"
+
+// Compares N independent kernel instances against the voice-batched kernels in Public/DSP/VoiceBatchKernels.h.
+//
+// UnrealEditor-Cmd <Project> -run=MetasoundBranchesBench [-Kernel=All|Flags|Slew|BoolToAudio|Dust|Edge|<flag case>] [-Voices=64] [-BlockSize=256] [-Blocks=2000] [-Tolerance=1e-6]
+//
+// Both paths are first run over the same inputs and must agree within -Tolerance, then each is timed.
+// Reports nanoseconds per voice-sample for each path and the speedup. Returns non-zero if any kernel disagrees.
+//
+// The flag cases (Inverter-None ... Inverter-LRS, Dust-Uni, Dust-Bi) time the flag-specialized kernels
+// against loops that test their flags at runtime, one instance per voice.
+UCLASS()
+class UMetasoundBranchesBenchCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UMetasoundBranchesBenchCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,8 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranchesHarness/Private/MetasoundBranchesHarness.h"
+#include "Modules/ModuleManager.h"
+
+DEFINE_LOG_CATEGORY(LogMetasoundBranchesHarness);
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, MetasoundBranchesHarness);
@@ -0,0 +1,95 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranchesHarness/Private/MetasoundBranchesInstanceBenchCommandlet.h"
+#include "MetasoundBranchesHarness/Private/MetasoundBranchesHarness.h"
+#include "MetasoundBranchesHarness/Private/BranchesInstanceBench.h"
+#include "Misc/FileHelper.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(MetasoundBranchesInstanceBenchCommandlet)
+
+UMetasoundBranchesInstanceBenchCommandlet::UMetasoundBranchesInstanceBenchCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UMetasoundBranchesInstanceBenchCommandlet::Main(const FString& Params)
+{
+    using namespace MetasoundBranches::Harness;
+
+    FInstanceBenchSettings Settings;
+    FString VoiceCounts = TEXT("1,8,32,128,512,2048");
+    FString Order = TEXT("Voice");
+    FString ReportFilename;
+
+    FParse::Value(*Params, TEXT("Graph="), Settings.Graph);
+    FParse::Value(*Params, TEXT("Voices="), VoiceCounts);
+    FParse::Value(*Params, TEXT("BlockSize="), Settings.BlockSize);
+    FParse::Value(*Params, TEXT("SampleRate="), Settings.SampleRate);
+    FParse::Value(*Params, TEXT("InstanceBlocks="), Settings.InstanceBlocks);
+    FParse::Value(*Params, TEXT("Order="), Order);
+    FParse::Value(*Params, TEXT("Report="), ReportFilename);
+    Settings.bPerfCounters = FParse::Param(*Params, TEXT("Counters"));
+
+    Settings.BlockSize = FMath::Max(Settings.BlockSize, 1);
+    Settings.Order = Order.Equals(TEXT("Node"), ESearchCase::IgnoreCase) ? EInstanceOrder::Node : EInstanceOrder::Voice;
+
+    TArray<FString> VoiceCountTokens;
+    VoiceCounts.ParseIntoArray(VoiceCountTokens, TEXT(","));
+    for (const FString& Token : VoiceCountTokens)
+    {
+        Settings.VoiceCounts.Add(FMath::Max(FCString::Atoi(*Token), 1));
+    }
+
+    TArray<FInstanceBenchResult> Results;
+    FString Error;
+
+    if (Settings.VoiceCounts.IsEmpty() || !RunInstanceBench(Settings, Results, Error))
+    {
+        UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("%s"), Error.IsEmpty() ? TEXT("No voice counts given") : *Error);
+        UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("%s"), *GetInstanceBenchUsage());
+        return 1;
+    }
+
+    UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("Graph '%s', %d frames per block, %s order"),
+        *Settings.Graph, Settings.BlockSize, Settings.Order == EInstanceOrder::Node ? TEXT("node") : TEXT("voice"));
+    UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("%8s %10s %12s %8s %12s %12s %10s %9s%s"),
+        TEXT("Voices"), TEXT("Instances"), TEXT("Working KiB"), TEXT("Blocks"), TEXT("Mean us"), TEXT("Worst us"), TEXT("ns/inst-smp"), TEXT("Relative"),
+        Settings.bPerfCounters ? TEXT("      IPC  L1DMiss/smp  LLCMiss/smp") : TEXT(""));
+
+    FString Report = TEXT("Voices,Instances,WorkingSetBytes,Blocks,MeanBlockUs,MaxBlockUs,NsPerInstanceSample,Relative,IPC,L1DMissesPerSample,LLCMissesPerSample\n");
+
+    const double BaseNanoseconds = Results[0].NanosecondsPerInstanceSample;
+
+    for (const FInstanceBenchResult& Result : Results)
+    {
+        const double Relative = BaseNanoseconds > 0.0 ? Result.NanosecondsPerInstanceSample / BaseNanoseconds : 0.0;
+        const double InstanceSamples = static_cast<double>(Result.NumBlocks) * Result.NumInstances * Settings.BlockSize;
+        const double Ipc = Result.Counters.GetInstructionsPerCycle();
+        const double L1Misses = Result.Counters[EPerfCounter::L1DataMisses] / InstanceSamples;
+        const double LlcMisses = Result.Counters[EPerfCounter::LastLevelCacheMisses] / InstanceSamples;
+
+        const FString CounterColumns = Settings.bPerfCounters
+            ? FString::Printf(TEXT(" %8.2f %12.4f %12.4f"), Ipc, L1Misses, LlcMisses)
+            : FString();
+
+        UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("%8d %10d %12.1f %8d %12.2f %12.2f %10.3f %8.2fx%s"),
+            Result.NumVoices, Result.NumInstances, Result.WorkingSetBytes / 1024.0, Result.NumBlocks,
+            Result.MeanBlockMicroseconds, Result.MaxBlockMicroseconds, Result.NanosecondsPerInstanceSample, Relative, *CounterColumns);
+
+        Report += FString::Printf(TEXT("%d,%d,%lld,%d,%.3f,%.3f,%.4f,%.4f,%.4f,%.6f,%.6f\n"),
+            Result.NumVoices, Result.NumInstances, Result.WorkingSetBytes, Result.NumBlocks,
+            Result.MeanBlockMicroseconds, Result.MaxBlockMicroseconds, Result.NanosecondsPerInstanceSample, Relative,
+            Ipc, L1Misses, LlcMisses);
+    }
+
+    if (!ReportFilename.IsEmpty() && !FFileHelper::SaveStringToFile(Report, *ReportFilename))
+    {
+        UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("Could not write report to %s"), *ReportFilename);
+        return 1;
+    }
+
+    return 0;
+}
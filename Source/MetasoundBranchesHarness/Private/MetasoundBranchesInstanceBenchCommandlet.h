@@ -0,0 +1,25 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MetasoundBranchesInstanceBenchCommandlet.generated.h"
+
+// Times many voices of a small graph of Branches kernels, to see what happens once their state and buffers
+// no longer fit in cache.
+//
+// UnrealEditor-Cmd <Project> -run=MetasoundBranchesInstanceBench [-Graph=Dust+Slew+Width] [-Voices=1,8,32,128,512,2048] [-BlockSize=256] [-InstanceBlocks=200000] [-Order=Voice|Node] [-Counters] [-Report=<file.csv>]
+//
+// Reports, per voice count, the working set, the mean and worst time to run one block of every voice, and the
+// cost per instance-sample relative to the smallest count. -Counters adds IPC and cache misses (Linux only).
+UCLASS()
+class UMetasoundBranchesInstanceBenchCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UMetasoundBranchesInstanceBenchCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
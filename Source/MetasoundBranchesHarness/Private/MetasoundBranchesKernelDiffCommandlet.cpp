@@ -0,0 +1,49 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranchesHarness/Private/MetasoundBranchesKernelDiffCommandlet.h"
+#include "MetasoundBranchesHarness/Private/MetasoundBranchesHarness.h"
+#include "MetasoundBranchesHarness/Private/BranchesKernelDiff.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(MetasoundBranchesKernelDiffCommandlet)
+
+UMetasoundBranchesKernelDiffCommandlet::UMetasoundBranchesKernelDiffCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UMetasoundBranchesKernelDiffCommandlet::Main(const FString& Params)
+{
+    using namespace MetasoundBranches::Harness;
+
+    int32 Seed = 1;
+    int32 NumIterations = 2000;
+    int32 MaxUlp = 0;
+
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    FParse::Value(*Params, TEXT("Iterations="), NumIterations);
+    FParse::Value(*Params, TEXT("MaxUlp="), MaxUlp);
+
+    const TArray<FKernelDiffResult> Results = RunKernelDiff(Seed, NumIterations, static_cast<uint32>(FMath::Max(MaxUlp, 0)));
+
+    int32 NumFailedKernels = 0;
+
+    UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("%-16s %12s %10s %10s %8s  %s"), TEXT("Kernel"), TEXT("Samples"), TEXT("MaxUlp"), TEXT("OverUlp"), TEXT("NaN"), TEXT("Worst (scalar / vector)"));
+
+    for (const FKernelDiffResult& Result : Results)
+    {
+        const bool bFailed = Result.NumMismatches > 0 || Result.NumNaNMismatches > 0;
+        NumFailedKernels += bFailed ? 1 : 0;
+
+        UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("%-16s %12lld %10u %10lld %8lld  %g / %g%s"),
+            *Result.KernelName, Result.NumSamples, Result.MaxUlp, Result.NumMismatches, Result.NumNaNMismatches,
+            Result.WorstReference, Result.WorstVector, bFailed ? TEXT("  FAILED") : TEXT(""));
+    }
+
+    UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("Seed %d, %d iterations per kernel, %d of %d kernels failed"),
+        Seed, NumIterations, NumFailedKernels, Results.Num());
+
+    return NumFailedKernels == 0 ? 0 : 1;
+}
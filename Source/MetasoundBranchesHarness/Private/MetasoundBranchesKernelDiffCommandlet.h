@@ -0,0 +1,24 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MetasoundBranchesKernelDiffCommandlet.generated.h"
+
+// Checks every vectorized kernel against its scalar reference.
+//
+// UnrealEditor-Cmd <Project> -run=MetasoundBranchesKernelDiff [-Seed=1] [-Iterations=2000] [-MaxUlp=0]
+//
+// Reports the maximum ULP error per kernel and returns non-zero if any sample is further than -MaxUlp
+// from the reference, or NaN on only one side.
+UCLASS()
+class UMetasoundBranchesKernelDiffCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UMetasoundBranchesKernelDiffCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
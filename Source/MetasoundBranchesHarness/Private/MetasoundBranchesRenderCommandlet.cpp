@@ -0,0 +1,642 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranchesHarness/Private/MetasoundBranchesRenderCommandlet.h"
+#include "MetasoundBranchesHarness/Private/MetasoundBranchesHarness.h"
+#include "MetasoundBranchesHarness/Private/BranchesBatchRender.h"
+#include "MetasoundBranchesHarness/Private/BranchesRenderChain.h"
+#include "MetasoundBranchesHarness/Private/BranchesWaveFile.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(MetasoundBranchesRenderCommandlet)
+
+namespace MetasoundBranches::Harness::RenderCommandletPrivate
+{
+    struct FRenderSettings
+    {
+        FString InFilename;
+        FString OutFilename;
+        FString ChainSpec;
+        FString ReportFilename;
+        FString GoldenFilename;
+        TArray<int32> BlockSizes;
+        int32 SampleRate = 0;
+        float Tolerance = 1.0e-6f;
+        bool bPerfCounters = false;
+    };
+
+    // Per-channel buffers holding a whole render
+    using FRenderBuffers = TArray<TArray<float>>;
+
+    // Block sizes from "64,256,1024". False if any is missing or not positive.
+    bool ParseBlockSizes(const FString& InBlockSizes, TArray<int32>& OutBlockSizes)
+    {
+        TArray<FString> Tokens;
+        InBlockSizes.ParseIntoArray(Tokens, TEXT(","));
+        for (const FString& Token : Tokens)
+        {
+            OutBlockSizes.Add(FCString::Atoi(*Token));
+        }
+
+        return !OutBlockSizes.IsEmpty() && !OutBlockSizes.ContainsByPredicate([](int32 Size) { return Size <= 0; });
+    }
+
+    // The suite and its golden files live next to the harness source
+    FString GetDefaultSuiteFilename()
+    {
+        const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("MetasoundBranches"));
+        return Plugin.IsValid() ? FPaths::Combine(Plugin->GetBaseDir(), TEXT("Source/MetasoundBranchesHarness/Golden/Suite.txt")) : FString();
+    }
+
+    // Renders the whole input into memory, used when comparing renders against each other
+    bool RenderToBuffers(FWaveFileReader& InReader, const FRenderSettings& InSettings, int32 InBlockSize, FRenderBuffers& OutBuffers, FString& OutError)
+    {
+        const int32 NumChannels = InReader.GetNumChannels();
+
+        FRenderChain Chain;
+        if (!Chain.Init(InSettings.ChainSpec, NumChannels, static_cast<float>(InSettings.SampleRate), OutError))
+        {
+            return false;
+        }
+
+        OutBuffers.SetNum(NumChannels);
+        for (TArray<float>& Buffer : OutBuffers)
+        {
+            Buffer.SetNumZeroed(static_cast<int32>(InReader.GetNumFrames()));
+        }
+
+        InReader.Rewind();
+
+        TArray<float*> Channels;
+        Channels.SetNum(NumChannels);
+
+        for (int64 Frame = 0; Frame < InReader.GetNumFrames(); Frame += InBlockSize)
+        {
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                Channels[Channel] = OutBuffers[Channel].GetData() + Frame;
+            }
+
+            const int32 NumFrames = InReader.ReadFrames(Channels, InBlockSize);
+            Chain.Process(Channels, NumFrames);
+        }
+
+        return true;
+    }
+
+    // Largest absolute difference between two renders and the first frame where it exceeds the tolerance
+    float CompareBuffers(const FRenderBuffers& InExpected, const FRenderBuffers& InActual, float InTolerance, int64& OutFirstFailingFrame)
+    {
+        float MaxError = 0.0f;
+        OutFirstFailingFrame = INDEX_NONE;
+
+        for (int32 Channel = 0; Channel < InExpected.Num(); ++Channel)
+        {
+            const TArray<float>& Expected = InExpected[Channel];
+            const TArray<float>& Actual = InActual[Channel];
+
+            for (int32 Frame = 0; Frame < Expected.Num(); ++Frame)
+            {
+                const float Error = FMath::Abs(Expected[Frame] - Actual[Frame]);
+                MaxError = FMath::Max(MaxError, Error);
+
+                // Written so that NaN counts as a failure
+                if (!(Error <= InTolerance) && (OutFirstFailingFrame == INDEX_NONE || Frame < OutFirstFailingFrame))
+                {
+                    OutFirstFailingFrame = Frame;
+                }
+            }
+        }
+
+        return MaxError;
+    }
+
+    bool ReadGolden(const FString& InFilename, int32 InNumChannels, int64 InNumFrames, int32 InSampleRate, FRenderBuffers& OutBuffers, FString& OutError)
+    {
+        FWaveFileReader Reader;
+        if (!Reader.Open(InFilename, OutError))
+        {
+            return false;
+        }
+
+        // Goldens are written at the rate they were rendered at, so a mismatch means the wrong file or -SampleRate
+        if (Reader.GetSampleRate() != InSampleRate)
+        {
+            OutError = FString::Printf(TEXT("Golden file was rendered at %d Hz, expected %d"), Reader.GetSampleRate(), InSampleRate);
+            return false;
+        }
+
+        if (Reader.GetNumChannels() != InNumChannels || Reader.GetNumFrames() != InNumFrames)
+        {
+            OutError = FString::Printf(TEXT("Golden file has %d channels and %lld frames, expected %d and %lld"),
+                Reader.GetNumChannels(), Reader.GetNumFrames(), InNumChannels, InNumFrames);
+            return false;
+        }
+
+        OutBuffers.SetNum(InNumChannels);
+
+        TArray<float*> Channels;
+        for (TArray<float>& Buffer : OutBuffers)
+        {
+            Buffer.SetNumUninitialized(static_cast<int32>(InNumFrames));
+            Channels.Add(Buffer.GetData());
+        }
+
+        Reader.ReadFrames(Channels, static_cast<int32>(InNumFrames));
+        return true;
+    }
+
+    // Renders at every requested block size and checks each result against the first and, when given, a golden file.
+    // Writing -Out from a verified render is how golden files are made.
+    int32 Verify(FWaveFileReader& InReader, const FRenderSettings& InSettings)
+    {
+        FString Error;
+        int32 NumFailures = 0;
+
+        FRenderBuffers Reference;
+        if (!RenderToBuffers(InReader, InSettings, InSettings.BlockSizes[0], Reference, Error))
+        {
+            UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("Chain '%s': %s"), *InSettings.ChainSpec, *Error);
+            return 1;
+        }
+
+        for (int32 i = 1; i < InSettings.BlockSizes.Num(); ++i)
+        {
+            FRenderBuffers Render;
+            if (!RenderToBuffers(InReader, InSettings, InSettings.BlockSizes[i], Render, Error))
+            {
+                UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("Block size %d: %s"), InSettings.BlockSizes[i], *Error);
+                ++NumFailures;
+                continue;
+            }
+
+            int64 FailingFrame = INDEX_NONE;
+            const float MaxError = CompareBuffers(Reference, Render, InSettings.Tolerance, FailingFrame);
+
+            if (FailingFrame != INDEX_NONE)
+            {
+                UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("Block size %d differs from %d: max error %g, first at frame %lld"),
+                    InSettings.BlockSizes[i], InSettings.BlockSizes[0], MaxError, FailingFrame);
+                ++NumFailures;
+            }
+            else
+            {
+                UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("Block size %d matches %d (max error %g)"),
+                    InSettings.BlockSizes[i], InSettings.BlockSizes[0], MaxError);
+            }
+        }
+
+        if (!InSettings.GoldenFilename.IsEmpty())
+        {
+            FRenderBuffers Golden;
+            if (!ReadGolden(InSettings.GoldenFilename, InReader.GetNumChannels(), InReader.GetNumFrames(), InSettings.SampleRate, Golden, Error))
+            {
+                UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("%s: %s"), *InSettings.GoldenFilename, *Error);
+                return 1;
+            }
+
+            int64 FailingFrame = INDEX_NONE;
+            const float MaxError = CompareBuffers(Golden, Reference, InSettings.Tolerance, FailingFrame);
+
+            if (FailingFrame != INDEX_NONE)
+            {
+                UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("Render differs from %s: max error %g, first at frame %lld"),
+                    *InSettings.GoldenFilename, MaxError, FailingFrame);
+                ++NumFailures;
+            }
+            else
+            {
+                UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("Render matches %s (max error %g)"), *InSettings.GoldenFilename, MaxError);
+            }
+        }
+
+        if (!InSettings.OutFilename.IsEmpty())
+        {
+            FWaveFileWriter Writer;
+            if (!Writer.Open(InSettings.OutFilename, InReader.GetNumChannels(), InSettings.SampleRate, Error))
+            {
+                UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("%s"), *Error);
+                return 1;
+            }
+
+            TArray<const float*> Channels;
+            for (const TArray<float>& Buffer : Reference)
+            {
+                Channels.Add(Buffer.GetData());
+            }
+            if (!Writer.WriteFrames(Channels, static_cast<int32>(InReader.GetNumFrames())) || !Writer.Close())
+            {
+                UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("Failed writing %s"), *InSettings.OutFilename);
+                return 1;
+            }
+        }
+
+        UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("Verify '%s' at %d Hz: %s"), *InSettings.ChainSpec, InSettings.SampleRate,
+            NumFailures == 0 ? TEXT("passed") : TEXT("FAILED"));
+
+        return NumFailures == 0 ? 0 : 1;
+    }
+
+    // Runs every line of a suite file as its own -Verify against a golden file. Lines use the -Verify switches:
+    //   -In=<file.wav> -Chain=<spec> -Golden=<file.wav> [-BlockSizes=64,256,1024] [-SampleRate=<hz>] [-Tolerance=1e-6]
+    // Relative paths are taken from the suite file's directory. Blank lines and lines starting with '#' are skipped.
+    // Returns non-zero if any line fails, including lines whose input, chain or golden can't be loaded.
+    int32 VerifySuite(const FString& InSuiteFilename)
+    {
+        TArray<FString> Lines;
+        if (!FFileHelper::LoadFileToStringArray(Lines, *InSuiteFilename))
+        {
+            UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("Could not read suite file %s"), *InSuiteFilename);
+            return 1;
+        }
+
+        const FString SuiteDirectory = FPaths::GetPath(InSuiteFilename);
+        auto ResolvePath = [&SuiteDirectory](const FString& InPath)
+        {
+            return FPaths::IsRelative(InPath) ? FPaths::Combine(SuiteDirectory, InPath) : InPath;
+        };
+
+        int32 NumChecks = 0;
+        int32 NumFailed = 0;
+
+        for (int32 LineIndex = 0; LineIndex < Lines.Num(); ++LineIndex)
+        {
+            const FString Line = Lines[LineIndex].TrimStartAndEnd();
+            if (Line.IsEmpty() || Line.StartsWith(TEXT("#")))
+            {
+                continue;
+            }
+
+            ++NumChecks;
+
+            FRenderSettings Settings;
+            FString BlockSizes = TEXT("256");
+
+            FParse::Value(*Line, TEXT("In="), Settings.InFilename);
+            FParse::Value(*Line, TEXT("Chain="), Settings.ChainSpec);
+            FParse::Value(*Line, TEXT("Golden="), Settings.GoldenFilename);
+            FParse::Value(*Line, TEXT("BlockSizes="), BlockSizes, false);
+            FParse::Value(*Line, TEXT("SampleRate="), Settings.SampleRate);
+            FParse::Value(*Line, TEXT("Tolerance="), Settings.Tolerance);
+
+            if (Settings.InFilename.IsEmpty() || Settings.ChainSpec.IsEmpty() || Settings.GoldenFilename.IsEmpty() || !ParseBlockSizes(BlockSizes, Settings.BlockSizes))
+            {
+                UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("Line %d needs -In, -Chain, -Golden and positive -BlockSizes"), LineIndex + 1);
+                ++NumFailed;
+                continue;
+            }
+
+            Settings.InFilename = ResolvePath(Settings.InFilename);
+            Settings.GoldenFilename = ResolvePath(Settings.GoldenFilename);
+
+            FString Error;
+            FWaveFileReader Reader;
+            if (!Reader.Open(Settings.InFilename, Error))
+            {
+                UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("Line %d, %s: %s"), LineIndex + 1, *Settings.InFilename, *Error);
+                ++NumFailed;
+                continue;
+            }
+
+            if (Settings.SampleRate <= 0)
+            {
+                Settings.SampleRate = Reader.GetSampleRate();
+            }
+
+            UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("Line %d:"), LineIndex + 1);
+            NumFailed += Verify(Reader, Settings) != 0 ? 1 : 0;
+        }
+
+        UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("Suite %s: %d of %d checks passed"), *InSuiteFilename, NumChecks - NumFailed, NumChecks);
+
+        // An empty suite checks nothing, which shouldn't pass for a run that expected it to
+        return (NumChecks > 0 && NumFailed == 0) ? 0 : 1;
+    }
+
+    // Logs IPC and misses per sample for each stage, and appends the same as a second table to the CSV report
+    void ReportPerfCounters(const FRenderChain& InChain, const FPerfCounters& InCounters, int64 InNumSamples, FString& OutReport)
+    {
+        const double NumSamples = static_cast<double>(FMath::Max<int64>(InNumSamples, 1));
+
+        // Counters the hardware doesn't expose are shown as n/a rather than as zero misses
+        auto FormatPerSample = [&InCounters, NumSamples](const FPerfCounterValues& InValues, EPerfCounter InCounter) -> FString
+        {
+            return InCounters.IsAvailable(InCounter) ? FString::Printf(TEXT("%.4f"), InValues[InCounter] / NumSamples) : FString(TEXT("n/a"));
+        };
+
+        const bool bHasIpc = InCounters.IsAvailable(EPerfCounter::Cycles) && InCounters.IsAvailable(EPerfCounter::Instructions);
+
+        UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("  %-10s %8s %12s %12s %12s %12s"),
+            TEXT("Stage"), TEXT("IPC"), TEXT("Cycles/smp"), TEXT("BrMiss/smp"), TEXT("L1DMiss/smp"), TEXT("LLCMiss/smp"));
+
+        OutReport += TEXT("\nStage,Cycles,Instructions,IPC,CyclesPerSample,BranchMissesPerSample,L1DMissesPerSample,LLCMissesPerSample\n");
+
+        for (int32 i = 0; i < InChain.Num(); ++i)
+        {
+            const FPerfCounterValues& Values = InChain.GetProcessorCounters(i);
+            const FString Ipc = bHasIpc ? FString::Printf(TEXT("%.2f"), Values.GetInstructionsPerCycle()) : FString(TEXT("n/a"));
+            const FString CyclesPerSample = FormatPerSample(Values, EPerfCounter::Cycles);
+            const FString BranchMisses = FormatPerSample(Values, EPerfCounter::BranchMisses);
+            const FString L1Misses = FormatPerSample(Values, EPerfCounter::L1DataMisses);
+            const FString LlcMisses = FormatPerSample(Values, EPerfCounter::LastLevelCacheMisses);
+
+            UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("  %-10s %8s %12s %12s %12s %12s"),
+                InChain.GetProcessorName(i), *Ipc, *CyclesPerSample, *BranchMisses, *L1Misses, *LlcMisses);
+
+            OutReport += FString::Printf(TEXT("%s,%llu,%llu,%s,%s,%s,%s,%s\n"), InChain.GetProcessorName(i),
+                Values[EPerfCounter::Cycles], Values[EPerfCounter::Instructions],
+                *Ipc, *CyclesPerSample, *BranchMisses, *L1Misses, *LlcMisses);
+        }
+    }
+
+    int32 Render(FWaveFileReader& InReader, const FRenderSettings& InSettings)
+    {
+        const int32 NumChannels = InReader.GetNumChannels();
+        const int32 SampleRate = InSettings.SampleRate;
+        const int32 BlockSize = InSettings.BlockSizes[0];
+
+        FString Error;
+
+        FPerfCounters PerfCounters;
+        if (InSettings.bPerfCounters && !PerfCounters.Open(Error))
+        {
+            UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("Counters: %s"), *Error);
+            return 1;
+        }
+
+        FRenderChain Chain;
+        if (!Chain.Init(InSettings.ChainSpec, NumChannels, static_cast<float>(SampleRate), Error))
+        {
+            UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("Chain '%s': %s"), *InSettings.ChainSpec, *Error);
+            return 1;
+        }
+
+        if (PerfCounters.IsOpen())
+        {
+            Chain.SetPerfCounters(&PerfCounters);
+        }
+
+        FWaveFileWriter Writer;
+        if (!Writer.Open(InSettings.OutFilename, NumChannels, SampleRate, Error))
+        {
+            UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("%s"), *Error);
+            return 1;
+        }
+
+        // One block per channel, reused for the whole render
+        TArray<float> BlockStorage;
+        BlockStorage.SetNumZeroed(NumChannels * BlockSize);
+
+        TArray<float*> Channels;
+        for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+        {
+            Channels.Add(BlockStorage.GetData() + Channel * BlockSize);
+        }
+
+        uint64 ChainCycles = 0;
+        int64 FramesRendered = 0;
+        const double StartTime = FPlatformTime::Seconds();
+
+        while (true)
+        {
+            const int32 NumFrames = InReader.ReadFrames(Channels, BlockSize);
+            if (NumFrames <= 0)
+            {
+                break;
+            }
+
+            const uint64 StartCycles = FPlatformTime::Cycles64();
+            Chain.Process(Channels, NumFrames);
+            ChainCycles += FPlatformTime::Cycles64() - StartCycles;
+
+            if (!Writer.WriteFrames(TArrayView<const float* const>(Channels.GetData(), NumChannels), NumFrames))
+            {
+                UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("Failed writing %s"), *InSettings.OutFilename);
+                return 1;
+            }
+
+            FramesRendered += NumFrames;
+        }
+
+        if (!Writer.Close())
+        {
+            UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("Failed closing %s"), *InSettings.OutFilename);
+            return 1;
+        }
+
+        const double WallSeconds = FPlatformTime::Seconds() - StartTime;
+        const double ChainSeconds = FPlatformTime::ToSeconds64(ChainCycles);
+        const double AudioSeconds = static_cast<double>(FramesRendered) / SampleRate;
+
+        // Realtime factor: seconds of audio produced per second of processing
+        const double RealtimeFactor = (ChainSeconds > 0.0) ? AudioSeconds / ChainSeconds : 0.0;
+
+        UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("Rendered %lld frames (%d ch, %d Hz, %.2f s) in blocks of %d, input %s"),
+            FramesRendered, NumChannels, SampleRate, AudioSeconds, BlockSize, InReader.IsMapped() ? TEXT("mapped") : TEXT("loaded"));
+        UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("Chain %.3f ms, wall %.3f ms, realtime factor %.1fx"),
+            ChainSeconds * 1000.0, WallSeconds * 1000.0, RealtimeFactor);
+
+        FString Report = TEXT("Stage,TotalMs,NsPerFrame,Share\n");
+
+        for (int32 i = 0; i < Chain.Num(); ++i)
+        {
+            const double StageSeconds = Chain.GetProcessorSeconds(i);
+            const double NsPerFrame = FramesRendered > 0 ? StageSeconds * 1.0e9 / FramesRendered : 0.0;
+            const double Share = ChainSeconds > 0.0 ? StageSeconds / ChainSeconds : 0.0;
+
+            UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("  %-10s %9.3f ms %8.2f ns/frame %5.1f%%"),
+                Chain.GetProcessorName(i), StageSeconds * 1000.0, NsPerFrame, Share * 100.0);
+
+            Report += FString::Printf(TEXT("%s,%.4f,%.3f,%.4f\n"), Chain.GetProcessorName(i), StageSeconds * 1000.0, NsPerFrame, Share);
+        }
+
+        if (PerfCounters.IsOpen())
+        {
+            ReportPerfCounters(Chain, PerfCounters, FramesRendered * NumChannels, Report);
+        }
+
+        if (!InSettings.ReportFilename.IsEmpty() && !FFileHelper::SaveStringToFile(Report, *InSettings.ReportFilename))
+        {
+            UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("Could not write report to %s"), *InSettings.ReportFilename);
+            return 1;
+        }
+
+        return 0;
+    }
+
+    // Value at the given fraction of a sorted array, nearest rank
+    double GetPercentile(const TArray<double>& InSorted, double InFraction)
+    {
+        if (InSorted.IsEmpty())
+        {
+            return 0.0;
+        }
+
+        const int32 Rank = FMath::CeilToInt(InFraction * InSorted.Num());
+        return InSorted[FMath::Clamp(Rank - 1, 0, InSorted.Num() - 1)];
+    }
+
+    // Renders every job in a job file across worker threads, then reports throughput and per-job latency
+    int32 RenderBatch(const FString& InJobFilename, int32 InNumWorkers, const FString& InReportFilename)
+    {
+        FString Error;
+
+        TArray<FBatchRenderJob> Jobs;
+        if (!ParseBatchJobFile(InJobFilename, Jobs, Error))
+        {
+            UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("%s: %s"), *InJobFilename, *Error);
+            return 1;
+        }
+
+        const FBatchRenderSummary Summary = RunBatchRender(Jobs, InNumWorkers);
+
+        int32 NumFailed = 0;
+        int64 TotalFrames = 0;
+        double TotalAudioSeconds = 0.0;
+        TArray<double> Latencies;
+
+        FString Report = TEXT("Line,In,Out,Worker,Channels,SampleRate,Frames,StartMs,RenderMs,RealtimeFactor,Status\n");
+
+        for (int32 JobIndex = 0; JobIndex < Jobs.Num(); ++JobIndex)
+        {
+            const FBatchRenderJob& Job = Jobs[JobIndex];
+            const FBatchRenderJobResult& Result = Summary.Jobs[JobIndex];
+            const double AudioSeconds = Result.SampleRate > 0 ? static_cast<double>(Result.NumFrames) / Result.SampleRate : 0.0;
+
+            if (Result.bSucceeded)
+            {
+                TotalFrames += Result.NumFrames;
+                TotalAudioSeconds += AudioSeconds;
+                Latencies.Add(Result.RenderSeconds);
+            }
+            else
+            {
+                ++NumFailed;
+                UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("Line %d (%s): %s"), Job.LineNumber, *Job.InFilename, *Result.Error);
+            }
+
+            Report += FString::Printf(TEXT("%d,%s,%s,%d,%d,%d,%lld,%.3f,%.3f,%.2f,%s\n"),
+                Job.LineNumber, *Job.InFilename, *Job.OutFilename, Result.WorkerIndex, Result.NumChannels, Result.SampleRate, Result.NumFrames,
+                Result.StartSeconds * 1000.0, Result.RenderSeconds * 1000.0, Result.RenderSeconds > 0.0 ? AudioSeconds / Result.RenderSeconds : 0.0,
+                Result.bSucceeded ? TEXT("ok") : *Result.Error.Replace(TEXT(","), TEXT(";")));
+        }
+
+        Latencies.Sort();
+
+        double TotalBusySeconds = 0.0;
+        for (const FBatchRenderWorkerStats& Worker : Summary.Workers)
+        {
+            TotalBusySeconds += Worker.BusySeconds;
+        }
+
+        // Share of the available worker time spent rendering; close to 100% means the pool is scaling linearly
+        const double Efficiency = Summary.WallSeconds > 0.0 ? TotalBusySeconds / (Summary.WallSeconds * Summary.Workers.Num()) : 0.0;
+
+        UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("Rendered %d of %d jobs on %d workers in %.3f s"),
+            Jobs.Num() - NumFailed, Jobs.Num(), Summary.Workers.Num(), Summary.WallSeconds);
+        UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("Throughput %.1f s of audio per s (%.2f Mframes/s), worker efficiency %.1f%%"),
+            Summary.WallSeconds > 0.0 ? TotalAudioSeconds / Summary.WallSeconds : 0.0,
+            Summary.WallSeconds > 0.0 ? TotalFrames / Summary.WallSeconds * 1.0e-6 : 0.0,
+            Efficiency * 100.0);
+        UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("Job latency p50 %.3f ms, p95 %.3f ms, max %.3f ms"),
+            GetPercentile(Latencies, 0.5) * 1000.0, GetPercentile(Latencies, 0.95) * 1000.0, GetPercentile(Latencies, 1.0) * 1000.0);
+
+        for (int32 WorkerIndex = 0; WorkerIndex < Summary.Workers.Num(); ++WorkerIndex)
+        {
+            const FBatchRenderWorkerStats& Worker = Summary.Workers[WorkerIndex];
+            UE_LOG(LogMetasoundBranchesHarness, Verbose, TEXT("  Worker %3d: %4d jobs (%d stolen), busy %.3f s"),
+                WorkerIndex, Worker.NumJobs, Worker.NumStolen, Worker.BusySeconds);
+        }
+
+        if (!InReportFilename.IsEmpty() && !FFileHelper::SaveStringToFile(Report, *InReportFilename))
+        {
+            UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("Could not write report to %s"), *InReportFilename);
+            return 1;
+        }
+
+        return NumFailed == 0 ? 0 : 1;
+    }
+}
+
+UMetasoundBranchesRenderCommandlet::UMetasoundBranchesRenderCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UMetasoundBranchesRenderCommandlet::Main(const FString& Params)
+{
+    using namespace MetasoundBranches::Harness;
+    using namespace MetasoundBranches::Harness::RenderCommandletPrivate;
+
+    FRenderSettings Settings;
+    FString BlockSizes = TEXT("256");
+
+    FParse::Value(*Params, TEXT("In="), Settings.InFilename);
+    FParse::Value(*Params, TEXT("Out="), Settings.OutFilename);
+    FParse::Value(*Params, TEXT("Chain="), Settings.ChainSpec);
+    FParse::Value(*Params, TEXT("Report="), Settings.ReportFilename);
+    FParse::Value(*Params, TEXT("Golden="), Settings.GoldenFilename);
+    FParse::Value(*Params, TEXT("SampleRate="), Settings.SampleRate);
+    FParse::Value(*Params, TEXT("Tolerance="), Settings.Tolerance);
+    Settings.bPerfCounters = FParse::Param(*Params, TEXT("Counters"));
+
+    // -BlockSize=<n> for renders, -BlockSizes=<a,b,...> for verification
+    if (!FParse::Value(*Params, TEXT("BlockSizes="), BlockSizes, false))
+    {
+        FParse::Value(*Params, TEXT("BlockSize="), BlockSizes);
+    }
+
+    FString JobFilename;
+    if (FParse::Value(*Params, TEXT("Batch="), JobFilename))
+    {
+        int32 NumWorkers = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+        FParse::Value(*Params, TEXT("Threads="), NumWorkers);
+
+        return RenderBatch(JobFilename, NumWorkers, Settings.ReportFilename);
+    }
+
+    // -Suite on its own runs the goldens committed with the plugin
+    FString SuiteFilename;
+    if (FParse::Value(*Params, TEXT("Suite="), SuiteFilename))
+    {
+        return VerifySuite(SuiteFilename);
+    }
+    if (FParse::Param(*Params, TEXT("Suite")))
+    {
+        return VerifySuite(GetDefaultSuiteFilename());
+    }
+
+    const bool bVerify = FParse::Param(*Params, TEXT("Verify"));
+    const bool bHasValidBlockSizes = ParseBlockSizes(BlockSizes, Settings.BlockSizes);
+
+    if (Settings.InFilename.IsEmpty() || Settings.ChainSpec.IsEmpty() || !bHasValidBlockSizes || (!bVerify && Settings.OutFilename.IsEmpty()))
+    {
+        UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("Usage: -run=MetasoundBranchesRender -In=<file.wav> -Out=<file.wav> -Chain=<spec> [-BlockSize=256] [-SampleRate=<hz>] [-Report=<file.csv>] [-Counters]"));
+        UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("       -run=MetasoundBranchesRender -Verify -In=<file.wav> -Chain=<spec> [-BlockSizes=64,256,1024] [-Golden=<file.wav>] [-Tolerance=1e-6] [-Out=<file.wav>]"));
+        UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("       -run=MetasoundBranchesRender -Batch=<jobs.txt> [-Threads=<n>] [-Report=<file.csv>]"));
+        UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("       -run=MetasoundBranchesRender -Suite[=<suite.txt>]"));
+        UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("%s"), *FRenderChain::GetUsage());
+        return 1;
+    }
+
+    FString Error;
+
+    FWaveFileReader Reader;
+    if (!Reader.Open(Settings.InFilename, Error))
+    {
+        UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("%s: %s"), *Settings.InFilename, *Error);
+        return 1;
+    }
+
+    // Overriding the file's rate lets one input exercise the rate-dependent kernels at several rates
+    if (Settings.SampleRate <= 0)
+    {
+        Settings.SampleRate = Reader.GetSampleRate();
+    }
+
+    return bVerify ? Verify(Reader, Settings) : Render(Reader, Settings);
+}
@@ -0,0 +1,35 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MetasoundBranchesRenderCommandlet.generated.h"
+
+// Renders a WAV file through a chain of Branches DSP kernels without running a MetaSound graph.
+//
+// UnrealEditor-Cmd <Project> -run=MetasoundBranchesRender -In=<file.wav> -Out=<file.wav> -Chain=<spec> [-BlockSize=256] [-Report=<file.csv>] [-Counters]
+//
+// The input is streamed block by block and the result is written as 32-bit float.
+// Reports the realtime factor of the whole chain and the time spent in each stage.
+// With -Counters (Linux only) it also reads hardware counters around each stage and reports IPC and cache and
+// branch misses per sample.
+//
+// With -Verify the chain is rendered at every size in -BlockSizes and the results must match each other,
+// and the -Golden file if given, within -Tolerance. Returns non-zero on any mismatch.
+//
+// With -Suite every line of a suite file is run as a -Verify against its golden file. On its own it runs the goldens
+// committed in Source/MetasoundBranchesHarness/Golden; -Suite=<suite.txt> runs another.
+//
+// With -Batch=<jobs.txt> every line of the job file is rendered as its own job across -Threads workers
+// (default: all hardware threads), reporting aggregate throughput and per-job latency.
+UCLASS()
+class UMetasoundBranchesRenderCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UMetasoundBranchesRenderCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,103 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranchesHarness/Private/MetasoundBranchesSpawnBenchCommandlet.h"
+#include "MetasoundBranchesHarness/Private/MetasoundBranchesHarness.h"
+#include "MetasoundBranchesHarness/Private/BranchesSpawnBench.h"
+#include "Misc/FileHelper.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(MetasoundBranchesSpawnBenchCommandlet)
+
+UMetasoundBranchesSpawnBenchCommandlet::UMetasoundBranchesSpawnBenchCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UMetasoundBranchesSpawnBenchCommandlet::Main(const FString& Params)
+{
+    using namespace MetasoundBranches::Harness;
+
+    FSpawnBenchSettings Settings;
+    FString OutputFilename;
+    FString BaselineFilename;
+
+    FParse::Value(*Params, TEXT("Node="), Settings.NodeFilter);
+    FParse::Value(*Params, TEXT("Iterations="), Settings.NumIterations);
+    FParse::Value(*Params, TEXT("SampleRate="), Settings.SampleRate);
+    FParse::Value(*Params, TEXT("BlockSize="), Settings.BlockSize);
+    FParse::Value(*Params, TEXT("Output="), OutputFilename);
+    FParse::Value(*Params, TEXT("Baseline="), BaselineFilename);
+
+    Settings.NumIterations = FMath::Max(Settings.NumIterations, 1);
+    Settings.BlockSize = FMath::Max(Settings.BlockSize, 1);
+
+    TArray<FSpawnBenchResult> Baseline;
+    if (!BaselineFilename.IsEmpty())
+    {
+        FString Error;
+        if (!LoadSpawnBenchCsv(BaselineFilename, Baseline, Error))
+        {
+            UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("%s: %s"), *BaselineFilename, *Error);
+            return 1;
+        }
+    }
+
+    const TArray<FSpawnBenchResult> Results = RunSpawnBench(Settings);
+
+    if (Results.IsEmpty())
+    {
+        UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("No nodes match '%s'"), *Settings.NodeFilter);
+        return 1;
+    }
+
+    int32 NumRegressions = 0;
+
+    UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("%-28s %10s %10s %8s %8s %10s  %s"),
+        TEXT("Node"), TEXT("Create us"), TEXT("Destroy us"), TEXT("Allocs"), TEXT("Max"), TEXT("Bytes"), TEXT("Baseline"));
+
+    for (const FSpawnBenchResult& Result : Results)
+    {
+        FString Comparison;
+
+        const FSpawnBenchResult* Previous = Baseline.FindByPredicate([&Result](const FSpawnBenchResult& InPrevious)
+        {
+            return InPrevious.NodeName == Result.NodeName;
+        });
+
+        if (Previous != nullptr)
+        {
+            const bool bRegressed = Result.NumAllocations > Previous->NumAllocations;
+            NumRegressions += bRegressed ? 1 : 0;
+
+            Comparison = FString::Printf(TEXT("%+.3f us, %+d allocs, %+lld bytes%s"),
+                Result.CreateMicroseconds - Previous->CreateMicroseconds,
+                Result.NumAllocations - Previous->NumAllocations,
+                Result.AllocatedBytes - Previous->AllocatedBytes,
+                bRegressed ? TEXT("  REGRESSED") : TEXT(""));
+        }
+        else if (!Baseline.IsEmpty())
+        {
+            Comparison = TEXT("new");
+        }
+
+        UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("%-28s %10.3f %10.3f %8d %8d %10lld  %s"),
+            *Result.NodeName, Result.CreateMicroseconds, Result.DestroyMicroseconds,
+            Result.NumAllocations, Result.MaxAllocations, Result.AllocatedBytes, *Comparison);
+    }
+
+    if (!OutputFilename.IsEmpty())
+    {
+        if (!FFileHelper::SaveStringToFile(SpawnBenchResultsToCsv(Results), *OutputFilename))
+        {
+            UE_LOG(LogMetasoundBranchesHarness, Error, TEXT("Could not write %s"), *OutputFilename);
+            return 1;
+        }
+    }
+
+    UE_LOG(LogMetasoundBranchesHarness, Display, TEXT("%d nodes, %d iterations each at %g Hz / %d frames, %d allocation regressions"),
+        Results.Num(), Settings.NumIterations, Settings.SampleRate, Settings.BlockSize, NumRegressions);
+
+    return NumRegressions == 0 ? 0 : 1;
+}
@@ -0,0 +1,25 @@
+// Copyright 2025 Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MetasoundBranchesSpawnBenchCommandlet.generated.h"
+
+// Measures what it costs to spawn each node's operator: build time, destroy time and heap allocations.
+//
+// UnrealEditor-Cmd <Project> -run=MetasoundBranchesSpawnBench [-Node=<class name filter>] [-Iterations=1000] [-SampleRate=48000] [-BlockSize=256] [-Output=<csv>] [-Baseline=<csv>]
+//
+// -Output writes the results as CSV, to be kept alongside a release. -Baseline reads an earlier CSV and reports
+// the change per node; returns non-zero if any node allocates more than it did. Timings are reported but never
+// fail the run, as they vary too much between machines.
+UCLASS()
+class UMetasoundBranchesSpawnBenchCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UMetasoundBranchesSpawnBenchCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
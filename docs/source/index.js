@@ -40,6 +40,9 @@ data.forEach(node => {
     `;
   }).join('\n');
 
+  // Nodes without a diagram yet leave the image out
+  const imageTag = image ? `\n    <img src="./svg/${image}" alt="${name}">` : '';
+
   const htmlContent = `<!DOCTYPE html>
 <html lang="en">
 <head>
@@ -60,8 +63,7 @@ data.forEach(node => {
     <h1><a href="https://matthewscharles.github.io/metasound-branches/">MetaSound Branches</a></h1>
     <h2>${name}</h2>
     <p><strong>Category:</strong> ${category}</p>
-    <p>${description}</p>
-    <img src="./svg/${image}" alt="${name}">
+    <p>${description}</p>${imageTag}
     <h3>Inputs</h3>
     <table>
       <thead>